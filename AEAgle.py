@@ -3,15 +3,22 @@
 from __future__ import annotations
 
 import argparse
+import binascii
 import csv
+import fnmatch
+import functools
+import hashlib
 import logging
 import os
+import select
 import shutil
 import subprocess
 import sys
+import threading
 import time
+from concurrent.futures import ThreadPoolExecutor, as_completed
 from pathlib import Path
-from typing import Dict, Final, List, Sequence, Tuple, Literal
+from typing import Callable, Dict, Final, List, Optional, Protocol, Sequence, Tuple, Literal
 
 import serial
 
@@ -19,6 +26,20 @@ PROJECT_ROOT: Final[Path] = Path(__file__).resolve().parent
 TESTS_DIR: Final[Path] = PROJECT_ROOT / "tests"
 APPS_DIR: Final[Path] = PROJECT_ROOT / "apps"
 RESULTS_DIR: Final[Path] = PROJECT_ROOT / "results" / "reports"
+HOST_DIR: Final[Path] = PROJECT_ROOT / "host"
+OS_DIR: Final[Path] = PROJECT_ROOT / "operating-systems"
+# Per-job copies of the demo apps, so parallel builds never share a main.c
+# or a build directory.
+WORK_DIR: Final[Path] = PROJECT_ROOT / "_work"
+# Built images keyed by a hash of everything that went into them.
+CACHE_DIR: Final[Path] = PROJECT_ROOT / ".aeagle-cache"
+# Written by --trace for the Replay tests; include/aeagle_replay_default.h
+# is used when it is absent.
+REPLAY_TRACE_HEADER: Final[Path] = PROJECT_ROOT / "include" / "aeagle_replay_trace.h"
+REPLAY_TRACE_BIN: Final[Path] = WORK_DIR / "replay.aetr"
+# Written by --sizes for the RandomSizes tests' "hist" phase; the histogram
+# in include/aeagle_dist.h is used when it is absent.
+DIST_HIST_HEADER: Final[Path] = PROJECT_ROOT / "include" / "aeagle_dist_hist.h"
 
 _OS_MAP: Final[Dict[str, str]] = {
     "zephyr": "demo-zephyr",
@@ -32,7 +53,85 @@ _OS_MAP: Final[Dict[str, str]] = {
     "riot-tlsf": "demo-riot",
     "riot-mema": "demo-riot",
 }
-_ROOT_MAIN_DEMOS: Final[set[str]] = {"demo-freertos", "demo-contiki"}
+_ROOT_MAIN_DEMOS: Final[set[str]] = {
+    "demo-freertos", "demo-freertos-mps2", "demo-freertos-posix", "demo-contiki",
+}
+# heap_3 and heap_5 need no board setup on the host engine and the POSIX port.
+_FREERTOS_ALL_HEAPS: Final[List[str]] = [f"freertosv{n}" for n in range(1, 6)]
+
+# QEMU runs the suites whose OS has an mps2-an385 port. Each demo's qemu.sh
+# builds the image that qemu-system-arm loads from the path below.
+_QEMU_OS_MAP: Final[Dict[str, str]] = {
+    "zephyr": "demo-zephyr",
+    "newlib": "demo-newlib",
+    "newlib-nano": "demo-newlib-nano",
+    "freertosv1": "demo-freertos-mps2",
+    "freertosv2": "demo-freertos-mps2",
+    "freertosv4": "demo-freertos-mps2",
+    "freertosv5": "demo-freertos-mps2",
+}
+_QEMU_ELF: Final[Dict[str, str]] = {
+    "demo-zephyr": "build-qemu/zephyr/zephyr.elf",
+    "demo-newlib": "build-qemu/zephyr/zephyr.elf",
+    "demo-newlib-nano": "build-qemu/zephyr/zephyr.elf",
+    "demo-freertos-mps2": "build/demo-freertos.elf",
+}
+QEMU_BINARY: Final[str] = "qemu-system-arm"
+QEMU_MACHINE: Final[str] = "mps2-an385"
+QEMU_CPU: Final[str] = "cortex-m3"
+
+# Suites whose OS can be built as a Linux process. Each demo's
+# build_native.sh produces the executable at the path below, which is run
+# directly with its stdout as the console.
+_NATIVE_OS_MAP: Final[Dict[str, str]] = {
+    "zephyr": "demo-zephyr",
+    **{suite: "demo-freertos-posix" for suite in _FREERTOS_ALL_HEAPS},
+    "contiki-memb": "demo-contiki",
+    "contiki-heapmem": "demo-contiki",
+    "riot-tlsf": "demo-riot",
+    "riot-mema": "demo-riot",
+}
+_NATIVE_EXE: Final[Dict[str, str]] = {
+    "demo-zephyr": "build-native/zephyr/zephyr.exe",
+    "demo-freertos-posix": "build/demo-freertos",
+    "demo-contiki": "build/native/main.native",
+    "demo-riot": "bin/native/demo-riot.elf",
+}
+# Zephyr cannot link newlib into native_sim (it has no host newlib), so
+# these suites run newlib's malloc through the host engine instead.
+_NATIVE_VIA_HOST: Final[set[str]] = {"newlib", "newlib-nano"}
+
+# Image each flash.sh leaves behind on a board build. Given AEAGLE_IMAGE,
+# flash.sh skips the build and flashes that file instead.
+_BOARD_IMAGE: Final[Dict[str, str]] = {
+    "demo-zephyr": "build/zephyr/zephyr.elf",
+    "demo-newlib": "build/zephyr/zephyr.elf",
+    "demo-newlib-nano": "build/zephyr/zephyr.elf",
+    "demo-freertos": "build/demo-freertos.elf",
+    "demo-contiki": "build/simplelink/launchpad/cc1352r1/main.simplelink",
+    "demo-riot": "bin/cc1352-launchpad/demo-riot.elf",
+}
+# Build inputs shared by several demos, hashed along with the demo itself.
+_CACHE_SHARED_DIRS: Final[List[Path]] = [APPS_DIR / "ti-shim", PROJECT_ROOT / "include"]
+# Compilers whose version is part of the cache key when installed.
+_CACHE_TOOLCHAINS: Final[List[str]] = [
+    "/home/lmg/ti/gcc-arm-none-eabi_9_3_1/bin/arm-none-eabi-gcc",
+    "arm-none-eabi-gcc",
+    "cc",
+]
+_BUILD_OUTPUT_DIRS: Final[Tuple[str, ...]] = ("build", "build-*", "bin")
+
+# Multi-test images (--multi-image): every test of a suite is linked into one
+# image behind a dispatcher from apps/dispatch/ that reads the test name
+# from the console once it has printed "# <suite> ready".
+DISPATCH_DIR: Final[Path] = APPS_DIR / "dispatch"
+_MULTI_LABEL: Final[str] = "all"
+# Zephyr's native_sim takes the name on its command line instead.
+_NATIVE_TEST_ARGS: Final[Dict[str, List[str]]] = {"demo-zephyr": ["--testargs"]}
+# Restarts the board between tests of a multi-test image.
+BOARD_RESET_CMD: Final[List[str]] = [
+    "openocd", "-f", "board/ti_cc13x2_launchpad.cfg", "-c", "init; reset run; shutdown",
+]
 
 _RETRIES: Final[Dict[str, int]] = {}
 _RETRY_DELAY: Final[float] = 1.0
@@ -44,13 +143,84 @@ SERIAL_TIMEOUT: Final[float] = 30.0
 EXPECTED_PREFIXES: Final[List[str]] = [
     "META,",
     "SNAP,",
+    "HEAP,",
+    "CONT,",
+    "WAKE,",
     "TIME,",
+    "HIST,",
     "FAULT,",
     "LEAK,",
     "NOLEAK,",
 ]
 
-CaptureStatus = Literal["SUCCESS", "NO_START", "NO_END", "SERIAL_ERROR"]
+BACKENDS: Final[List[str]] = ["board", "host", "qemu", "native"]
+
+CaptureStatus = Literal["SUCCESS", "NO_START", "NO_END", "SERIAL_ERROR", "TRACE_DROPPED"]
+JobStatus = Literal["SUCCESS", "NO_START", "NO_END", "SERIAL_ERROR", "TRACE_DROPPED", "FLASH_FAIL"]
+
+
+class _Console(Protocol):
+    def readline(self) -> bytes: ...
+    def write(self, data: bytes) -> int: ...
+
+
+class _ProcessConsole:
+    """Line source over a child process' stdout.
+
+    Mirrors the serial.Serial readline() contract used by the capture loop:
+    it returns b"" when nothing arrived within `timeout`. `exhausted` turns
+    true once the process has exited and every buffered line was consumed.
+    """
+
+    def __init__(self, argv: Sequence[str], cwd: Optional[Path] = None, timeout: float = 0.1) -> None:
+        self._proc = subprocess.Popen(
+            list(argv), cwd=cwd, stdin=subprocess.PIPE,
+            stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+        )
+        self._timeout = timeout
+        self._buf = b""
+        self._eof = False
+
+    @property
+    def exhausted(self) -> bool:
+        return self._eof and not self._buf
+
+    def readline(self) -> bytes:
+        assert self._proc.stdout is not None
+        while b"\n" not in self._buf and not self._eof:
+            ready, _, _ = select.select([self._proc.stdout], [], [], self._timeout)
+            if not ready:
+                return b""
+            chunk = os.read(self._proc.stdout.fileno(), 4096)
+            if not chunk:
+                self._eof = True
+                break
+            self._buf += chunk
+        line, sep, rest = self._buf.partition(b"\n")
+        self._buf = rest
+        return line + sep
+
+    def write(self, data: bytes) -> int:
+        assert self._proc.stdin is not None
+        try:
+            self._proc.stdin.write(data)
+            self._proc.stdin.flush()
+        except BrokenPipeError:
+            return 0
+        return len(data)
+
+    def close(self) -> None:
+        if self._proc.poll() is None:
+            self._proc.terminate()
+            try:
+                self._proc.wait(timeout=1.0)
+            except subprocess.TimeoutExpired:
+                self._proc.kill()
+                self._proc.wait()
+        for stream in (self._proc.stdin, self._proc.stdout):
+            if stream:
+                stream.close()
+
 
 class _ColourFmt(logging.Formatter):
     C = {
@@ -76,8 +246,20 @@ def _setup_logging(verbose: bool) -> None:
 def _all_test_names(tests_dir: Path) -> List[str]:
     return sorted(p.stem for p in tests_dir.glob("*.c"))
 
-def _resolve_paths(os_name: str, test_name: str) -> Tuple[Path, Path, Path]:
-    if os_name not in _OS_MAP:
+def _suite_test_sources(os_name: str) -> List[Path]:
+    tests_path_name = "freertos" if os_name.startswith("freertosv") else os_name
+    return sorted((TESTS_DIR / tests_path_name).glob("*.c"))
+
+def _dest_main(demo_dir: Path) -> Path:
+    return (
+        demo_dir / "main.c"
+        if demo_dir.name in _ROOT_MAIN_DEMOS
+        else demo_dir / "src" / "main.c"
+    )
+
+def _resolve_paths(os_name: str, test_name: str, demo_name: Optional[str] = None,
+                   apps_dir: Path = APPS_DIR) -> Tuple[Path, Path, Path]:
+    if demo_name is None and os_name not in _OS_MAP:
         raise KeyError(
             f"Unknown suite '{os_name}'. Supported: {', '.join(sorted(_OS_MAP))}"
         )
@@ -86,35 +268,42 @@ def _resolve_paths(os_name: str, test_name: str) -> Tuple[Path, Path, Path]:
 
     if not src_test.is_file():
         raise FileNotFoundError(f"Test not found: {src_test.relative_to(PROJECT_ROOT)}")
-    demo_dir = APPS_DIR / _OS_MAP[os_name]
+    demo_dir = apps_dir / (demo_name or _OS_MAP[os_name])
     if not demo_dir.is_dir():
         raise FileNotFoundError(f"Demo dir missing: {demo_dir}")
-    dest_main = (
-        demo_dir / "main.c"
-        if demo_dir.name in _ROOT_MAIN_DEMOS
-        else demo_dir / "src" / "main.c"
-    )
+    dest_main = _dest_main(demo_dir)
     dest_main.parent.mkdir(parents=True, exist_ok=True)
     return src_test, demo_dir, dest_main
 
-def _run_flash(flash_sh: Path, cwd: Path, os_name: str) -> int:
+def _run_flash(flash_sh: Path, cwd: Path, os_name: str,
+               extra_env: Optional[Dict[str, str]] = None) -> int:
     flash_sh.chmod(0o755)
     env = os.environ.copy()
+    env.update(extra_env or {})
+    # Demo builds may run from a staged copy under WORK_DIR, where their
+    # relative ../../operating-systems paths no longer resolve.
+    env.setdefault("AEAGLE_ROOT", str(PROJECT_ROOT))
+    env.setdefault("RIOTBASE", str(OS_DIR / "RIOT"))
+    env.setdefault("CONTIKI", str(OS_DIR / "contiki-ng"))
+    env["AEAGLE_SUITE"] = os_name
+    env["AEAGLE_DEFINES"] = " ".join(_build_defines)
     if os_name.startswith("freertosv"):
         env["HEAP_IMPL"] = os_name[-1]
     return subprocess.run([str(flash_sh)], cwd=cwd, env=env, capture_output=True).returncode
 
-def flash_pair(os_name: str, test_name: str) -> int:
+def flash_pair(os_name: str, test_name: str, script: str = "flash.sh",
+               demo_name: Optional[str] = None, apps_dir: Path = APPS_DIR,
+               extra_env: Optional[Dict[str, str]] = None) -> int:
     log = logging.getLogger("runner.flash")
     try:
-        src_test, demo_dir, dest_main = _resolve_paths(os_name, test_name)
+        src_test, demo_dir, dest_main = _resolve_paths(os_name, test_name, demo_name, apps_dir)
     except (KeyError, FileNotFoundError) as e:
         log.error(f"Path resolution error for {os_name}/{test_name}: {e}")
         return 1
         
-    flash_sh = demo_dir / "flash.sh"
+    flash_sh = demo_dir / script
     if not flash_sh.is_file():
-        log.error(f"'flash.sh' missing in {demo_dir}")
+        log.error(f"'{script}' missing in {demo_dir}")
         return 1
 
     backup = dest_main.with_suffix(".aea_backup") if dest_main.exists() else None
@@ -127,11 +316,11 @@ def flash_pair(os_name: str, test_name: str) -> int:
         for n in range(1, attempts + 1):
             log.info(f"📄  {os_name:12} ← {test_name}  (try {n}/{attempts})")
             shutil.copy2(src_test, dest_main)
-            rc = _run_flash(flash_sh, demo_dir, os_name)
+            rc = _run_flash(flash_sh, demo_dir, os_name, extra_env)
             if rc == 0:
-                log.info("    ✅ flash succeeded")
+                log.info(f"    ✅ {flash_sh.stem} succeeded")
                 break
-            log.warning(f"    ⚠️  flash failed (code {rc})")
+            log.warning(f"    ⚠️  {flash_sh.stem} failed (code {rc})")
             if n < attempts:
                 log.debug(f"    retrying in {_RETRY_DELAY}s …")
                 time.sleep(_RETRY_DELAY)
@@ -142,91 +331,646 @@ def flash_pair(os_name: str, test_name: str) -> int:
             dest_main.unlink(missing_ok=True)
     return rc
 
-def _capture_and_write_csv(os_name: str, test_name: str, ser: serial.Serial) -> CaptureStatus:
+def _stage_workspace(backend: str, os_name: str, test_name: str, demo_name: str) -> Path:
+    """Copies one demo app into a private apps/ tree for a single job.
+
+    Returns the staged apps/ directory, to be passed as `apps_dir`. Build
+    outputs of the source tree are left behind.
+    """
+    apps_dir = WORK_DIR / backend / f"{os_name}-{test_name}" / "apps"
+    if apps_dir.exists():
+        shutil.rmtree(apps_dir)
+    shutil.copytree(
+        APPS_DIR / demo_name, apps_dir / demo_name,
+        ignore=shutil.ignore_patterns(*_BUILD_OUTPUT_DIRS, "*.aea_backup"),
+    )
+    return apps_dir
+
+_cache_enabled = True
+# -D options: preprocessor switches for the shared headers, passed to every
+# build as AEAGLE_DEFINES (e.g. AEAGLE_TRACE_HIST).
+_build_defines: List[str] = []
+
+@functools.lru_cache(maxsize=None)
+def _toolchain_fingerprint() -> bytes:
+    """Compiler versions and OS tree revisions; computed once per run."""
+    parts: List[str] = []
+    for cc in _CACHE_TOOLCHAINS:
+        if shutil.which(cc):
+            res = subprocess.run([cc, "--version"], capture_output=True, text=True)
+            parts.append(f"{cc}={res.stdout.splitlines()[0] if res.stdout else res.returncode}")
+    parts.append(f"ZEPHYR_SDK_INSTALL_DIR={os.environ.get('ZEPHYR_SDK_INSTALL_DIR', '')}")
+    if OS_DIR.is_dir():
+        for tree in sorted(p for p in OS_DIR.iterdir() if p.is_dir()):
+            res = subprocess.run(["git", "-C", str(tree), "describe", "--always", "--dirty"],
+                                 capture_output=True, text=True)
+            parts.append(f"{tree.name}={res.stdout.strip()}")
+    return "\n".join(parts).encode()
+
+def _hash_tree(h: "hashlib._Hash", root: Path, skip: Sequence[Path] = ()) -> None:
+    for dirpath, dirnames, filenames in os.walk(root):
+        if Path(dirpath) == root:
+            dirnames[:] = [d for d in dirnames
+                           if not any(fnmatch.fnmatch(d, pat) for pat in _BUILD_OUTPUT_DIRS)]
+        dirnames.sort()
+        for name in sorted(filenames):
+            path = Path(dirpath) / name
+            if path in skip or path.suffix == ".aea_backup":
+                continue
+            h.update(str(path.relative_to(root)).encode() + b"\0")
+            h.update(path.read_bytes())
+
+def _cache_key(backend: str, os_name: str, demo_name: str, script: str,
+               sources: Sequence[Path]) -> str:
+    """Hashes the suite, test sources, demo sources and configs, shared shims
+    and toolchain, i.e. everything a build script reads."""
+    demo_dir = APPS_DIR / demo_name
+    h = hashlib.sha256()
+    h.update(f"{backend}\0{os_name}\0{script}\0".encode())
+    h.update(" ".join(_build_defines).encode() + b"\0")
+    for src in sources:
+        h.update(src.name.encode() + b"\0")
+        h.update(src.read_bytes())
+    _hash_tree(h, demo_dir, skip=[_dest_main(demo_dir)])
+    for shared in _CACHE_SHARED_DIRS:
+        if shared.is_dir():
+            _hash_tree(h, shared)
+    h.update(_toolchain_fingerprint())
+    return h.hexdigest()
+
+def _cache_lookup(key: str, artifact: str) -> Optional[Path]:
+    if not _cache_enabled:
+        return None
+    cached = CACHE_DIR / key / Path(artifact).name
+    return cached if cached.is_file() else None
+
+def _cache_store(key: str, image: Path) -> Path:
+    entry = CACHE_DIR / key
+    if not _cache_enabled and (entry / image.name).is_file():
+        # --no-cache rebuilt it: the fresh image replaces the stored one, so
+        # the caller runs what it just built. os.replace is atomic, and a
+        # job still holding the old file keeps reading it.
+        tmp = entry / f".{image.name}.{threading.get_ident()}"
+        shutil.copy2(image, tmp)
+        os.replace(tmp, entry / image.name)
+    elif not (entry / image.name).is_file():
+        tmp = CACHE_DIR / f".{key}.{threading.get_ident()}"
+        shutil.rmtree(tmp, ignore_errors=True)
+        tmp.mkdir(parents=True)
+        shutil.copy2(image, tmp / image.name)
+        try:
+            tmp.rename(entry)
+        except OSError:
+            # Another worker stored the same image first.
+            shutil.rmtree(tmp, ignore_errors=True)
+    return entry / image.name
+
+def _results_dir(backend: str) -> Path:
+    # Board numbers stay where the notebook expects them; other backends get
+    # a sibling tree so host/emulator timings never overwrite device data.
+    return RESULTS_DIR if backend == "board" else RESULTS_DIR.parent / f"reports-{backend}"
+
+def _cobs_decode(data: bytes) -> Optional[bytes]:
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+def _varint(data: bytes, i: int) -> Tuple[int, int]:
+    """Reads one LEB128 varint at data[i]; returns it and the next index."""
+    value = shift = 0
+    while True:
+        b = data[i]
+        value |= (b & 0x7F) << shift
+        shift += 7
+        i += 1
+        if not b & 0x80:
+            return value, i
+
+
+# Allocation traces for the Replay tests (include/aeagle_replay.h).
+_REPLAY_MAGIC: Final[bytes] = b"AETR"
+_REPLAY_VERSION: Final[int] = 1
+_REPLAY_OPS: Final[Dict[str, int]] = {"malloc": 1, "free": 2}
+# Slots the device tests keep by default (AEAGLE_REPLAY_MAX_OBJECTS).
+REPLAY_MAX_OBJECTS: Final[int] = 128
+
+ReplayRecord = Tuple[int, int, int, int]  # op, size, id, dt
+
+
+def _uvarint(value: int) -> bytes:
+    out = bytearray()
+    while True:
+        b = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(b | 0x80)
+        else:
+            out.append(b)
+            return bytes(out)
+
+
+def replay_encode(records: Sequence[ReplayRecord]) -> bytes:
+    objects = 1 + max((rec[2] for rec in records), default=-1)
+    out = bytearray(_REPLAY_MAGIC + _uvarint(_REPLAY_VERSION) + _uvarint(objects))
+    for op, size, obj, dt in records:
+        out.append(op)
+        if op == _REPLAY_OPS["malloc"]:
+            out += _uvarint(size)
+        out += _uvarint(obj) + _uvarint(dt)
+    out.append(0)
+    return bytes(out)
+
+
+def replay_decode(data: bytes) -> List[ReplayRecord]:
+    """Parses a binary trace; raises ValueError if it is malformed."""
+    if data[:4] != _REPLAY_MAGIC:
+        raise ValueError("not an AETR trace")
+    try:
+        version, i = _varint(data, 4)
+        if version != _REPLAY_VERSION:
+            raise ValueError(f"trace version {version}, expected {_REPLAY_VERSION}")
+        objects, i = _varint(data, i)
+        records: List[ReplayRecord] = []
+        while data[i] != 0:
+            op, size = data[i], 0
+            i += 1
+            if op not in _REPLAY_OPS.values():
+                raise ValueError(f"bad op {op} in record {len(records)}")
+            if op == _REPLAY_OPS["malloc"]:
+                size, i = _varint(data, i)
+            obj, i = _varint(data, i)
+            dt, i = _varint(data, i)
+            if obj >= objects:
+                raise ValueError(f"record {len(records)}: id {obj} >= {objects} objects")
+            records.append((op, size, obj, dt))
+    except IndexError:
+        raise ValueError("trace truncated") from None
+    return records
+
+
+def _replay_parse_text(text: str) -> List[ReplayRecord]:
+    """One record per line: op,size,id,dt with op malloc or free; free's size
+    is ignored. Blank lines and # comments are skipped."""
+    records: List[ReplayRecord] = []
+    for n, line in enumerate(text.splitlines(), 1):
+        line = line.split("#", 1)[0].strip()
+        if not line:
+            continue
+        fields = [f.strip() for f in line.split(",")]
+        if len(fields) != 4 or fields[0] not in _REPLAY_OPS:
+            raise ValueError(f"line {n}: expected op,size,id,dt with op malloc or free")
+        try:
+            size, obj, dt = (int(f or "0") for f in fields[1:])
+        except ValueError:
+            raise ValueError(f"line {n}: size, id and dt must be integers") from None
+        if min(size, obj, dt) < 0 or max(size, dt) >= 1 << 32:
+            raise ValueError(f"line {n}: values out of range")
+        records.append((_REPLAY_OPS[fields[0]], size, obj, dt))
+    return records
+
+
+def _replay_check(records: Sequence[ReplayRecord]) -> None:
+    """Rejects a malloc into a live slot and a free of an empty one."""
+    live: set[int] = set()
+    for n, (op, _, obj, _) in enumerate(records):
+        if op == _REPLAY_OPS["malloc"]:
+            if obj in live:
+                raise ValueError(f"record {n}: malloc into live object {obj}")
+            live.add(obj)
+        else:
+            if obj not in live:
+                raise ValueError(f"record {n}: free of object {obj}, which is not live")
+            live.discard(obj)
+
+
+def load_replay_trace(path: Path) -> bytes:
+    """Reads a binary (.aetr) or text trace and returns it checked and
+    encoded."""
+    data = path.read_bytes()
+    if data[:4] == _REPLAY_MAGIC:
+        records = replay_decode(data)
+    else:
+        records = _replay_parse_text(data.decode("utf-8"))
+    if not records:
+        raise ValueError("trace has no records")
+    _replay_check(records)
+    encoded = replay_encode(records)
+    objects = 1 + max(rec[2] for rec in records)
+    if objects > REPLAY_MAX_OBJECTS:
+        logging.getLogger("runner").warning(
+            f"Trace uses {objects} object slots; build with -D AEAGLE_REPLAY_MAX_OBJECTS={objects}")
+    return encoded
+
+
+def replay_header(data: bytes, comment: str) -> str:
+    """The trace as the C array the Replay tests include."""
+    lines = [f"/* {comment} */", "", "#include <stdint.h>", "",
+             f"static const uint8_t aeagle_replay_trace[{len(data)}] = {{"]
+    for i in range(0, len(data), 12):
+        lines.append("    " + " ".join(f"0x{b:02x}," for b in data[i:i + 12]))
+    lines.append("};")
+    return "\n".join(lines) + "\n"
+
+
+def _install_replay_trace(path: Optional[Path]) -> None:
+    """Makes `path` the trace of every Replay build of this run, or removes
+    one a previous --trace run left behind."""
+    log = logging.getLogger("runner")
+    if path is None:
+        if REPLAY_TRACE_HEADER.is_file() and REPLAY_TRACE_HEADER.read_text().startswith("/* Generated"):
+            REPLAY_TRACE_HEADER.unlink()
+            log.info("Replay: using the default trace again")
+        REPLAY_TRACE_BIN.unlink(missing_ok=True)
+        return
+    data = load_replay_trace(path)
+    WORK_DIR.mkdir(exist_ok=True)
+    REPLAY_TRACE_BIN.write_bytes(data)
+    REPLAY_TRACE_HEADER.write_text(replay_header(
+        data, f"Generated by AEAgle.py --trace from {path.name}; do not commit."))
+    log.info(f"Replay: {len(replay_decode(data))} records from {path} ({len(data)} bytes)")
+
+
+def load_size_histogram(path: Path) -> List[Tuple[int, int]]:
+    """One bin per line: size,weight. Blank lines and # comments are
+    skipped; weights are relative."""
+    bins: List[Tuple[int, int]] = []
+    for n, line in enumerate(path.read_text().splitlines(), 1):
+        line = line.split("#", 1)[0].strip()
+        if not line:
+            continue
+        fields = [f.strip() for f in line.split(",")]
+        try:
+            size, weight = (int(f) for f in fields)
+        except ValueError:
+            raise ValueError(f"line {n}: expected size,weight as integers") from None
+        if size <= 0 or weight < 0:
+            raise ValueError(f"line {n}: size must be positive and weight not negative")
+        if weight:
+            bins.append((size, weight))
+    if not bins:
+        raise ValueError("histogram has no bins with weight")
+    if sum(w for _, w in bins) >= 1 << 32:
+        raise ValueError("weights add up to 2^32 or more")
+    return bins
+
+
+def _install_size_histogram(path: Optional[Path]) -> None:
+    """Makes `path` the "hist" distribution of every RandomSizes build of
+    this run, or removes one a previous --sizes run left behind."""
+    log = logging.getLogger("runner")
+    if path is None:
+        if DIST_HIST_HEADER.is_file() and DIST_HIST_HEADER.read_text().startswith("/* Generated"):
+            DIST_HIST_HEADER.unlink()
+            log.info("RandomSizes: using the default histogram again")
+        return
+    bins = load_size_histogram(path)
+    lines = [f"/* Generated by AEAgle.py --sizes from {path.name}; do not commit. */", "",
+             "static const struct aeagle_dist_bin aeagle_dist_hist[] = {",
+             *[f"    {{{size}, {weight}}}," for size, weight in bins], "};"]
+    DIST_HIST_HEADER.write_text("\n".join(lines) + "\n")
+    log.info(f"RandomSizes: {len(bins)} size bins from {path}")
+
+
+class _WireDecoder:
+    """Splits console bytes into text lines and binary trace frames.
+
+    Builds with -D AEAGLE_WIRE send TIME and SNAP records as COBS frames
+    between 0x00 bytes (include/aeagle_wire.h); everything else stays text.
+    Frames come back as the CSV rows the text form would have produced.
+    `lost` counts frames missing from the sequence numbers; `corrupt` counts
+    the ones that failed COBS or the CRC, which are missing too.
+    """
+
+    HELLO, STR, BATCH = range(3)
+    TAG_PHASE, TAG_OP, TAG_RESULT, TAG_SIZE, TAG_SNAP = 0x01, 0x02, 0x04, 0x08, 0x80
+    # AEAGLE_WIRE_BATCH of include/aeagle_wire.h, until HELLO gives the
+    # build's own.
+    WIRE_BATCH: Final[int] = 112
+
+    @staticmethod
+    def max_frame(batch: int) -> int:
+        """Longest frame a build with `batch` record bytes can send, between
+        its delimiters. A longer one means the reader lost a delimiter and is
+        treating text as a frame."""
+        # seq, type and CRC around the records, one COBS code byte per 254,
+        # and a \r for every byte a console may turn into \r\n.
+        body = batch + 5
+        return 2 * (body + 1 + body // 254)
+
+    def __init__(self) -> None:
+        self._text = bytearray()
+        self._frame: Optional[bytearray] = None
+        self._strings: Dict[int, str] = {}
+        self._next_seq = 0
+        self._ts_mask = (1 << 64) - 1
+        self._max_frame = self.max_frame(self.WIRE_BATCH)
+        self.frames = self.lost = self.corrupt = 0
+
+    def feed(self, data: bytes) -> List[Tuple[str, List[str]]]:
+        """Returns ("line", [text]) and ("row", fields) items in arrival order."""
+        out: List[Tuple[str, List[str]]] = []
+        i = 0
+        while i < len(data):
+            z = data.find(b"\0", i)
+            end = len(data) if z < 0 else z
+            if self._frame is None:
+                self._text += data[i:end]
+                self._lines(out)
+                if z >= 0:
+                    self._frame = bytearray()
+            else:
+                self._frame += data[i:end]
+                if len(self._frame) > self._max_frame:
+                    self._resync(out)
+                elif z >= 0:
+                    self._close_frame(out)
+            i = end + 1
+        return out
+
+    def _lines(self, out: List[Tuple[str, List[str]]]) -> None:
+        while True:
+            nl = self._text.find(b"\n")
+            if nl < 0:
+                return
+            line = self._text[:nl].decode("utf-8", errors="ignore").rstrip("\r")
+            del self._text[:nl + 1]
+            out.append(("line", [line]))
+
+    def _resync(self, out: List[Tuple[str, List[str]]]) -> None:
+        assert self._frame is not None
+        self._text += self._frame
+        self._frame = None
+        self._lines(out)
+
+    def _close_frame(self, out: List[Tuple[str, List[str]]]) -> None:
+        assert self._frame is not None
+        frame = bytes(self._frame)
+        if not frame:
+            # Two delimiters in a row: the second one opens the next frame.
+            return
+        self._frame = None
+        body = self._check(frame)
+        if body is None and b"\r\n" in frame:
+            # Consoles that turn \n into \r\n (Zephyr's) also do it inside frames.
+            body = self._check(frame.replace(b"\r\n", b"\n"))
+        if body is None:
+            if b"\n" in frame:
+                # Text read as a frame after a lost delimiter; this 0x00
+                # opened the next frame.
+                self._text += frame
+                self._lines(out)
+                self._frame = bytearray()
+            self.corrupt += 1
+            return
+        out.extend(("row", row) for row in self._records(body))
+
+    @staticmethod
+    def _check(frame: bytes) -> Optional[bytes]:
+        body = _cobs_decode(frame)
+        if body is None or len(body) < 5:
+            return None
+        if binascii.crc_hqx(body[:-2], 0xFFFF) != int.from_bytes(body[-2:], "little"):
+            return None
+        return body[:-2]
+
+    def _records(self, body: bytes) -> List[List[str]]:
+        seq = int.from_bytes(body[:2], "little")
+        self.lost += (seq - self._next_seq) & 0xFFFF
+        self._next_seq = (seq + 1) & 0xFFFF
+        self.frames += 1
+        kind, payload = body[2], body[3:]
+        try:
+            if kind == self.HELLO:
+                _, i = _varint(payload, 0)
+                bits, i = _varint(payload, i)
+                self._ts_mask = (1 << bits) - 1
+                if i < len(payload):
+                    # Version 3 and up: the build's AEAGLE_WIRE_BATCH.
+                    batch, _ = _varint(payload, i)
+                    self._max_frame = self.max_frame(batch)
+            elif kind == self.STR:
+                sid, i = _varint(payload, 0)
+                self._strings[sid] = payload[i:].decode("utf-8", errors="replace")
+            elif kind == self.BATCH:
+                return self._batch(payload)
+        except IndexError:
+            # CRC-clean but truncated: a build newer than this decoder.
+            self.corrupt += 1
+        return []
+
+    def _batch(self, payload: bytes) -> List[List[str]]:
+        """Rebuilds the TIME/SNAP rows of one BATCH frame. The first TIME
+        record is relative to zero, i.e. absolute; the rest are deltas."""
+        rows: List[List[str]] = []
+        phase = op = result = size = t_in = alloc_cnt = free_cnt = 0
+        mask32 = (1 << 32) - 1
+
+        def name(sid: int) -> str:
+            # A lost STR frame leaves its id unnamed.
+            return self._strings.get(sid, f"?{sid}")
+
+        def delta(i: int) -> Tuple[int, int]:
+            z, i = _varint(payload, i)
+            return (z >> 1) ^ -(z & 1), i
+
+        i = 0
+        while i < len(payload):
+            tag = payload[i]
+            i += 1
+            if tag & self.TAG_SNAP:
+                v = []
+                for _ in range(4):
+                    x, i = _varint(payload, i)
+                    v.append(x)
+                rows.append(["SNAP", name(v[0]), str(v[1]), str(v[2]), str(v[3])])
+                continue
+            if tag & self.TAG_PHASE:
+                phase, i = _varint(payload, i)
+            if tag & self.TAG_OP:
+                op, i = _varint(payload, i)
+            if tag & self.TAG_RESULT:
+                result, i = _varint(payload, i)
+            if tag & self.TAG_SIZE:
+                size, i = _varint(payload, i)
+            d, i = delta(i)
+            t_in = (t_in + d) & self._ts_mask
+            d, i = delta(i)
+            alloc_cnt = (alloc_cnt + d) & mask32
+            d, i = delta(i)
+            free_cnt = (free_cnt + d) & mask32
+            duration, i = _varint(payload, i)
+            rows.append(["TIME", name(phase), name(op), str(size), str(t_in),
+                         str((t_in + duration) & self._ts_mask), name(result),
+                         str(alloc_cnt), str(free_cnt)])
+        return rows
+
+
+class _CsvStream:
+    """Appends validated log lines to a CSV as they arrive.
+
+    Only lines starting with one of EXPECTED_PREFIXES become rows; nothing is
+    buffered beyond the file object, so memory stays flat however long a run
+    is, and a crash mid-test keeps every row received so far.
+    """
+
+    FLUSH_ROWS: Final[int] = 256
+    FLUSH_SECONDS: Final[float] = 1.0
+    PROGRESS_SECONDS: Final[float] = 5.0
+
+    def __init__(self, csv_path: Path, test_name: str) -> None:
+        self._log = logging.getLogger("runner.serial")
+        self._file = open(csv_path, "w", newline="")
+        self._writer = csv.writer(self._file)
+        self._test = test_name.lower()
+        self.rows = 0
+        self.ignored = 0
+        self.trace_dropped = 0
+        self._unflushed = 0
+        self._last_flush = self._last_progress = time.time()
+
+    def feed(self, line: str) -> None:
+        stripped = line.strip()
+        if not stripped or stripped.startswith("#"):
+            return
+        if not any(stripped.startswith(pref) for pref in EXPECTED_PREFIXES):
+            # Banners and boot chatter; data lines never carry the test name.
+            self._log.debug(f"Ignoring unexpected line: '{stripped}'")
+            self.ignored += 1
+            return
+        fields = stripped.split(",")
+        if fields[:2] == ["META", "trace_dropped"] and len(fields) > 2 and fields[2].isdigit():
+            self.trace_dropped += int(fields[2])
+        self.write_row(fields)
+
+    def write_row(self, fields: Sequence[str]) -> None:
+        self._writer.writerow(fields)
+        self.rows += 1
+        self._unflushed += 1
+
+        now = time.time()
+        if self._unflushed >= self.FLUSH_ROWS or now - self._last_flush >= self.FLUSH_SECONDS:
+            self._file.flush()
+            self._unflushed = 0
+            self._last_flush = now
+        if now - self._last_progress >= self.PROGRESS_SECONDS:
+            self._log.info(f"    … {self.rows} rows")
+            self._last_progress = now
+
+    def close(self) -> None:
+        if self.ignored:
+            self._log.warning(f"    {self.ignored} unrecognised lines skipped (see -v)")
+        self._file.close()
+
+def _capture_and_write_csv(os_name: str, test_name: str, ser: _Console,
+                           results_dir: Path = RESULTS_DIR) -> CaptureStatus:
     log = logging.getLogger("runner.serial")
-    out_dir = RESULTS_DIR / os_name
+    out_dir = results_dir / os_name
     out_dir.mkdir(parents=True, exist_ok=True)
     csv_path = out_dir / f"{test_name}.csv"
 
-    log.info(f"Waiting for banners (overall timeout {SERIAL_TIMEOUT}s)...")
+    log.info(f"Waiting for banners (timeout {SERIAL_TIMEOUT}s without output)...")
+    # Pushed back by every line after the start banner, so a long test that
+    # keeps reporting (WorstCase's search) is not cut off.
     overall_deadline = time.time() + SERIAL_TIMEOUT
-    
+
     found_start_banner = False
-    # found_end_banner = False # Not needed, status will track this
-    collected_lines: List[str] = []
-    status: CaptureStatus = "NO_START" 
+    status: CaptureStatus = "NO_START"
+    try:
+        stream = _CsvStream(csv_path, test_name)
+    except OSError as e:
+        log.error(f"Failed to open CSV for {os_name}/{test_name}: {e}")
+        return "SERIAL_ERROR"
+    wire = _WireDecoder()
 
-    while time.time() < overall_deadline:
-        try:
-            raw = ser.readline()
-        except Exception as e:
-            log.error(f"Serial read error: {e}")
-            status = "SERIAL_ERROR"
-            break 
+    try:
+        while time.time() < overall_deadline:
+            try:
+                raw = ser.readline()
+            except Exception as e:
+                log.error(f"Serial read error: {e}")
+                status = "SERIAL_ERROR"
+                break
 
-        if not raw:
-            continue
+            if not raw:
+                if getattr(ser, "exhausted", False):
+                    log.debug("Console closed before the end banner.")
+                    break
+                continue
 
-        line = raw.decode("utf-8", errors="ignore").rstrip("\r\n")
-        lowercase = line.lower()
-
-        if not found_start_banner:
-            if test_name.lower() in lowercase and "start" in lowercase:
-                found_start_banner = True
-                log.info(f"Detected start banner: '{line}'. Beginning to collect logs.")
-                status = "NO_END" 
-        else: 
-            if test_name.lower() in lowercase and "end" in lowercase:
-                log.info(f"Detected end banner: '{line}'. Stopping collection.")
-                # Intentionally do not add end banner to collected_lines for CSV here,
-                # unless it also matches an EXPECTED_PREFIX (unlikely for simple banners)
-                status = "SUCCESS"
-                break 
-            collected_lines.append(line)
+            for kind, item in wire.feed(raw):
+                if kind == "row":
+                    if found_start_banner:
+                        stream.write_row(item)
+                    continue
+                line = item[0]
+                lowercase = line.lower()
 
+                if not found_start_banner:
+                    if test_name.lower() in lowercase and "start" in lowercase:
+                        found_start_banner = True
+                        log.info(f"Detected start banner: '{line}'. Beginning to collect logs.")
+                        status = "NO_END"
+                else:
+                    if test_name.lower() in lowercase and "end" in lowercase:
+                        log.info(f"Detected end banner: '{line}'. Stopping collection.")
+                        status = "SUCCESS"
+                        break
+                    stream.feed(line)
+            if status == "SUCCESS":
+                break
+            if found_start_banner:
+                overall_deadline = time.time() + SERIAL_TIMEOUT
+    finally:
+        if wire.lost or wire.corrupt:
+            # Keep the loss next to the data it affects.
+            log.warning(f"    binary trace: {wire.lost} frames lost ({wire.corrupt} of them "
+                        f"corrupt), {wire.frames} received")
+            stream.write_row(["META", "wire_dropped", str(wire.lost), str(wire.corrupt)])
+        elif wire.frames:
+            log.debug(f"    binary trace: {wire.frames} frames, none lost")
+        stream.close()
+
+    if status == "SUCCESS" and stream.trace_dropped:
+        # The CSV is incomplete; a run that looks complete must not pass.
+        status = "TRACE_DROPPED"
+        log.error(f"INCOMPLETE: {stream.trace_dropped} trace records did not fit the ring for "
+                  f"{os_name}/{test_name}. Build with -D AEAGLE_WIRE, -D AEAGLE_TRACE_HIST, "
+                  f"-D AEAGLE_LOG_TIME_EVERY=<n> or a larger AEAGLE_TRACE_CAPACITY.")
     if status == "NO_START":
         log.warning(f"TIMEOUT: Did not detect '{test_name} start' banner for {os_name}/{test_name}.")
     elif status == "NO_END":
         log.warning(f"CRASH/TIMEOUT: Detected '{test_name} start' but not '{test_name} end' banner for {os_name}/{test_name}.")
-    
-    if collected_lines or status == "SUCCESS": # Process if we have lines or if it was a success (even with no data lines)
-        log.info(f"Parsing {len(collected_lines)} lines and writing CSV to {csv_path}")
-        try:
-            with open(csv_path, "w", newline="") as f:
-                writer = csv.writer(f)
-                for raw_line in collected_lines:
-                    stripped = raw_line.strip()
-                    if not stripped or stripped.startswith("#"):
-                        continue
-                    
-                    # Banners should generally not be data lines unless they coincidentally match a prefix
-                    is_banner_line = False
-                    if test_name.lower() in stripped.lower(): # Heuristic for banner
-                        if "start" in stripped.lower() or "end" in stripped.lower():
-                             is_banner_line = not any(stripped.startswith(pref) for pref in EXPECTED_PREFIXES) # Only a banner if not a data line
-                    
-                    if is_banner_line:
-                        log.debug(f"Ignoring likely banner line from data: '{stripped}'")
-                        continue
-
-                    if any(stripped.startswith(pref) for pref in EXPECTED_PREFIXES):
-                        writer.writerow(stripped.split(","))
-                    else:
-                        log.debug(f"Ignoring unexpected line: '{stripped}'")
-        except Exception as e:
-            log.error(f"Failed to write CSV for {os_name}/{test_name}: {e}")
-    elif status != "SERIAL_ERROR" and status != "SUCCESS": # No lines, not a success, not a serial error (e.g. NO_START or NO_END with no lines)
-        log.warning(f"No standard log lines captured for {os_name}/{test_name}. CSV will be empty or not written if status indicates failure.")
-        # Create an empty CSV to signify the test ran but produced no valid data or timed out
-        with open(csv_path, "w", newline="") as f: 
-            pass # Creates an empty file
+    if stream.rows:
+        log.info(f"Wrote {stream.rows} rows to {csv_path}")
+    elif status != "SUCCESS":
+        log.warning(f"No standard log lines captured for {os_name}/{test_name}. CSV will be empty.")
 
     return status
 
 
-def _expand_jobs(os_opt: str | None, test_opt: str | None) -> Sequence[Tuple[str, str]]:
+def _backend_suites(backend: str) -> List[str]:
+    if backend == "host":
+        return list(dict.fromkeys([*_OS_MAP, *_FREERTOS_ALL_HEAPS]))
+    if backend == "qemu":
+        return list(_QEMU_OS_MAP)
+    if backend == "native":
+        return list(dict.fromkeys([*_NATIVE_OS_MAP, *_NATIVE_VIA_HOST]))
+    return list(_OS_MAP)
+
+def _expand_jobs(os_opt: str | None, test_opt: str | None,
+                 suites: Sequence[str] = tuple(_OS_MAP)) -> Sequence[Tuple[str, str]]:
     if not os_opt and not test_opt:
         raise ValueError("Specify at least --os or --test")
+    if os_opt and os_opt not in suites:
+        raise ValueError(f"Suite '{os_opt}' is not available here. Supported: {', '.join(sorted(suites))}")
 
     if os_opt and test_opt:
         return [(os_opt, test_opt)]
@@ -240,7 +984,7 @@ def _expand_jobs(os_opt: str | None, test_opt: str | None) -> Sequence[Tuple[str
 
     if test_opt:
         jobs: List[Tuple[str, str]] = []
-        for suite in _OS_MAP:
+        for suite in suites:
             suite_path_name = "freertos" if suite.startswith("freertosv") else suite
             if (TESTS_DIR / suite_path_name / f"{test_opt}.c").is_file():
                 jobs.append((suite, test_opt))
@@ -250,18 +994,437 @@ def _expand_jobs(os_opt: str | None, test_opt: str | None) -> Sequence[Tuple[str
     return [] 
 
 
+def _run_board_job(os_name: str, test_name: str) -> JobStatus:
+    log = logging.getLogger("runner")
+    try:
+        ser = serial.Serial(
+            port=SERIAL_PORT,
+            baudrate=SERIAL_BAUDRATE,
+            timeout=0.1, 
+        )
+        drain_deadline = time.time() + 0.2
+        while time.time() < drain_deadline:
+            ser.read(ser.in_waiting or 1) 
+    except Exception as e:
+        log.error(f"Could not open or drain {SERIAL_PORT}: {e}")
+        return "FLASH_FAIL"
+
+    try:
+        if _multi_image_mode:
+            return _run_board_multi(os_name, test_name, ser)
+        demo_name = _OS_MAP.get(os_name, "")
+        artifact = _BOARD_IMAGE.get(demo_name)
+        try:
+            src_test, _, _ = _resolve_paths(os_name, test_name)
+            key = _cache_key("board", os_name, demo_name, "flash.sh", [src_test]) if artifact else None
+        except (KeyError, FileNotFoundError):
+            key = None  # flash_pair reports the bad path
+        cached = _cache_lookup(key, artifact) if key and artifact else None
+        if cached:
+            log.info(f"♻️  cached image {key[:12]}")
+        rc = flash_pair(os_name, test_name,
+                        extra_env={"AEAGLE_IMAGE": str(cached)} if cached else None)
+        if rc != 0:
+            return "FLASH_FAIL"
+        if key and artifact and not cached:
+            image = APPS_DIR / demo_name / artifact
+            if image.is_file():
+                _cache_store(key, image)
+        return _capture_and_write_csv(os_name, test_name, ser)
+    finally:
+        ser.close()
+
+_build_locks: Dict[Tuple[str, ...], threading.Lock] = {}
+_build_locks_guard = threading.Lock()
+
+def _build_lock(*key: str) -> threading.Lock:
+    with _build_locks_guard:
+        return _build_locks.setdefault(key, threading.Lock())
+
+def build_host(os_name: str) -> Optional[Path]:
+    """Builds the host-native engine for one suite; make keeps it incremental."""
+    log = logging.getLogger("runner.host")
+    # All tests of a suite share build/<suite>/; build it once at a time.
+    with _build_lock("host", os_name):
+        res = subprocess.run(
+            ["make", "-C", str(HOST_DIR), f"SUITE={os_name}",
+             f"AEAGLE_DEFINES={' '.join(_build_defines)}"],
+            capture_output=True, text=True,
+        )
+    if res.returncode != 0:
+        log.error(f"Host build failed for {os_name} (code {res.returncode})")
+        log.debug(res.stdout + res.stderr)
+        return None
+    return HOST_DIR / "build" / os_name / "aeagle-host"
+
+def _host_test_args(test_name: str, out_dir: Path) -> List[str]:
+    # The engine streams a --trace file itself instead of compiling it in.
+    if test_name == "Replay" and REPLAY_TRACE_BIN.is_file():
+        return [str(REPLAY_TRACE_BIN)]
+    # WorstCase writes the sequence it found next to its CSV, ready for
+    # --trace.
+    if test_name == "WorstCase":
+        out_dir.mkdir(parents=True, exist_ok=True)
+        return [str(out_dir / f"{test_name}.aetr")]
+    return []
+
+def _run_host_job(os_name: str, test_name: str) -> JobStatus:
+    log = logging.getLogger("runner.host")
+    binary = build_host(os_name)
+    if binary is None:
+        return "FLASH_FAIL"
+    log.info(f"🖥️  {os_name:12} ← {test_name}  (host)")
+    args = _host_test_args(test_name, _results_dir("host") / os_name)
+    console = _ProcessConsole([str(binary), test_name, *args])
+    try:
+        return _capture_and_write_csv(os_name, test_name, console, _results_dir("host"))
+    finally:
+        console.close()
+
+class _QemuInstance:
+    """One halted qemu-system-arm whose UART is bridged to a pty.
+
+    The machine starts paused (-S) so the pty can be opened before the first
+    byte is printed; `start()` resumes it through the monitor on stdin.
+    """
+
+    def __init__(self, elf: Path) -> None:
+        self._proc = subprocess.Popen(
+            [QEMU_BINARY, "-machine", QEMU_MACHINE, "-cpu", QEMU_CPU,
+             "-display", "none", "-S", "-monitor", "stdio",
+             "-serial", "pty", "-kernel", str(elf)],
+            stdin=subprocess.PIPE, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+            text=True,
+        )
+        self.port = self._wait_for_pty()
+
+    def _wait_for_pty(self) -> str:
+        assert self._proc.stdout is not None
+        for line in self._proc.stdout:
+            # "char device redirected to /dev/pts/3 (label serial0)"
+            if "redirected to" in line:
+                return line.split("redirected to", 1)[1].split()[0]
+        raise RuntimeError(f"{QEMU_BINARY} exited before exposing a serial pty")
+
+    def start(self) -> None:
+        assert self._proc.stdin is not None
+        self._proc.stdin.write("cont\n")
+        self._proc.stdin.flush()
+
+    def close(self) -> None:
+        if self._proc.poll() is None:
+            self._proc.terminate()
+            try:
+                self._proc.wait(timeout=1.0)
+            except subprocess.TimeoutExpired:
+                self._proc.kill()
+                self._proc.wait()
+        for stream in (self._proc.stdin, self._proc.stdout):
+            if stream:
+                stream.close()
+
+def _build_staged(backend: str, os_name: str, test_name: str, demo_name: str,
+                  script: str, artifact: str) -> Optional[Path]:
+    """Stages the demo for one job, runs its build script there and returns
+    the built artifact, or None if the build failed."""
+    log = logging.getLogger(f"runner.{backend}")
+    try:
+        src_test, _, _ = _resolve_paths(os_name, test_name, demo_name)
+        key = _cache_key(backend, os_name, demo_name, script, [src_test])
+    except (KeyError, FileNotFoundError) as e:
+        log.error(f"Path resolution error for {os_name}/{test_name}: {e}")
+        return None
+    cached = _cache_lookup(key, artifact)
+    if cached:
+        log.info(f"♻️  {os_name:12} ← {test_name}  cached image {key[:12]}")
+        return cached
+
+    apps_dir = _stage_workspace(backend, os_name, test_name, demo_name)
+    if flash_pair(os_name, test_name, script, demo_name, apps_dir) != 0:
+        return None
+    image = apps_dir / demo_name / artifact
+    if not image.is_file():
+        log.error(f"Build produced no {image}")
+        return None
+    return _cache_store(key, image)
+
+_multi_image_mode = False
+_multi_images: Dict[Tuple[str, str], Optional[Path]] = {}
+_board_flashed_suite: Optional[str] = None
+
+def _dispatch_family(os_name: str) -> str:
+    if os_name.startswith("freertosv"):
+        return "freertos"
+    if os_name in ("zephyr", "newlib", "newlib-nano"):
+        return "zephyr"
+    return os_name.split("-", 1)[0]
+
+def _wrapper_source(family: str, test: Path, first: bool) -> str:
+    """One test as a translation unit of a multi-test image."""
+    name = test.stem
+    lines = [f"/* Generated by AEAgle.py: {test.relative_to(PROJECT_ROOT)} in a multi-test image. */"]
+    if family == "freertos":
+        lines += [
+            '#include "FreeRTOS.h"',
+            '#include "task.h"',
+            "#include <ti/drivers/Board.h>",
+            "/* The dispatcher task already set up the board and the scheduler. */",
+            "#define Board_init() ((void)0)",
+            "#define vTaskStartScheduler() vTaskSuspend(NULL)",
+        ]
+    elif family == "zephyr":
+        lines.append("#include <zephyr/kernel.h>")
+        if not first:
+            # Every test defines the same 64 KiB my_heap; keep one copy.
+            lines += ["#undef K_HEAP_DEFINE",
+                      "#define K_HEAP_DEFINE(name, bytes) extern struct k_heap name"]
+    elif family == "contiki":
+        lines += [
+            '#include "contiki.h"',
+            "#undef AUTOSTART_PROCESSES",
+            "#define AUTOSTART_PROCESSES(...) \\",
+            f"  struct process *const aeagle_autostart_{name}[] = {{__VA_ARGS__, NULL}}",
+        ]
+    if family != "contiki":
+        lines.append(f"#define main aeagle_test_{name}")
+    lines.append(f'#include "{test}"')
+    return "\n".join(lines) + "\n"
+
+def _write_multi_sources(os_name: str, demo_dir: Path) -> None:
+    """Puts the dispatcher in main.c and one aeagle_test_<Name>.c wrapper per
+    test next to it, plus the aeagle_tests.h list the dispatcher includes."""
+    family = _dispatch_family(os_name)
+    dest_main = _dest_main(demo_dir)
+    tests = _suite_test_sources(os_name)
+    for i, test in enumerate(tests):
+        (dest_main.parent / f"aeagle_test_{test.stem}.c").write_text(
+            _wrapper_source(family, test, first=i == 0))
+    header = [
+        "/* Generated by AEAgle.py. */",
+        f'#define AEAGLE_SUITE_NAME "{os_name}"',
+        "#define AEAGLE_TESTS \\",
+        *[f"  AEAGLE_TEST({t.stem}) \\" for t in tests],
+        "",
+    ]
+    (dest_main.parent / "aeagle_tests.h").write_text("\n".join(header) + "\n")
+    shutil.copy2(DISPATCH_DIR / f"{family}.c", dest_main)
+
+def _multi_image(backend: str, os_name: str, demo_name: str, script: str,
+                 artifact: str) -> Optional[Path]:
+    """Builds (once per run) the image holding every test of `os_name`."""
+    log = logging.getLogger(f"runner.{backend}")
+    with _build_lock(backend, "multi", os_name):
+        if (backend, os_name) in _multi_images:
+            return _multi_images[(backend, os_name)]
+        sources = [*_suite_test_sources(os_name), DISPATCH_DIR / f"{_dispatch_family(os_name)}.c"]
+        key = _cache_key(backend, os_name, demo_name, f"{script}+multi", sources)
+        image = _cache_lookup(key, artifact)
+        if image:
+            log.info(f"♻️  {os_name:12} multi-test image {key[:12]}")
+        else:
+            apps_dir = _stage_workspace(backend, os_name, _MULTI_LABEL, demo_name)
+            demo_dir = apps_dir / demo_name
+            try:
+                _write_multi_sources(os_name, demo_dir)
+                log.info(f"📦  {os_name:12} ← {len(sources) - 1} tests  ({script})")
+                rc = _run_flash(demo_dir / script, demo_dir, os_name, {"AEAGLE_MULTI": "1"})
+                built = demo_dir / artifact
+                if rc != 0 or not built.is_file():
+                    log.error(f"Multi-test build failed for {os_name} (code {rc})")
+                else:
+                    image = _cache_store(key, built)
+            finally:
+                shutil.rmtree(apps_dir.parent, ignore_errors=True)
+        _multi_images[(backend, os_name)] = image
+        return image
+
+def _select_test(ser: _Console, test_name: str) -> bool:
+    """Waits for the dispatcher's ready banner and sends it the test name."""
+    log = logging.getLogger("runner.serial")
+    deadline = time.time() + SERIAL_TIMEOUT
+    while time.time() < deadline:
+        raw = ser.readline()
+        if not raw:
+            if getattr(ser, "exhausted", False):
+                break
+            continue
+        line = raw.decode("utf-8", errors="ignore").strip()
+        if line.startswith("#") and line.endswith("ready"):
+            ser.write(f"{test_name}\n".encode())
+            return True
+    log.warning(f"TIMEOUT: no dispatcher ready banner before {test_name}.")
+    return False
+
+def _run_board_multi(os_name: str, test_name: str, ser: serial.Serial) -> JobStatus:
+    global _board_flashed_suite
+    log = logging.getLogger("runner")
+    demo_name = _OS_MAP[os_name]
+    if _board_flashed_suite != os_name:
+        # Board builds flash as they go, so build and flash in one staged run
+        # unless the cache already holds the image.
+        sources = [*_suite_test_sources(os_name), DISPATCH_DIR / f"{_dispatch_family(os_name)}.c"]
+        key = _cache_key("board", os_name, demo_name, "flash.sh+multi", sources)
+        cached = _cache_lookup(key, _BOARD_IMAGE[demo_name])
+        if cached:
+            demo_dir = APPS_DIR / demo_name
+            rc = _run_flash(demo_dir / "flash.sh", demo_dir, os_name, {"AEAGLE_IMAGE": str(cached)})
+        else:
+            apps_dir = _stage_workspace("board", os_name, _MULTI_LABEL, demo_name)
+            demo_dir = apps_dir / demo_name
+            try:
+                _write_multi_sources(os_name, demo_dir)
+                rc = _run_flash(demo_dir / "flash.sh", demo_dir, os_name, {"AEAGLE_MULTI": "1"})
+                built = demo_dir / _BOARD_IMAGE[demo_name]
+                if rc == 0 and built.is_file():
+                    _cache_store(key, built)
+            finally:
+                shutil.rmtree(apps_dir.parent, ignore_errors=True)
+        if rc != 0:
+            log.warning(f"    ⚠️  multi-test flash failed for {os_name} (code {rc})")
+            _board_flashed_suite = None
+            return "FLASH_FAIL"
+        _board_flashed_suite = os_name
+
+    if subprocess.run(BOARD_RESET_CMD, capture_output=True).returncode != 0:
+        log.error("Board reset failed")
+        return "FLASH_FAIL"
+    if not _select_test(ser, test_name):
+        return "NO_START"
+    return _capture_and_write_csv(os_name, test_name, ser)
+
+def _run_qemu_job(os_name: str, test_name: str) -> JobStatus:
+    log = logging.getLogger("runner.qemu")
+    demo_name = _QEMU_OS_MAP.get(os_name)
+    if demo_name is None:
+        log.error(f"No QEMU port for suite '{os_name}'. Supported: {', '.join(sorted(_QEMU_OS_MAP))}")
+        return "FLASH_FAIL"
+
+    try:
+        if _multi_image_mode:
+            elf = _multi_image("qemu", os_name, demo_name, "qemu.sh", _QEMU_ELF[demo_name])
+        else:
+            elf = _build_staged("qemu", os_name, test_name, demo_name, "qemu.sh", _QEMU_ELF[demo_name])
+        if elf is None:
+            return "FLASH_FAIL"
+
+        log.info(f"🧪  {os_name:12} ← {test_name}  ({QEMU_MACHINE})")
+        try:
+            vm = _QemuInstance(elf)
+        except (OSError, RuntimeError) as e:
+            log.error(f"Could not start {QEMU_BINARY}: {e}")
+            return "FLASH_FAIL"
+        try:
+            ser = serial.Serial(port=vm.port, timeout=0.1)
+        except Exception as e:
+            log.error(f"Could not open QEMU console {vm.port}: {e}")
+            vm.close()
+            return "SERIAL_ERROR"
+        try:
+            vm.start()
+            if _multi_image_mode and not _select_test(ser, test_name):
+                return "NO_START"
+            return _capture_and_write_csv(os_name, test_name, ser, _results_dir("qemu"))
+        finally:
+            ser.close()
+            vm.close()
+    finally:
+        shutil.rmtree(WORK_DIR / "qemu" / f"{os_name}-{test_name}", ignore_errors=True)
+
+def _run_native_job(os_name: str, test_name: str) -> JobStatus:
+    log = logging.getLogger("runner.native")
+    if os_name in _NATIVE_VIA_HOST:
+        binary = build_host(os_name)
+        if binary is None:
+            return "FLASH_FAIL"
+        log.info(f"🐧  {os_name:12} ← {test_name}  (native, host engine)")
+        args = _host_test_args(test_name, _results_dir("native") / os_name)
+        console = _ProcessConsole([str(binary), test_name, *args])
+        try:
+            return _capture_and_write_csv(os_name, test_name, console, _results_dir("native"))
+        finally:
+            console.close()
+
+    demo_name = _NATIVE_OS_MAP.get(os_name)
+    if demo_name is None:
+        supported = sorted(set(_NATIVE_OS_MAP) | _NATIVE_VIA_HOST)
+        log.error(f"No native build for suite '{os_name}'. Supported: {', '.join(supported)}")
+        return "FLASH_FAIL"
+
+    try:
+        argv: List[str] = []
+        if _multi_image_mode:
+            exe = _multi_image("native", os_name, demo_name, "build_native.sh",
+                               _NATIVE_EXE[demo_name])
+            if demo_name in _NATIVE_TEST_ARGS:
+                argv = [*_NATIVE_TEST_ARGS[demo_name], test_name]
+        else:
+            exe = _build_staged("native", os_name, test_name, demo_name, "build_native.sh",
+                                _NATIVE_EXE[demo_name])
+        if exe is None:
+            return "FLASH_FAIL"
+        log.info(f"🐧  {os_name:12} ← {test_name}  (native)")
+        console = _ProcessConsole([str(exe), *argv], cwd=exe.parent)
+        try:
+            if _multi_image_mode and not _select_test(console, test_name):
+                return "NO_START"
+            return _capture_and_write_csv(os_name, test_name, console, _results_dir("native"))
+        finally:
+            console.close()
+    finally:
+        shutil.rmtree(WORK_DIR / "native" / f"{os_name}-{test_name}", ignore_errors=True)
+
+_JOB_RUNNERS: Final[Dict[str, Callable[[str, str], JobStatus]]] = {
+    "board": _run_board_job,
+    "host": _run_host_job,
+    "qemu": _run_qemu_job,
+    "native": _run_native_job,
+}
+
+
 def main() -> None:
     p = argparse.ArgumentParser(description="Deploy, flash, and capture allocator tests")
     p.add_argument("-o", "--os", help="Test-suite name (folder under tests/)")
     p.add_argument("-t", "--test", help="Test name (without .c)")
+    p.add_argument("-b", "--backend", choices=BACKENDS, default="board",
+                   help="Where to run: flashed board (default), the host-native engine, "
+                        "QEMU mps2-an385, or the OS's own native port")
+    p.add_argument("-j", "--jobs", type=int, default=1,
+                   help="Jobs to run at once (0 = one per CPU); the board backend is always serial")
+    p.add_argument("--no-cache", action="store_true",
+                   help=f"Always rebuild; do not reuse images from {CACHE_DIR.name}/")
+    p.add_argument("-m", "--multi-image", action="store_true",
+                   help="Build one image per suite with every test and pick the test at boot")
+    p.add_argument("-D", "--define", action="append", default=[], metavar="NAME[=VALUE]",
+                   help="Preprocessor switch for every build, e.g. -D AEAGLE_TRACE_HIST "
+                        "for latency histograms instead of TIME lines")
+    p.add_argument("--trace", type=Path, metavar="FILE",
+                   help="Allocation trace for the Replay test: text (op,size,id,dt per line) "
+                        "or binary .aetr; without it Replay runs the built-in sample trace")
+    p.add_argument("--sizes", type=Path, metavar="FILE",
+                   help="Size histogram for RandomSizes' hist phase (size,weight per line); "
+                        "without it the built-in one is used")
     p.add_argument("-v", "--verbose", action="store_true", help="Verbose output")
     args = p.parse_args()
 
     _setup_logging(args.verbose)
     log = logging.getLogger("runner")
+    global _cache_enabled, _multi_image_mode
+    _cache_enabled = not args.no_cache
+    _multi_image_mode = args.multi_image
+    _build_defines[:] = sorted(set(args.define))
+    try:
+        _install_replay_trace(args.trace)
+    except (OSError, ValueError) as exc:
+        log.error(f"Replay trace {args.trace}: {exc}")
+        sys.exit(1)
+    try:
+        _install_size_histogram(args.sizes)
+    except (OSError, ValueError) as exc:
+        log.error(f"Size histogram {args.sizes}: {exc}")
+        sys.exit(1)
 
     try:
-        jobs = _expand_jobs(args.os, args.test)
+        jobs = _expand_jobs(args.os, args.test, _backend_suites(args.backend))
     except Exception as exc:
         log.error(exc)
         sys.exit(1)
@@ -270,38 +1433,41 @@ def main() -> None:
     crashed_tests: List[Tuple[str, str]] = [] # Tests that started but didn't end
     no_start_timeouts: List[Tuple[str, str]] = [] # Tests that never showed start banner
     serial_errors: List[Tuple[str, str]] = [] # Other serial communication issues
+    incomplete: List[Tuple[str, str]] = [] # Ended, but trace records were dropped
     
-    for os_name, test_name in jobs:
-        try:
-            ser = serial.Serial(
-                port=SERIAL_PORT,
-                baudrate=SERIAL_BAUDRATE,
-                timeout=0.1, 
-            )
-            drain_deadline = time.time() + 0.2
-            while time.time() < drain_deadline:
-                ser.read(ser.in_waiting or 1) 
-        except Exception as e:
-            log.error(f"Could not open or drain {SERIAL_PORT}: {e}")
-            flash_failures.append((os_name, test_name))
-            continue
+    run_job = _JOB_RUNNERS[args.backend]
+    workers = args.jobs if args.jobs > 0 else (os.cpu_count() or 1)
+    if args.backend == "board" and workers > 1:
+        log.warning(f"Only one board is attached; ignoring -j {workers}.")
+        workers = 1
 
-        rc = flash_pair(os_name, test_name)
-        if rc != 0:
-            flash_failures.append((os_name, test_name))
-            ser.close()
-            continue
+    results: List[Tuple[str, str, JobStatus]] = []
+    with ThreadPoolExecutor(max_workers=workers) as pool:
+        futures = {pool.submit(run_job, os_name, test_name): (os_name, test_name)
+                   for os_name, test_name in jobs}
+        for fut in as_completed(futures):
+            os_name, test_name = futures[fut]
+            try:
+                status = fut.result()
+            except Exception as e:
+                log.error(f"{os_name}/{test_name} raised: {e}")
+                status = "FLASH_FAIL"
+            results.append((os_name, test_name, status))
 
-        capture_status = _capture_and_write_csv(os_name, test_name, ser)
-        
-        if capture_status == "NO_END":
+    # Completion order varies between runs; report in job order.
+    order = {job: i for i, job in enumerate(jobs)}
+    results.sort(key=lambda r: order[(r[0], r[1])])
+    for os_name, test_name, status in results:
+        if status == "FLASH_FAIL":
+            flash_failures.append((os_name, test_name))
+        elif status == "NO_END":
             crashed_tests.append((os_name, test_name))
-        elif capture_status == "NO_START":
+        elif status == "NO_START":
             no_start_timeouts.append((os_name, test_name))
-        elif capture_status == "SERIAL_ERROR":
+        elif status == "SERIAL_ERROR":
             serial_errors.append((os_name, test_name))
-        
-        ser.close()
+        elif status == "TRACE_DROPPED":
+            incomplete.append((os_name, test_name))
 
     log.info("\n───────── SUMMARY ─────────")
     has_issues = False
@@ -329,6 +1495,12 @@ def main() -> None:
         for os_name, test_name in serial_errors:
             log.error(f"  {os_name:12} {test_name}  🔌 (Serial Err)")
 
+    if incomplete:
+        has_issues = True
+        log.error("Incomplete Traces (META,trace_dropped; see -D options above):")
+        for os_name, test_name in incomplete:
+            log.error(f"  {os_name:12} {test_name}  ✂️ (Dropped)")
+
 
     if not has_issues:
         log.info("All tests processed successfully. 🎉")
@@ -0,0 +1,9 @@
+#!/bin/bash
+
+# Build the test as a Linux process; AEAgle.py runs build/native/main.native
+# and reads its stdout.
+
+set -e
+
+make TARGET=native clean
+make TARGET=native all
@@ -1,5 +1,11 @@
 #!/bin/bash
 
+# AEAgle.py passes a cached image when the inputs have not changed.
+if [ -n "${AEAGLE_IMAGE:-}" ]; then
+  /home/lmg/ti/uniflash_9.1.0/dslite.sh -c cc1352r1f3.ccxml -l settings.ufsettings -a Erase
+  exec /home/lmg/ti/uniflash_9.1.0/dslite.sh -f -c cc1352r1f3.ccxml -l settings.ufsettings -e "$AEAGLE_IMAGE"
+fi
+
 make TARGET=simplelink BOARD=launchpad/cc1352r1 PORT=/dev/ttyACM0 clean
 make TARGET=simplelink BOARD=launchpad/cc1352r1 PORT=/dev/ttyACM0 all
 
@@ -17,4 +17,9 @@
 
 #define HEAPMEM_CONF_ARENA_SIZE 57000
 
+#ifndef CONTIKI_TARGET_NATIVE
+/* CC1352 core clock, for the DWT cycle counter in aeagle_timer.h. */
+#define AEAGLE_TIMER_CPU_HZ 48000000UL
+#endif
+
 #endif /* PROJECT_CONF_H_ */
@@ -0,0 +1,36 @@
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*
+ * FreeRTOS configuration for the QEMU MPS2 AN385 (Cortex-M3) image. Heap and
+ * tick rate match the CC1352 build generated from demo-freertos.syscfg.
+ */
+
+#define configCPU_CLOCK_HZ ((unsigned long)25000000)
+#define configTICK_RATE_HZ ((TickType_t)1000)
+#define configUSE_PREEMPTION 1
+#define configUSE_IDLE_HOOK 0
+#define configUSE_TICK_HOOK 1
+#define configMAX_PRIORITIES 5
+#define configMINIMAL_STACK_SIZE ((unsigned short)128)
+#define configMAX_TASK_NAME_LEN 16
+#define configUSE_16_BIT_TICKS 0
+#define configTICK_TYPE_WIDTH_IN_BITS TICK_TYPE_WIDTH_32_BITS
+#define configUSE_MUTEXES 1
+#define configUSE_TIMERS 0
+#define configUSE_MALLOC_FAILED_HOOK 0
+#define configCHECK_FOR_STACK_OVERFLOW 0
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define configSUPPORT_STATIC_ALLOCATION 0
+#define configTOTAL_HEAP_SIZE ((size_t)0x00010000)
+
+#define INCLUDE_vTaskSuspend 1
+#define INCLUDE_vTaskDelay 1
+#define INCLUDE_vTaskDelayUntil 1
+
+/* AN385 implements three NVIC priority bits. */
+#define configPRIO_BITS 3
+#define configKERNEL_INTERRUPT_PRIORITY (7 << (8 - configPRIO_BITS))
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY (4 << (8 - configPRIO_BITS))
+
+#endif /* FREERTOS_CONFIG_H */
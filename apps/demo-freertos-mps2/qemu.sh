@@ -0,0 +1,6 @@
+#!/bin/bash
+
+set -e
+
+make clean HEAP_IMPL="${HEAP_IMPL:-4}"
+make all HEAP_IMPL="${HEAP_IMPL:-4}"
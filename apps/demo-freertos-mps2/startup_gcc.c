@@ -0,0 +1,58 @@
+#include <stdint.h>
+
+/*
+ * Minimal Cortex-M3 startup for the QEMU MPS2 AN385 machine: copy .data,
+ * clear .bss, run main(). FreeRTOS owns SVC, PendSV and SysTick.
+ */
+
+extern uint32_t _sidata, _sdata, _edata, _sbss, _ebss, _estack;
+
+extern int main(void);
+extern void vPortSVCHandler(void);
+extern void xPortPendSVHandler(void);
+extern void xPortSysTickHandler(void);
+
+void Reset_Handler(void);
+
+static void Default_Handler(void)
+{
+  for (;;)
+  {
+  }
+}
+
+__attribute__((section(".isr_vector"), used)) static void (*const vector_table[])(void) = {
+    (void (*)(void))(&_estack),
+    Reset_Handler,
+    Default_Handler, /* NMI */
+    Default_Handler, /* HardFault */
+    Default_Handler, /* MemManage */
+    Default_Handler, /* BusFault */
+    Default_Handler, /* UsageFault */
+    0,
+    0,
+    0,
+    0,
+    vPortSVCHandler,
+    Default_Handler, /* DebugMon */
+    0,
+    xPortPendSVHandler,
+    xPortSysTickHandler,
+};
+
+void Reset_Handler(void)
+{
+  uint32_t *src = &_sidata;
+  uint32_t *dst = &_sdata;
+
+  while (dst < &_edata)
+  {
+    *dst++ = *src++;
+  }
+  for (dst = &_sbss; dst < &_ebss;)
+  {
+    *dst++ = 0;
+  }
+  main();
+  Default_Handler();
+}
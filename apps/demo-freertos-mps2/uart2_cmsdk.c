@@ -0,0 +1,117 @@
+#include "FreeRTOS.h"
+#include "portable.h"
+#include <ti/drivers/Board.h>
+#include <ti/drivers/UART2.h>
+
+/*
+ * UART2 on top of the CMSDK APB UART0 of the MPS2 AN385 image that
+ * qemu-system-arm emulates. QEMU ignores the baud divider but it must be
+ * non-zero for the transmitter to run.
+ */
+
+#define CMSDK_UART0_BASE 0x40004000UL
+
+typedef struct
+{
+  volatile uint32_t DATA;
+  volatile uint32_t STATE;
+  volatile uint32_t CTRL;
+  volatile uint32_t INTSTATUS;
+  volatile uint32_t BAUDDIV;
+} cmsdk_uart_t;
+
+#define UART0 ((cmsdk_uart_t *)CMSDK_UART0_BASE)
+
+#define UART_STATE_TX_FULL (1U << 0)
+#define UART_STATE_RX_FULL (1U << 1)
+#define UART_CTRL_TX_EN (1U << 0)
+#define UART_CTRL_RX_EN (1U << 1)
+
+struct UART2_Config_
+{
+  bool open;
+};
+
+static struct UART2_Config_ uart0_config;
+
+#if HEAP_IMPL == 5
+/* heap_5 has no static arena; hand it one of configTOTAL_HEAP_SIZE so the
+ * tests see the same capacity as with the other schemes. */
+static uint8_t heap5_region[configTOTAL_HEAP_SIZE] __attribute__((aligned(8)));
+#endif
+
+void Board_init(void)
+{
+#if HEAP_IMPL == 5
+  static const HeapRegion_t regions[] = {
+      {heap5_region, sizeof(heap5_region)},
+      {NULL, 0},
+  };
+  vPortDefineHeapRegions(regions);
+#endif
+}
+
+/* The tick hook is on for IsrLatency, which defines its own; every other
+ * test links this one. */
+__attribute__((weak)) void vApplicationTickHook(void)
+{
+}
+
+void UART2_Params_init(UART2_Params *params)
+{
+  params->baudRate = 115200;
+}
+
+UART2_Handle UART2_open(uint_least8_t index, UART2_Params *params)
+{
+  (void)params;
+  if (index != 0 || uart0_config.open)
+  {
+    return NULL;
+  }
+  UART0->BAUDDIV = 16;
+  UART0->CTRL = UART_CTRL_TX_EN | UART_CTRL_RX_EN;
+  uart0_config.open = true;
+  return &uart0_config;
+}
+
+void UART2_close(UART2_Handle handle)
+{
+  handle->open = false;
+}
+
+int_fast16_t UART2_write(UART2_Handle handle, const void *buffer, size_t size, size_t *bytesWritten)
+{
+  const uint8_t *p = buffer;
+  (void)handle;
+  for (size_t i = 0; i < size; i++)
+  {
+    while (UART0->STATE & UART_STATE_TX_FULL)
+    {
+    }
+    UART0->DATA = p[i];
+  }
+  if (bytesWritten)
+  {
+    *bytesWritten = size;
+  }
+  return UART2_STATUS_SUCCESS;
+}
+
+int_fast16_t UART2_read(UART2_Handle handle, void *buffer, size_t size, size_t *bytesRead)
+{
+  uint8_t *p = buffer;
+  (void)handle;
+  for (size_t i = 0; i < size; i++)
+  {
+    while (!(UART0->STATE & UART_STATE_RX_FULL))
+    {
+    }
+    p[i] = (uint8_t)UART0->DATA;
+  }
+  if (bytesRead)
+  {
+    *bytesRead = size;
+  }
+  return UART2_STATUS_SUCCESS;
+}
@@ -0,0 +1,9 @@
+#!/bin/bash
+
+# Build the test as a Linux process; AEAgle.py runs build/demo-freertos and
+# reads its stdout.
+
+set -e
+
+make clean HEAP_IMPL="${HEAP_IMPL:-4}"
+make all HEAP_IMPL="${HEAP_IMPL:-4}"
@@ -0,0 +1,123 @@
+#include "FreeRTOS.h"
+#include "portable.h"
+#include <ti/drivers/Board.h>
+#include <ti/drivers/UART2.h>
+#include <errno.h>
+#include <malloc.h>
+#include <unistd.h>
+
+/*
+ * UART2 on top of the process' stdin/stdout, so the runner reads the same
+ * log lines the board prints over its UART.
+ */
+
+struct UART2_Config_
+{
+  bool open;
+};
+
+static struct UART2_Config_ stdio_config;
+
+#if HEAP_IMPL == 5
+/* heap_5 has no static arena; hand it one of configTOTAL_HEAP_SIZE so the
+ * tests see the same capacity as with the other schemes. */
+static uint8_t heap5_region[configTOTAL_HEAP_SIZE] __attribute__((aligned(8)));
+#endif
+
+void Board_init(void)
+{
+#if HEAP_IMPL == 5
+  static const HeapRegion_t regions[] = {
+      {heap5_region, sizeof(heap5_region)},
+      {NULL, 0},
+  };
+  vPortDefineHeapRegions(regions);
+#endif
+}
+
+/* The tick hook is on for IsrLatency, which defines its own; every other
+ * test links this one. */
+__attribute__((weak)) void vApplicationTickHook(void)
+{
+}
+
+#if HEAP_IMPL == 3
+/* heap_3 forwards to the C library and keeps no accounting of its own; report
+ * what glibc's arena has left so the tests' SNAP lines stay populated. */
+size_t xPortGetFreeHeapSize(void)
+{
+  struct mallinfo2 mi = mallinfo2();
+  return mi.fordblks;
+}
+#endif
+
+void UART2_Params_init(UART2_Params *params)
+{
+  params->baudRate = 115200;
+}
+
+UART2_Handle UART2_open(uint_least8_t index, UART2_Params *params)
+{
+  (void)params;
+  if (index != 0 || stdio_config.open)
+  {
+    return NULL;
+  }
+  stdio_config.open = true;
+  return &stdio_config;
+}
+
+void UART2_close(UART2_Handle handle)
+{
+  handle->open = false;
+}
+
+int_fast16_t UART2_write(UART2_Handle handle, const void *buffer, size_t size, size_t *bytesWritten)
+{
+  const uint8_t *p = buffer;
+  size_t done = 0;
+  (void)handle;
+  while (done < size)
+  {
+    ssize_t n = write(STDOUT_FILENO, p + done, size - done);
+    if (n < 0 && errno == EINTR)
+    {
+      continue; /* the port's tick signal */
+    }
+    if (n <= 0)
+    {
+      break;
+    }
+    done += (size_t)n;
+  }
+  if (bytesWritten)
+  {
+    *bytesWritten = done;
+  }
+  return UART2_STATUS_SUCCESS;
+}
+
+int_fast16_t UART2_read(UART2_Handle handle, void *buffer, size_t size, size_t *bytesRead)
+{
+  uint8_t *p = buffer;
+  size_t done = 0;
+  (void)handle;
+  while (done < size)
+  {
+    ssize_t n = read(STDIN_FILENO, p + done, size - done);
+    if (n < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (n <= 0)
+    {
+      break;
+    }
+    done += (size_t)n;
+  }
+  if (bytesRead)
+  {
+    *bytesRead = done;
+  }
+  return UART2_STATUS_SUCCESS;
+}
@@ -2,6 +2,13 @@
 
 set -e
 
+# AEAgle.py passes a cached image when the inputs have not changed.
+if [ -n "${AEAGLE_IMAGE:-}" ]; then
+  /home/lmg/ti/uniflash_9.1.0/dslite.sh -c targetConfigs/CC1352R1F3.ccxml -a Erase
+  /home/lmg/ti/uniflash_9.1.0/dslite.sh -f -c targetConfigs/CC1352R1F3.ccxml "$AEAGLE_IMAGE"
+  exit 0
+fi
+
 make clean HEAP_IMPL="${HEAP_IMPL:-4}"
 
 /home/lmg/ti/sysconfig_1.21.1/sysconfig_cli.sh --script demo-freertos.syscfg \
@@ -0,0 +1,7 @@
+#include "FreeRTOS.h"
+
+/* demo-freertos.syscfg turns on configUSE_TICK_HOOK for the IsrLatency
+ * test, which brings its own hook; the other tests link this one. */
+__attribute__((weak)) void vApplicationTickHook(void)
+{
+}
@@ -1,5 +1,11 @@
 #!/bin/bash
 
+# AEAgle.py passes a cached image when the inputs have not changed; west
+# flash needs a build directory, so program it with OpenOCD directly.
+if [ -n "${AEAGLE_IMAGE:-}" ]; then
+  exec openocd -f board/ti_cc13x2_launchpad.cfg -c "program $AEAGLE_IMAGE verify reset exit"
+fi
+
 source /home/lmg/Desktop/AEAgle/operating-systems/zephyrproject/zephyr/zephyr-env.sh
-west build -b cc1352r1_launchxl . -p
+west build -b cc1352r1_launchxl . -p ${AEAGLE_MULTI:+-- -DEXTRA_CONF_FILE=multi.conf}
 west flash
@@ -0,0 +1,10 @@
+#!/usr/bin/env bash
+
+# Build the test as a Linux process (BOARD=native); AEAgle.py runs
+# bin/native/demo-riot.elf and reads its stdout.
+
+set -euo pipefail
+
+# The Makefile picks the allocator from AEAGLE_SUITE.
+make clean BOARD=native
+make all BOARD=native
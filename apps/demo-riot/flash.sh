@@ -2,13 +2,19 @@
 
 set -euo pipefail
 
-
-make clean BOARD=cc1352-launchpad
-
 export OPENOCD_SCRIPTS=/usr/share/openocd/scripts
 export PROGRAMMER=openocd
 export OPENOCD_CONFIG=board/ti_cc13x2_launchpad.cfg
 
+# AEAgle.py passes a cached image when the inputs have not changed.
+if [ -n "${AEAGLE_IMAGE:-}" ]; then
+  /home/lmg/ti/uniflash_9.1.0/dslite.sh -c CC1352R1F3.ccxml -a Erase
+  exec make flash-only BOARD=cc1352-launchpad FLASHFILE="$AEAGLE_IMAGE"
+fi
+
+
+make clean BOARD=cc1352-launchpad
+
 /home/lmg/ti/uniflash_9.1.0/dslite.sh -c CC1352R1F3.ccxml -a Erase
 
 make all flash BOARD=cc1352-launchpad
@@ -0,0 +1,6 @@
+#!/bin/bash
+
+# Build for native_sim; AEAgle.py runs build-native/zephyr/zephyr.exe and
+# reads its stdout.
+source "${ZEPHYR_BASE:-/home/lmg/Desktop/AEAgle/operating-systems/zephyrproject/zephyr}/zephyr-env.sh"
+west build -b native_sim . -d build-native -p
@@ -0,0 +1,5 @@
+#!/bin/bash
+
+# Build for QEMU's mps2-an385 (Cortex-M3, 4 MiB RAM); AEAgle.py runs the ELF.
+source "${ZEPHYR_BASE:-/home/lmg/Desktop/AEAgle/operating-systems/zephyrproject/zephyr}/zephyr-env.sh"
+west build -b mps2/an385 . -d build-qemu -p ${AEAGLE_MULTI:+-- -DEXTRA_CONF_FILE=multi.conf}
@@ -0,0 +1,64 @@
+#include "contiki.h"
+#include "dev/serial-line.h"
+#include <stdio.h>
+#include <string.h>
+#ifdef CONTIKI_TARGET_SIMPLELINK
+#include "uart0-arch.h"
+#endif
+#include "aeagle_tests.h"
+
+/*
+ * Multi-test image for the contiki-memb and contiki-heapmem suites.
+ * AEAgle.py wraps every test so its AUTOSTART_PROCESSES() list becomes
+ * aeagle_autostart_<Name>[] and generates aeagle_tests.h with the list.
+ * The dispatcher waits for one serial line naming the test and starts that
+ * test's processes.
+ */
+
+#define AEAGLE_TEST(name) extern struct process *const aeagle_autostart_##name[];
+AEAGLE_TESTS
+#undef AEAGLE_TEST
+
+static const struct
+{
+  const char *name;
+  struct process *const *processes;
+} tests[] = {
+#define AEAGLE_TEST(name) {#name, aeagle_autostart_##name},
+    AEAGLE_TESTS
+#undef AEAGLE_TEST
+};
+
+PROCESS(aeagle_dispatch, "AEAgle dispatcher");
+AUTOSTART_PROCESSES(&aeagle_dispatch);
+
+PROCESS_THREAD(aeagle_dispatch, ev, data)
+{
+  static size_t i;
+
+  PROCESS_BEGIN();
+
+#ifdef CONTIKI_TARGET_SIMPLELINK
+  /* The simplelink platform leaves UART input unrouted by default. */
+  serial_line_init();
+  uart0_set_callback(serial_line_input_byte);
+#endif
+
+  printf("# %s ready\r\n", AEAGLE_SUITE_NAME);
+  PROCESS_WAIT_EVENT_UNTIL(ev == serial_line_event_message);
+
+  for (i = 0; i < sizeof(tests) / sizeof(tests[0]); ++i)
+  {
+    if (strcmp((const char *)data, tests[i].name) == 0)
+    {
+      for (struct process *const *p = tests[i].processes; *p != NULL; ++p)
+      {
+        process_start(*p, NULL);
+      }
+      PROCESS_EXIT();
+    }
+  }
+  printf("# unknown test %s\r\n", (const char *)data);
+
+  PROCESS_END();
+}
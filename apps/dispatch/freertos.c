@@ -0,0 +1,95 @@
+#include "FreeRTOS.h"
+#include "task.h"
+#include "ti_drivers_config.h"
+#include <stdio.h>
+#include <string.h>
+#include <ti/drivers/Board.h>
+#include <ti/drivers/UART2.h>
+#include "aeagle_tests.h"
+
+/*
+ * Multi-test image for tests/freertos. AEAgle.py wraps every test so its
+ * main() becomes aeagle_test_<Name>() and generates aeagle_tests.h with the
+ * list. The dispatcher task reads one test name from the UART, starts that
+ * test's task and suspends itself; the runner resets the target between
+ * tests.
+ */
+
+#define AEAGLE_TEST(name) extern int aeagle_test_##name(void);
+AEAGLE_TESTS
+#undef AEAGLE_TEST
+
+static const struct
+{
+  const char *name;
+  int (*run)(void);
+} tests[] = {
+#define AEAGLE_TEST(name) {#name, aeagle_test_##name},
+    AEAGLE_TESTS
+#undef AEAGLE_TEST
+};
+
+static void uart_puts(UART2_Handle uart, const char *s)
+{
+  UART2_write(uart, s, strlen(s), NULL);
+}
+
+static void DispatchTask(void *pvParameters)
+{
+  (void)pvParameters;
+  UART2_Params params;
+  char line[64];
+  size_t len = 0;
+
+  UART2_Params_init(&params);
+  params.baudRate = 115200;
+  UART2_Handle uart = UART2_open(CONFIG_UART2_0, &params);
+  if (uart == NULL)
+  {
+    for (;;)
+      ;
+  }
+
+  uart_puts(uart, "# " AEAGLE_SUITE_NAME " ready\r\n");
+  while (len < sizeof(line) - 1)
+  {
+    char c;
+    if (UART2_read(uart, &c, 1, NULL) != UART2_STATUS_SUCCESS || c == '\n')
+    {
+      break;
+    }
+    if (c != '\r')
+    {
+      line[len++] = c;
+    }
+  }
+  line[len] = '\0';
+
+  for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); ++i)
+  {
+    if (strcmp(line, tests[i].name) == 0)
+    {
+      /* The test opens the UART itself. */
+      UART2_close(uart);
+      tests[i].run();
+      vTaskSuspend(NULL);
+    }
+  }
+  uart_puts(uart, "# unknown test\r\n");
+  vTaskSuspend(NULL);
+}
+
+int main(void)
+{
+  Board_init();
+
+  /* Above the tests' priority 1, so a test task only runs once the
+   * dispatcher has suspended. */
+  xTaskCreate(DispatchTask, "dispatch", 512, NULL, 2, NULL);
+
+  vTaskStartScheduler();
+
+  for (;;)
+    ;
+  return 0;
+}
@@ -0,0 +1,48 @@
+#include <stdio.h>
+#include <string.h>
+#include "aeagle_tests.h"
+
+/*
+ * Multi-test image for the riot-tlsf and riot-mema suites. AEAgle.py wraps
+ * every test so its main() becomes aeagle_test_<Name>() and generates
+ * aeagle_tests.h with the list. The test name is read from stdio.
+ */
+
+#define AEAGLE_TEST(name) extern int aeagle_test_##name(void);
+AEAGLE_TESTS
+#undef AEAGLE_TEST
+
+static const struct
+{
+       const char *name;
+       int (*run)(void);
+} tests[] = {
+#define AEAGLE_TEST(name) {#name, aeagle_test_##name},
+       AEAGLE_TESTS
+#undef AEAGLE_TEST
+};
+
+int main(void)
+{
+       char line[64];
+
+       printf("# %s ready\r\n", AEAGLE_SUITE_NAME);
+       fflush(stdout);
+
+       if (fgets(line, sizeof(line), stdin) == NULL)
+       {
+              return 1;
+       }
+       line[strcspn(line, "\r\n")] = '\0';
+
+       for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); ++i)
+       {
+              if (strcmp(line, tests[i].name) == 0)
+              {
+                     return tests[i].run();
+              }
+       }
+       printf("# unknown test %s\r\n", line);
+       fflush(stdout);
+       return 1;
+}
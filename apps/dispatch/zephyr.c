@@ -0,0 +1,60 @@
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#ifdef CONFIG_ARCH_POSIX
+#include "cmdline.h"
+#else
+#include <zephyr/console/console.h>
+#endif
+#include "aeagle_tests.h"
+
+/*
+ * Multi-test image for the zephyr, newlib and newlib-nano suites. AEAgle.py
+ * wraps every test so its main() becomes aeagle_test_<Name>() and generates
+ * aeagle_tests.h with the list. The test name comes from the console
+ * (CONFIG_CONSOLE_GETLINE, see multi.conf) or, on native_sim, from
+ * --testargs <Name>.
+ */
+
+#define AEAGLE_TEST(name) extern int aeagle_test_##name(void);
+AEAGLE_TESTS
+#undef AEAGLE_TEST
+
+static const struct
+{
+  const char *name;
+  int (*run)(void);
+} tests[] = {
+#define AEAGLE_TEST(name) {#name, aeagle_test_##name},
+    AEAGLE_TESTS
+#undef AEAGLE_TEST
+};
+
+static const char *read_test_name(void)
+{
+#ifdef CONFIG_ARCH_POSIX
+  int argc;
+  char **argv;
+  native_get_test_cmd_line_args(&argc, &argv);
+  return argc > 0 ? argv[0] : "";
+#else
+  console_getline_init();
+  return console_getline();
+#endif
+}
+
+int main(void)
+{
+  printk("# %s ready\n", AEAGLE_SUITE_NAME);
+
+  const char *name = read_test_name();
+  for (size_t i = 0; i < ARRAY_SIZE(tests); ++i)
+  {
+    if (strcmp(name, tests[i].name) == 0)
+    {
+      return tests[i].run();
+    }
+  }
+  printk("# unknown test %s\n", name);
+  return 0;
+}
@@ -0,0 +1,6 @@
+#ifndef TI_DRIVERS_BOARD_H_
+#define TI_DRIVERS_BOARD_H_
+
+void Board_init(void);
+
+#endif /* TI_DRIVERS_BOARD_H_ */
@@ -0,0 +1,29 @@
+#ifndef TI_DRIVERS_UART2_H_
+#define TI_DRIVERS_UART2_H_
+
+/*
+ * The subset of the SimpleLink UART2 driver API used by tests/freertos.
+ * Writes are blocking; there is a single console instance.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define UART2_STATUS_SUCCESS ((int_fast16_t)0)
+#define UART2_STATUS_EINUSE ((int_fast16_t)-3)
+
+typedef struct UART2_Config_ *UART2_Handle;
+
+typedef struct
+{
+  uint32_t baudRate;
+} UART2_Params;
+
+void UART2_Params_init(UART2_Params *params);
+UART2_Handle UART2_open(uint_least8_t index, UART2_Params *params);
+void UART2_close(UART2_Handle handle);
+int_fast16_t UART2_write(UART2_Handle handle, const void *buffer, size_t size, size_t *bytesWritten);
+int_fast16_t UART2_read(UART2_Handle handle, void *buffer, size_t size, size_t *bytesRead);
+
+#endif /* TI_DRIVERS_UART2_H_ */
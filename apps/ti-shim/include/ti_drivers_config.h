@@ -0,0 +1,12 @@
+#ifndef TI_DRIVERS_CONFIG_H_
+#define TI_DRIVERS_CONFIG_H_
+
+/*
+ * Stand-in for the SysConfig-generated header, so tests/freertos/*.c build
+ * unchanged on ports without the SimpleLink SDK. The including app provides
+ * the UART2 implementation for its console.
+ */
+
+#define CONFIG_UART2_0 0
+
+#endif /* TI_DRIVERS_CONFIG_H_ */
@@ -0,0 +1,35 @@
+#ifndef AEAGLE_ALLOC_H_
+#define AEAGLE_ALLOC_H_
+
+#include <stddef.h>
+
+/*
+ * Allocator interface of the host engine. Every suite in AEAgle.py's _OS_MAP
+ * is compiled from its upstream sources into one adapter that exports a
+ * single `aeagle_allocator` instance; the workloads only ever talk to it.
+ */
+
+struct aeagle_heap_stats
+{
+  size_t free_bytes;
+  size_t allocated_bytes;
+  size_t max_allocated_bytes;
+};
+
+struct aeagle_allocator
+{
+  const char *name;
+  /* Non-zero for fixed-block pools (memb, memarray): every block has this
+   * size and larger requests fail. Zero for general-purpose heaps. */
+  size_t block_size;
+  size_t heap_size;
+  void (*init)(void);
+  void *(*alloc)(size_t size);
+  /* Returns 0 on success, non-zero if the allocator rejected the pointer. */
+  int (*free)(void *ptr);
+  void (*stats)(struct aeagle_heap_stats *st);
+};
+
+extern const struct aeagle_allocator aeagle_allocator;
+
+#endif /* AEAGLE_ALLOC_H_ */
@@ -0,0 +1,160 @@
+#ifndef AEAGLE_PERF_H_
+#define AEAGLE_PERF_H_
+
+/*
+ * Hardware counters around every timed malloc/free of the host engine, built
+ * with -DAEAGLE_PERF (AEAgle.py -D AEAGLE_PERF). Latency alone does not say
+ * whether an allocator is faster because it runs fewer instructions or
+ * because its walk stays in cache; these columns do.
+ *
+ * The four events form one perf_event_open() group on the calling thread,
+ * user space only. aeagle_perf_begin() resets and starts the group right
+ * before t_in, aeagle_perf_end() stops it right after t_out and reads the
+ * values, so the ioctls sit outside the timed region and the counts cover
+ * the call plus the two timer reads. Each TIME line of a counted call then
+ * ends in four more columns, named once by META,perf_events. A column is
+ * empty if its event could not be opened (common in VMs for the cache
+ * events) or never got onto the PMU. With perf_event_paranoid above 2 or no
+ * PMU at all, every column is empty and a note goes to stderr.
+ */
+
+#ifndef AEAGLE_PERF
+#define AEAGLE_PERF 0
+#endif
+
+#if AEAGLE_PERF
+
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define AEAGLE_PERF_EVENTS 4
+#define AEAGLE_PERF_CACHE(cache, result) \
+  ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | ((result) << 16))
+
+static const struct
+{
+  const char *name;
+  uint32_t type;
+  uint64_t config;
+} aeagle_perf_events[AEAGLE_PERF_EVENTS] = {
+    /* The first one leads the group and must open. */
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {"l1d_read_misses", PERF_TYPE_HW_CACHE,
+     AEAGLE_PERF_CACHE(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {"llc_read_misses", PERF_TYPE_HW_CACHE,
+     AEAGLE_PERF_CACHE(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+};
+
+static int aeagle_perf_fd[AEAGLE_PERF_EVENTS] = {-1, -1, -1, -1};
+/* Counts of the last call; -1 where not counted. */
+static long long aeagle_perf_last[AEAGLE_PERF_EVENTS] = {-1, -1, -1, -1};
+
+static inline int aeagle_perf_open(unsigned i, int group_fd)
+{
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = aeagle_perf_events[i].type;
+  attr.config = aeagle_perf_events[i].config;
+  attr.disabled = group_fd < 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+/* Opens the group and writes META,perf_events. Call once per run, from the
+ * file that times the calls: the descriptors are per translation unit. */
+static inline void aeagle_perf_init(void)
+{
+  aeagle_perf_fd[0] = aeagle_perf_open(0, -1);
+  if (aeagle_perf_fd[0] < 0)
+  {
+    perror("aeagle-host: perf_event_open");
+  }
+  else
+  {
+    for (unsigned i = 1; i < AEAGLE_PERF_EVENTS; i++)
+    {
+      aeagle_perf_fd[i] = aeagle_perf_open(i, aeagle_perf_fd[0]);
+    }
+  }
+  if (AEAGLE_LOG_LEVEL >= AEAGLE_LOG_LEVEL_FAULT)
+  {
+    AEAGLE_LOG_PRINTF("META,perf_events,%s,%s,%s,%s" AEAGLE_LOG_EOL, aeagle_perf_events[0].name,
+                      aeagle_perf_events[1].name, aeagle_perf_events[2].name, aeagle_perf_events[3].name);
+  }
+}
+
+static inline void aeagle_perf_begin(void)
+{
+  if (aeagle_perf_fd[0] >= 0)
+  {
+    ioctl(aeagle_perf_fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(aeagle_perf_fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+}
+
+static inline void aeagle_perf_end(void)
+{
+  if (aeagle_perf_fd[0] < 0)
+  {
+    return;
+  }
+  ioctl(aeagle_perf_fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  for (unsigned i = 0; i < AEAGLE_PERF_EVENTS; i++)
+  {
+    /* value, time_running */
+    uint64_t buf[2];
+    aeagle_perf_last[i] = -1;
+    if (aeagle_perf_fd[i] >= 0 && read(aeagle_perf_fd[i], buf, sizeof(buf)) == (ssize_t)sizeof(buf) &&
+        buf[1] > 0)
+    {
+      aeagle_perf_last[i] = (long long)buf[0];
+    }
+  }
+}
+
+/* The extra TIME columns of the last counted call, each with its comma. */
+static inline const char *aeagle_perf_columns(void)
+{
+  static char cols[AEAGLE_PERF_EVENTS * 22];
+  size_t len = 0;
+  for (unsigned i = 0; i < AEAGLE_PERF_EVENTS; i++)
+  {
+    if (aeagle_perf_last[i] < 0)
+    {
+      cols[len++] = ',';
+      cols[len] = '\0';
+    }
+    else
+    {
+      len += (size_t)snprintf(cols + len, sizeof(cols) - len, ",%lld", aeagle_perf_last[i]);
+    }
+  }
+  return cols;
+}
+
+#else
+
+static inline void aeagle_perf_init(void)
+{
+}
+
+static inline void aeagle_perf_begin(void)
+{
+}
+
+static inline void aeagle_perf_end(void)
+{
+}
+
+#endif /* AEAGLE_PERF */
+
+#endif /* AEAGLE_PERF_H_ */
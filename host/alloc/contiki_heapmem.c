@@ -0,0 +1,45 @@
+#include "contiki.h"
+#include "lib/heapmem.h"
+#include "aeagle_alloc.h"
+
+static unsigned long max_observed_allocated_bytes_heapmem;
+
+static void heapmem_host_init(void)
+{
+  max_observed_allocated_bytes_heapmem = 0;
+}
+
+static void *heapmem_host_alloc(size_t size)
+{
+  return heapmem_alloc(size);
+}
+
+static int heapmem_host_free(void *ptr)
+{
+  heapmem_free(ptr);
+  return 0;
+}
+
+static void heapmem_host_stats(struct aeagle_heap_stats *st)
+{
+  heapmem_stats_t stats;
+  heapmem_stats(&stats);
+
+  if (stats.allocated > max_observed_allocated_bytes_heapmem)
+  {
+    max_observed_allocated_bytes_heapmem = stats.allocated;
+  }
+  st->free_bytes = stats.available;
+  st->allocated_bytes = stats.allocated;
+  st->max_allocated_bytes = max_observed_allocated_bytes_heapmem;
+}
+
+const struct aeagle_allocator aeagle_allocator = {
+    .name = AEAGLE_SUITE,
+    .block_size = 0,
+    .heap_size = HEAPMEM_CONF_ARENA_SIZE,
+    .init = heapmem_host_init,
+    .alloc = heapmem_host_alloc,
+    .free = heapmem_host_free,
+    .stats = heapmem_host_stats,
+};
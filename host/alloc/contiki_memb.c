@@ -0,0 +1,63 @@
+#include "contiki.h"
+#include "lib/memb.h"
+#include <stdint.h>
+#include "aeagle_alloc.h"
+
+/* Pool geometry of tests/contiki-memb. */
+#define BLOCK_COUNT 256
+#define BLOCK_SIZE 128
+
+struct block
+{
+  uint8_t data[BLOCK_SIZE];
+};
+
+MEMB(test_mem, struct block, BLOCK_COUNT);
+
+static unsigned long max_allocated_bytes_contiki_memb;
+
+static void memb_host_init(void)
+{
+  memb_init(&test_mem);
+  max_allocated_bytes_contiki_memb = 0;
+}
+
+static void *memb_host_alloc(size_t size)
+{
+  if (size > BLOCK_SIZE)
+  {
+    return NULL;
+  }
+  return memb_alloc(&test_mem);
+}
+
+static int memb_host_free(void *ptr)
+{
+  /* memb_free() returns the remaining reference count, or -1 for a pointer
+   * outside the pool. */
+  return memb_free(&test_mem, ptr) == 0 ? 0 : 1;
+}
+
+static void memb_host_stats(struct aeagle_heap_stats *st)
+{
+  unsigned int free_blocks = memb_numfree(&test_mem);
+  unsigned int used_blocks = BLOCK_COUNT - free_blocks;
+
+  st->free_bytes = (size_t)free_blocks * BLOCK_SIZE;
+  st->allocated_bytes = (size_t)used_blocks * BLOCK_SIZE;
+  if (st->allocated_bytes > max_allocated_bytes_contiki_memb)
+  {
+    max_allocated_bytes_contiki_memb = st->allocated_bytes;
+  }
+  st->max_allocated_bytes = max_allocated_bytes_contiki_memb;
+}
+
+const struct aeagle_allocator aeagle_allocator = {
+    .name = AEAGLE_SUITE,
+    .block_size = BLOCK_SIZE,
+    .heap_size = (size_t)BLOCK_COUNT * BLOCK_SIZE,
+    .init = memb_host_init,
+    .alloc = memb_host_alloc,
+    .free = memb_host_free,
+    .stats = memb_host_stats,
+};
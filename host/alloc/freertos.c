@@ -0,0 +1,79 @@
+#include "FreeRTOS.h"
+#include "task.h"
+#include "aeagle_alloc.h"
+
+#ifndef AEAGLE_HEAP_IMPL
+#error "AEAGLE_HEAP_IMPL must select heap_1 .. heap_5"
+#endif
+
+/* heap_N.c brackets every operation with vTaskSuspendAll()/xTaskResumeAll().
+ * Nothing else runs in the host engine, so the scheduler lock is a no-op. */
+void vTaskSuspendAll(void)
+{
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+  return pdFALSE;
+}
+
+#if AEAGLE_HEAP_IMPL == 5
+static uint8_t heap5_region[configTOTAL_HEAP_SIZE];
+#endif
+
+#if AEAGLE_HEAP_IMPL != 3
+static size_t g_min_free_ever = (size_t)-1;
+#endif
+
+static void freertos_init(void)
+{
+#if AEAGLE_HEAP_IMPL == 5
+  const HeapRegion_t regions[] = {
+      {heap5_region, sizeof(heap5_region)},
+      {NULL, 0},
+  };
+  vPortDefineHeapRegions(regions);
+#endif
+}
+
+static void *freertos_alloc(size_t size)
+{
+  return pvPortMalloc(size);
+}
+
+static int freertos_free(void *ptr)
+{
+  vPortFree(ptr);
+  return 0;
+}
+
+static void freertos_stats(struct aeagle_heap_stats *st)
+{
+#if AEAGLE_HEAP_IMPL == 3
+  /* heap_3 forwards to the C library and keeps no statistics. */
+  st->free_bytes = 0;
+  st->allocated_bytes = 0;
+  st->max_allocated_bytes = 0;
+#else
+  size_t free_now = xPortGetFreeHeapSize();
+  size_t total = (size_t)configTOTAL_HEAP_SIZE;
+
+  if (free_now < g_min_free_ever)
+  {
+    g_min_free_ever = free_now;
+  }
+  st->free_bytes = free_now;
+  st->allocated_bytes = total - free_now;
+  st->max_allocated_bytes = total - g_min_free_ever;
+#endif
+}
+
+const struct aeagle_allocator aeagle_allocator = {
+    .name = AEAGLE_SUITE,
+    .block_size = 0,
+    .heap_size = configTOTAL_HEAP_SIZE,
+    .init = freertos_init,
+    .alloc = freertos_alloc,
+    .free = freertos_free,
+    .stats = freertos_stats,
+};
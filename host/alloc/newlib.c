@@ -0,0 +1,107 @@
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "aeagle_alloc.h"
+
+/*
+ * Shared by the newlib and newlib-nano suites: the Makefile links either
+ * mallocr.c or nano-mallocr.c, both compiled with INTERNAL_NEWLIB so they
+ * only export the reentrant _*_r entry points and never clash with the host
+ * C library. The declarations below mirror newlib's own headers, which
+ * cannot be mixed with the host ones in this translation unit.
+ */
+
+struct _reent;
+
+struct newlib_mallinfo
+{
+  size_t arena;
+  size_t ordblks;
+  size_t smblks;
+  size_t hblks;
+  size_t hblkhd;
+  size_t usmblks;
+  size_t fsmblks;
+  size_t uordblks;
+  size_t fordblks;
+  size_t keepcost;
+};
+
+extern void *_malloc_r(struct _reent *r, size_t size);
+extern void _free_r(struct _reent *r, void *ptr);
+extern struct newlib_mallinfo _mallinfo_r(struct _reent *r);
+
+/* Same region Zephyr maps for the newlib heap on the board
+ * (CONFIG_NEWLIB_LIBC_MAX_MAPPED_REGION_SIZE in prj.conf). */
+#define HEAP_SIZE 65536
+
+static uint8_t heap_region[HEAP_SIZE] __attribute__((aligned(8)));
+static size_t heap_brk;
+static size_t max_live_bytes;
+
+/* malloc reports ENOMEM through the reentrancy struct, so it needs a real
+ * one; zeroed storage comfortably larger than struct _reent will do. */
+static uint64_t impure_data[256];
+struct _reent *_impure_ptr = (struct _reent *)impure_data;
+
+void *_sbrk_r(struct _reent *r, ptrdiff_t incr)
+{
+  (void)r;
+  if ((incr > 0 && (size_t)incr > HEAP_SIZE - heap_brk) ||
+      (incr < 0 && (size_t)-incr > heap_brk))
+  {
+    errno = ENOMEM;
+    return (void *)-1;
+  }
+  void *prev = &heap_region[heap_brk];
+  heap_brk += incr;
+  return prev;
+}
+
+void __malloc_lock(struct _reent *r)
+{
+  (void)r;
+}
+
+void __malloc_unlock(struct _reent *r)
+{
+  (void)r;
+}
+
+static void newlib_init(void)
+{
+  max_live_bytes = 0;
+}
+
+static void *newlib_alloc(size_t size)
+{
+  return _malloc_r(_impure_ptr, size);
+}
+
+static int newlib_free(void *ptr)
+{
+  _free_r(_impure_ptr, ptr);
+  return 0;
+}
+
+static void newlib_stats(struct aeagle_heap_stats *st)
+{
+  struct newlib_mallinfo mi = _mallinfo_r(_impure_ptr);
+  if (mi.uordblks > max_live_bytes)
+  {
+    max_live_bytes = mi.uordblks;
+  }
+  st->free_bytes = mi.fordblks;
+  st->allocated_bytes = mi.uordblks;
+  st->max_allocated_bytes = max_live_bytes;
+}
+
+const struct aeagle_allocator aeagle_allocator = {
+    .name = AEAGLE_SUITE,
+    .block_size = 0,
+    .heap_size = HEAP_SIZE,
+    .init = newlib_init,
+    .alloc = newlib_alloc,
+    .free = newlib_free,
+    .stats = newlib_stats,
+};
@@ -0,0 +1,56 @@
+#include <stdint.h>
+#include "memarray.h"
+#include "aeagle_alloc.h"
+
+/* Pool geometry of tests/riot-mema. */
+#define NUM_BLOCKS 256
+#define BLOCK_SIZE 128
+
+static uint8_t pool_data[NUM_BLOCKS * BLOCK_SIZE];
+static memarray_t pool;
+static size_t max_allocated_bytes_mema;
+
+static void mema_init(void)
+{
+  memarray_init(&pool, pool_data, BLOCK_SIZE, NUM_BLOCKS);
+  max_allocated_bytes_mema = 0;
+}
+
+static void *mema_alloc(size_t size)
+{
+  if (size > BLOCK_SIZE)
+  {
+    return NULL;
+  }
+  return memarray_alloc(&pool);
+}
+
+static int mema_free(void *ptr)
+{
+  memarray_free(&pool, ptr);
+  return 0;
+}
+
+static void mema_stats(struct aeagle_heap_stats *st)
+{
+  size_t free_blocks = memarray_available(&pool);
+  size_t used_blocks = NUM_BLOCKS - free_blocks;
+
+  st->free_bytes = free_blocks * BLOCK_SIZE;
+  st->allocated_bytes = used_blocks * BLOCK_SIZE;
+  if (st->allocated_bytes > max_allocated_bytes_mema)
+  {
+    max_allocated_bytes_mema = st->allocated_bytes;
+  }
+  st->max_allocated_bytes = max_allocated_bytes_mema;
+}
+
+const struct aeagle_allocator aeagle_allocator = {
+    .name = AEAGLE_SUITE,
+    .block_size = BLOCK_SIZE,
+    .heap_size = sizeof(pool_data),
+    .init = mema_init,
+    .alloc = mema_alloc,
+    .free = mema_free,
+    .stats = mema_stats,
+};
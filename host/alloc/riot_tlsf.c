@@ -0,0 +1,69 @@
+#include <stdint.h>
+#include "tlsf.h"
+#include "aeagle_alloc.h"
+
+/* RIOT hands TLSF whatever RAM is left after .bss; the host engine uses the
+ * same 64 KiB as the other general-purpose heaps so the numbers compare. */
+#define HEAP_SIZE 65536
+
+static uint8_t pool_mem[HEAP_SIZE] __attribute__((aligned(8)));
+static tlsf_t tlsf;
+static size_t live_bytes;
+static size_t max_live_bytes;
+
+static void tlsf_host_init(void)
+{
+  tlsf = tlsf_create_with_pool(pool_mem, sizeof(pool_mem));
+  live_bytes = 0;
+  max_live_bytes = 0;
+}
+
+static void *tlsf_host_alloc(size_t size)
+{
+  void *p = tlsf_malloc(tlsf, size);
+  if (p != NULL)
+  {
+    live_bytes += tlsf_block_size(p);
+    if (live_bytes > max_live_bytes)
+    {
+      max_live_bytes = live_bytes;
+    }
+  }
+  return p;
+}
+
+static int tlsf_host_free(void *ptr)
+{
+  size_t size = ptr ? tlsf_block_size(ptr) : 0;
+  tlsf_free(tlsf, ptr);
+  live_bytes = size > live_bytes ? 0 : live_bytes - size;
+  return 0;
+}
+
+static void sum_free_blocks(void *ptr, size_t size, int used, void *user)
+{
+  (void)ptr;
+  if (!used)
+  {
+    *(size_t *)user += size;
+  }
+}
+
+static void tlsf_host_stats(struct aeagle_heap_stats *st)
+{
+  size_t free_bytes = 0;
+  tlsf_walk_pool(tlsf_get_pool(tlsf), sum_free_blocks, &free_bytes);
+  st->free_bytes = free_bytes;
+  st->allocated_bytes = live_bytes;
+  st->max_allocated_bytes = max_live_bytes;
+}
+
+const struct aeagle_allocator aeagle_allocator = {
+    .name = AEAGLE_SUITE,
+    .block_size = 0,
+    .heap_size = HEAP_SIZE,
+    .init = tlsf_host_init,
+    .alloc = tlsf_host_alloc,
+    .free = tlsf_host_free,
+    .stats = tlsf_host_stats,
+};
@@ -0,0 +1,45 @@
+#include <zephyr/sys/mem_stats.h>
+#include <zephyr/sys/sys_heap.h>
+#include "aeagle_alloc.h"
+
+/* Same size as K_HEAP_DEFINE(my_heap, 65536) in tests/zephyr. k_heap only
+ * adds a spinlock around sys_heap, which is irrelevant single-threaded. */
+#define HEAP_SIZE 65536
+
+static uint8_t heap_mem[HEAP_SIZE] __attribute__((aligned(8)));
+static struct sys_heap heap;
+
+static void zephyr_init(void)
+{
+  sys_heap_init(&heap, heap_mem, sizeof(heap_mem));
+}
+
+static void *zephyr_alloc(size_t size)
+{
+  return sys_heap_alloc(&heap, size);
+}
+
+static int zephyr_free(void *ptr)
+{
+  sys_heap_free(&heap, ptr);
+  return 0;
+}
+
+static void zephyr_stats(struct aeagle_heap_stats *st)
+{
+  struct sys_memory_stats ms;
+  sys_heap_runtime_stats_get(&heap, &ms);
+  st->free_bytes = ms.free_bytes;
+  st->allocated_bytes = ms.allocated_bytes;
+  st->max_allocated_bytes = ms.max_allocated_bytes;
+}
+
+const struct aeagle_allocator aeagle_allocator = {
+    .name = AEAGLE_SUITE,
+    .block_size = 0,
+    .heap_size = HEAP_SIZE,
+    .init = zephyr_init,
+    .alloc = zephyr_alloc,
+    .free = zephyr_free,
+    .stats = zephyr_stats,
+};
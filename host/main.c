@@ -0,0 +1,87 @@
+#include "aeagle_alloc.h"
+#include "workloads.h"
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static const char *g_crash_code = "GENERAL_CRASH";
+const char *workload_input = NULL;
+
+/* The exploitation workloads may legitimately corrupt the heap. Report the
+ * crash the same way the boards do instead of dying silently; only
+ * async-signal-safe calls are allowed here. */
+static void on_fatal_signal(int sig)
+{
+  static const char prefix[] = "FAULT,0,0xDEAD,";
+  (void)write(STDOUT_FILENO, prefix, sizeof(prefix) - 1);
+  (void)write(STDOUT_FILENO, g_crash_code, strlen(g_crash_code));
+  (void)write(STDOUT_FILENO, "\n", 1);
+  _exit(128 + sig);
+}
+
+static void usage(const char *argv0)
+{
+  fprintf(stderr, "usage: %s <test> [input]|--list\n", argv0);
+  fprintf(stderr, "input: Replay's trace file (- for stdin); default: the built-in trace\n");
+  fprintf(stderr, "       WorstCase's output: the worst sequence found, as a trace\n");
+  fprintf(stderr, "tests:");
+  for (size_t i = 0; i < workload_count; i++)
+  {
+    fprintf(stderr, " %s", workloads[i].name);
+  }
+  fprintf(stderr, "\n");
+}
+
+int main(int argc, char **argv)
+{
+  const struct workload *w = NULL;
+
+  if (argc != 2 && argc != 3)
+  {
+    usage(argv[0]);
+    return 2;
+  }
+  if (strcmp(argv[1], "--list") == 0)
+  {
+    for (size_t i = 0; i < workload_count; i++)
+    {
+      printf("%s\n", workloads[i].name);
+    }
+    return 0;
+  }
+  for (size_t i = 0; i < workload_count; i++)
+  {
+    if (strcmp(argv[1], workloads[i].name) == 0)
+    {
+      w = &workloads[i];
+      break;
+    }
+  }
+  if (w == NULL)
+  {
+    usage(argv[0]);
+    return 2;
+  }
+  if (argc == 3)
+  {
+    workload_input = argv[2];
+  }
+
+  /* Line buffering keeps everything up to a crash; the writes happen
+   * outside the timed regions. */
+  setvbuf(stdout, NULL, _IOLBF, 0);
+  g_crash_code = w->crash_code;
+  signal(SIGSEGV, on_fatal_signal);
+  signal(SIGBUS, on_fatal_signal);
+  signal(SIGABRT, on_fatal_signal);
+
+  aeagle_allocator.init();
+
+  AEAGLE_LOG_START(aeagle_allocator.name, w->name);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  w->run();
+  AEAGLE_LOG_END(aeagle_allocator.name, w->name);
+  return 0;
+}
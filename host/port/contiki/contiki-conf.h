@@ -0,0 +1,7 @@
+#ifndef AEAGLE_HOST_CONTIKI_CONF_H_
+#define AEAGLE_HOST_CONTIKI_CONF_H_
+
+/* Same arena as apps/demo-contiki/project-conf.h. */
+#define HEAPMEM_CONF_ARENA_SIZE 57000
+
+#endif /* AEAGLE_HOST_CONTIKI_CONF_H_ */
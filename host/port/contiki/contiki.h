@@ -0,0 +1,14 @@
+#ifndef AEAGLE_HOST_CONTIKI_H_
+#define AEAGLE_HOST_CONTIKI_H_
+
+/*
+ * Stand-in for os/contiki.h: memb.c and heapmem.c only need the project
+ * configuration and the compiler helpers, not the process/timer system.
+ */
+
+#include "contiki-conf.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#endif /* AEAGLE_HOST_CONTIKI_H_ */
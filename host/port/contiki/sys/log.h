@@ -0,0 +1,18 @@
+#ifndef AEAGLE_HOST_CONTIKI_LOG_H_
+#define AEAGLE_HOST_CONTIKI_LOG_H_
+
+/* Contiki's logging is disabled in the board builds (project-conf.h), so
+ * the allocator's diagnostics compile to nothing here as well. */
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DBG 4
+
+#define LOG_ERR(...)
+#define LOG_WARN(...)
+#define LOG_INFO(...)
+#define LOG_DBG(...)
+
+#endif /* AEAGLE_HOST_CONTIKI_LOG_H_ */
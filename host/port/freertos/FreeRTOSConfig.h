@@ -0,0 +1,25 @@
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*
+ * Minimal configuration for compiling portable/MemMang/heap_N.c on the host.
+ * Only the heap is built, so the scheduler settings just need to satisfy
+ * FreeRTOS.h. Heap size matches FreeRTOS.heapSize in demo-freertos.syscfg.
+ */
+
+#define configUSE_PREEMPTION 1
+#define configUSE_IDLE_HOOK 0
+#define configUSE_TICK_HOOK 0
+#define configTICK_RATE_HZ ((TickType_t)1000)
+#define configMAX_PRIORITIES 5
+#define configMINIMAL_STACK_SIZE ((unsigned short)256)
+#define configMAX_TASK_NAME_LEN 16
+#define configUSE_16_BIT_TICKS 0
+#define configTICK_TYPE_WIDTH_IN_BITS TICK_TYPE_WIDTH_32_BITS
+#define configUSE_MUTEXES 0
+#define configUSE_MALLOC_FAILED_HOOK 0
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define configSUPPORT_STATIC_ALLOCATION 0
+#define configTOTAL_HEAP_SIZE ((size_t)0x00010000)
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,16 @@
+#ifndef __NEWLIB_H__
+#define __NEWLIB_H__ 1
+
+/*
+ * newlib.h is generated by newlib's configure step. These are the settings
+ * of the arm-none-eabi multilibs Zephyr links, as far as malloc cares.
+ */
+
+#include "_newlib_version.h"
+
+#define _WANT_IO_C99_FORMATS 1
+#define _MB_LEN_MAX 1
+#define _REENT_CHECK_VERIFY 1
+#define _UNBUF_STREAM_OPT 1
+
+#endif /* __NEWLIB_H__ */
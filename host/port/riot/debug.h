@@ -0,0 +1,10 @@
+#ifndef AEAGLE_HOST_RIOT_DEBUG_H_
+#define AEAGLE_HOST_RIOT_DEBUG_H_
+
+/* RIOT's debug.h depends on the thread layer; memarray.c builds with
+ * ENABLE_DEBUG 0 anyway. */
+
+#define DEBUG(...)
+#define DEBUG_PUTS(str)
+
+#endif /* AEAGLE_HOST_RIOT_DEBUG_H_ */
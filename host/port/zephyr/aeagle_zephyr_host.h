@@ -0,0 +1,14 @@
+#ifndef AEAGLE_ZEPHYR_HOST_H_
+#define AEAGLE_ZEPHYR_HOST_H_
+
+/*
+ * Force-included in place of the generated autoconf.h when lib/heap/heap.c
+ * is compiled for the host engine. Mirrors apps/demo-zephyr/prj.conf.
+ */
+
+#define CONFIG_SYS_HEAP_RUNTIME_STATS 1
+#define CONFIG_SYS_HEAP_INFO 1
+#define CONFIG_SYS_HEAP_ALLOC_LOOPS 3
+#define CONFIG_PRINTK 1
+
+#endif /* AEAGLE_ZEPHYR_HOST_H_ */
@@ -0,0 +1,590 @@
+/*
+ * WorstCase: searches for the alloc/free sequence that makes a single call
+ * as slow as it gets on this allocator, for a WCET estimate where the other
+ * workloads only show typical latencies.
+ *
+ * A candidate is up to AEAGLE_SEARCH_LEN genes, each a malloc of some size
+ * or a free of the k-th live object (oldest first), so every candidate
+ * decodes to a valid sequence. Its score is its slowest call, of either
+ * kind or only AEAGLE_SEARCH_OP's (AEAGLE_REPLAY_MALLOC or _FREE).
+ *
+ * The allocators cannot be reset, so each run happens in a fork()ed child
+ * on the heap exactly as init() left it. The child writes to all of its
+ * private pages before the first call, so no copy-on-write fault lands in a
+ * timed region. A candidate runs AEAGLE_SEARCH_RUNS times and every call
+ * keeps its fastest time: that drops preemption and cache noise, not what
+ * the sequence does to the heap.
+ *
+ * The search is a (mu + lambda) evolution. The AEAGLE_SEARCH_KEEP best
+ * candidates survive each generation and each spawns AEAGLE_SEARCH_SPAWN
+ * mutants, with one to three of: a malloc resized at random, by a few
+ * bytes or to around a power of two; a gene inserted, deleted or turned
+ * into the other kind; a free retargeted; a stretch of genes repeated, to
+ * grow patterns such as a fragmented free list. Sizes come from
+ * RandomSizes' powerlaw distribution seeded with AEAGLE_DIST_SEED, so a run
+ * is reproducible up to timer noise.
+ *
+ * Every AEAGLE_SEARCH_PROGRESS generations the search prints META
+ * search_generation and search_best, so a runner waiting on the console
+ * sees it is alive; it ends after AEAGLE_SEARCH_GENERATIONS or once
+ * AEAGLE_SEARCH_BUDGET_S seconds have passed.
+ *
+ * The winner runs once more and is printed as TIME lines, phase
+ * "worstcase", then META worst_ticks and worst_call (that run's slowest
+ * call and its line) and the search counters. The final run is the one
+ * reported, since a score picked as the maximum of many is biased upwards.
+ * With an input argument the sequence is also written there as a replay
+ * trace (aeagle_replay.h), for Replay or AEAgle.py --trace.
+ */
+
+#include "workloads.h"
+#include "aeagle_alloc.h"
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "aeagle_replay.h"
+#include "aeagle_dist.h"
+
+#ifndef AEAGLE_SEARCH_GENERATIONS
+#define AEAGLE_SEARCH_GENERATIONS 200
+#endif
+
+/* Seconds the search may run; it stops after the generation that crosses
+ * it, or after AEAGLE_SEARCH_GENERATIONS, whichever comes first. */
+#ifndef AEAGLE_SEARCH_BUDGET_S
+#define AEAGLE_SEARCH_BUDGET_S 60
+#endif
+
+/* Generations between progress lines. */
+#ifndef AEAGLE_SEARCH_PROGRESS
+#define AEAGLE_SEARCH_PROGRESS 10
+#endif
+
+#ifndef AEAGLE_SEARCH_KEEP
+#define AEAGLE_SEARCH_KEEP 4
+#endif
+
+#ifndef AEAGLE_SEARCH_SPAWN
+#define AEAGLE_SEARCH_SPAWN 4
+#endif
+
+#ifndef AEAGLE_SEARCH_RUNS
+#define AEAGLE_SEARCH_RUNS 3
+#endif
+
+/* Genes per candidate; a written trace never needs more object slots than
+ * a board's Replay keeps. */
+#ifndef AEAGLE_SEARCH_LEN
+#define AEAGLE_SEARCH_LEN 256
+#endif
+
+/* 0: score mallocs and frees alike. */
+#ifndef AEAGLE_SEARCH_OP
+#define AEAGLE_SEARCH_OP 0
+#endif
+
+#if AEAGLE_SEARCH_KEEP < 1 || AEAGLE_SEARCH_SPAWN < 1 || AEAGLE_SEARCH_RUNS < 1 || AEAGLE_SEARCH_PROGRESS < 1 || \
+    AEAGLE_SEARCH_LEN < 2
+#error "AEAGLE_SEARCH_KEEP, _SPAWN, _RUNS and _PROGRESS must be at least 1, AEAGLE_SEARCH_LEN at least 2"
+#endif
+
+#define SEARCH_POP (AEAGLE_SEARCH_KEEP * (1 + AEAGLE_SEARCH_SPAWN))
+/* Largest stretch one mutation repeats. */
+#define SEARCH_REPEAT 8
+
+/* Per-call results; a free is skipped when its object's malloc failed. */
+enum
+{
+  SEARCH_FAILED,
+  SEARCH_OK,
+  SEARCH_SKIPPED,
+};
+
+struct gene
+{
+  uint8_t op;
+  /* malloc: the size; free: which live object, modulo their count. */
+  uint32_t arg;
+};
+
+struct candidate
+{
+  uint32_t len;
+  struct gene g[AEAGLE_SEARCH_LEN];
+  aeagle_ts_t score;
+};
+
+/* Written by the child, read by the parent once it has exited. */
+struct search_run
+{
+  aeagle_ts_t t_in[AEAGLE_SEARCH_LEN];
+  aeagle_ts_t t_out[AEAGLE_SEARCH_LEN];
+  uint8_t result[AEAGLE_SEARCH_LEN];
+};
+
+static struct candidate pop[SEARCH_POP];
+static struct search_run *shared;
+/* Each call's fastest run of the candidate evaluated last. */
+static struct search_run fastest;
+static struct aeagle_replay_rec recs[AEAGLE_SEARCH_LEN];
+static uint32_t evaluations, crashes;
+
+/* Pools fail anything above their block size, which teaches the search
+ * nothing. */
+static uint32_t draw_size(void)
+{
+  uint32_t size = aeagle_dist_size(AEAGLE_DIST_POWERLAW);
+  if (aeagle_allocator.block_size != 0 && size > aeagle_allocator.block_size)
+  {
+    size = 1 + aeagle_dist_below((uint32_t)aeagle_allocator.block_size);
+  }
+  return size;
+}
+
+static struct gene random_gene(void)
+{
+  if (aeagle_dist_below(100) < 60)
+  {
+    return (struct gene){AEAGLE_REPLAY_MALLOC, draw_size()};
+  }
+  return (struct gene){AEAGLE_REPLAY_FREE, aeagle_dist_below(AEAGLE_SEARCH_LEN)};
+}
+
+static void set_size(struct gene *g, int64_t size)
+{
+  if (aeagle_allocator.block_size != 0 && size > (int64_t)aeagle_allocator.block_size)
+  {
+    size = (int64_t)aeagle_allocator.block_size;
+  }
+  g->arg = size < 1 ? 1 : (uint32_t)size;
+}
+
+static void mutate(struct candidate *c)
+{
+  uint32_t i = c->len ? aeagle_dist_below(c->len) : 0, m;
+  unsigned kind = c->len ? aeagle_dist_below(7) : 3;
+  struct gene *g = &c->g[i];
+
+  switch (kind)
+  {
+  case 0:
+    if (g->op == AEAGLE_REPLAY_MALLOC)
+    {
+      g->arg = draw_size();
+    }
+    else
+    {
+      g->arg = aeagle_dist_below(AEAGLE_SEARCH_LEN);
+    }
+    break;
+  case 1:
+    if (g->op == AEAGLE_REPLAY_MALLOC)
+    {
+      set_size(g, (int64_t)g->arg + (int64_t)aeagle_dist_below(33) - 16);
+    }
+    break;
+  case 2:
+    /* 2^k - 1 to 2^k + 1: where bins and size classes change. */
+    if (g->op == AEAGLE_REPLAY_MALLOC)
+    {
+      set_size(g, ((int64_t)AEAGLE_DIST_MIN << aeagle_dist_below(8)) + aeagle_dist_below(3) - 1);
+    }
+    break;
+  case 3:
+    if (c->len < AEAGLE_SEARCH_LEN)
+    {
+      memmove(&c->g[i + 1], &c->g[i], (c->len - i) * sizeof(c->g[0]));
+      c->g[i] = random_gene();
+      c->len++;
+    }
+    break;
+  case 4:
+    memmove(&c->g[i], &c->g[i + 1], (c->len - i - 1) * sizeof(c->g[0]));
+    c->len--;
+    break;
+  case 5:
+    if (g->op == AEAGLE_REPLAY_MALLOC)
+    {
+      *g = (struct gene){AEAGLE_REPLAY_FREE, aeagle_dist_below(AEAGLE_SEARCH_LEN)};
+    }
+    else
+    {
+      *g = (struct gene){AEAGLE_REPLAY_MALLOC, draw_size()};
+    }
+    break;
+  default:
+    m = 1 + aeagle_dist_below(SEARCH_REPEAT);
+    m = m < c->len - i ? m : c->len - i;
+    m = m < AEAGLE_SEARCH_LEN - c->len ? m : AEAGLE_SEARCH_LEN - c->len;
+    memmove(&c->g[i + 2 * m], &c->g[i + m], (c->len - i - m) * sizeof(c->g[0]));
+    memcpy(&c->g[i + m], &c->g[i], m * sizeof(c->g[0]));
+    c->len += m;
+    break;
+  }
+}
+
+/* The candidate as replay records in recs[]. Slots are reused lowest
+ * first; a malloc with every slot taken and a free with nothing live are
+ * dropped. */
+static uint32_t decode(const struct candidate *c)
+{
+  uint32_t live[AEAGLE_REPLAY_MAX_OBJECTS], nlive = 0, n = 0, k;
+  uint8_t used[AEAGLE_REPLAY_MAX_OBJECTS] = {0};
+
+  for (uint32_t i = 0; i < c->len; i++)
+  {
+    struct aeagle_replay_rec *r = &recs[n];
+    if (c->g[i].op == AEAGLE_REPLAY_FREE)
+    {
+      if (nlive == 0)
+      {
+        continue;
+      }
+      k = c->g[i].arg % nlive;
+      *r = (struct aeagle_replay_rec){AEAGLE_REPLAY_FREE, 0, live[k], 0};
+      used[live[k]] = 0;
+      memmove(&live[k], &live[k + 1], (nlive - k - 1) * sizeof(live[0]));
+      nlive--;
+      n++;
+      continue;
+    }
+    for (k = 0; k < AEAGLE_REPLAY_MAX_OBJECTS && used[k]; k++)
+    {
+    }
+    if (k == AEAGLE_REPLAY_MAX_OBJECTS)
+    {
+      continue;
+    }
+    *r = (struct aeagle_replay_rec){AEAGLE_REPLAY_MALLOC, c->g[i].arg, k, 0};
+    used[k] = 1;
+    live[nlive++] = k;
+    n++;
+  }
+  return n;
+}
+
+/* Makes the stack the allocator will run on resident. */
+static void __attribute__((noinline)) touch_stack(void)
+{
+  volatile char pad[64 * 1024];
+  for (size_t i = 0; i < sizeof(pad); i += 256)
+  {
+    pad[i] = 0;
+  }
+}
+
+/* Writes every page of the private writable mappings, taking the
+ * copy-on-write faults now. The stack is left to touch_stack(). */
+static void touch_pages(void)
+{
+  FILE *maps = fopen("/proc/self/maps", "r");
+  long page = sysconf(_SC_PAGESIZE);
+  unsigned long lo, hi;
+  char line[512], perms[5];
+
+  if (maps == NULL)
+  {
+    return;
+  }
+  while (fgets(line, sizeof(line), maps) != NULL)
+  {
+    if (sscanf(line, "%lx-%lx %4s", &lo, &hi, perms) != 3 || perms[1] != 'w' || perms[3] != 'p' ||
+        strstr(line, "[stack]") != NULL)
+    {
+      continue;
+    }
+    for (unsigned long a = lo; a < hi; a += (unsigned long)page)
+    {
+      volatile char *b = (volatile char *)a;
+      *b = *b;
+    }
+  }
+  fclose(maps);
+  touch_stack();
+}
+
+/* In the child: runs the n records and leaves the times in *shared. */
+static void __attribute__((noreturn)) run_child(uint32_t n)
+{
+  static void *objs[AEAGLE_REPLAY_MAX_OBJECTS];
+  aeagle_ts_t t_in, t_out;
+  void *p;
+  int rc;
+
+  /* main.c's handler would print a FAULT line for the parent's run. */
+  signal(SIGSEGV, SIG_DFL);
+  signal(SIGBUS, SIG_DFL);
+  signal(SIGABRT, SIG_DFL);
+  touch_pages();
+
+  for (uint32_t i = 0; i < n; i++)
+  {
+    if (recs[i].op == AEAGLE_REPLAY_MALLOC)
+    {
+      t_in = aeagle_timer_now();
+      p = aeagle_allocator.alloc(recs[i].size);
+      t_out = aeagle_timer_now();
+      objs[recs[i].id] = p;
+      shared->result[i] = p != NULL ? SEARCH_OK : SEARCH_FAILED;
+    }
+    else if (objs[recs[i].id] == NULL)
+    {
+      t_in = t_out = 0;
+      shared->result[i] = SEARCH_SKIPPED;
+    }
+    else
+    {
+      t_in = aeagle_timer_now();
+      rc = aeagle_allocator.free(objs[recs[i].id]);
+      t_out = aeagle_timer_now();
+      objs[recs[i].id] = NULL;
+      shared->result[i] = rc == 0 ? SEARCH_OK : SEARCH_FAILED;
+    }
+    shared->t_in[i] = t_in;
+    shared->t_out[i] = t_out;
+  }
+  _exit(0);
+}
+
+/* Runs recs[0..n) AEAGLE_SEARCH_RUNS times into `fastest`. 0 if a child
+ * died or could not be started. */
+static int run_all(uint32_t n)
+{
+  int status;
+  pid_t pid;
+
+  for (unsigned run = 0; run < AEAGLE_SEARCH_RUNS; run++)
+  {
+    fflush(stdout);
+    pid = fork();
+    if (pid == 0)
+    {
+      run_child(n);
+    }
+    if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+      if (pid < 0)
+      {
+        perror("fork");
+      }
+      crashes++;
+      return 0;
+    }
+    for (uint32_t i = 0; i < n; i++)
+    {
+      if (run == 0 || shared->t_out[i] - shared->t_in[i] < fastest.t_out[i] - fastest.t_in[i])
+      {
+        fastest.t_in[i] = shared->t_in[i];
+        fastest.t_out[i] = shared->t_out[i];
+        fastest.result[i] = shared->result[i];
+      }
+    }
+  }
+  return 1;
+}
+
+/* The slowest scored call of `fastest`, its record in *at. */
+static aeagle_ts_t slowest(uint32_t n, uint32_t *at)
+{
+  aeagle_ts_t worst = 0, len;
+
+  *at = 0;
+  for (uint32_t i = 0; i < n; i++)
+  {
+    len = fastest.t_out[i] - fastest.t_in[i];
+    if (fastest.result[i] != SEARCH_SKIPPED && (AEAGLE_SEARCH_OP == 0 || recs[i].op == AEAGLE_SEARCH_OP) &&
+        len > worst)
+    {
+      worst = len;
+      *at = i;
+    }
+  }
+  return worst;
+}
+
+static void evaluate(struct candidate *c)
+{
+  uint32_t n = decode(c), at;
+
+  evaluations++;
+  c->score = run_all(n) ? slowest(n, &at) : 0;
+}
+
+/* Highest score first. */
+static int by_score(const void *a, const void *b)
+{
+  aeagle_ts_t x = ((const struct candidate *)a)->score;
+  aeagle_ts_t y = ((const struct candidate *)b)->score;
+  return (x < y) - (x > y);
+}
+
+static void put_varint(FILE *f, uint32_t v)
+{
+  while (v >= 0x80)
+  {
+    fputc((int)(v & 0x7F) | 0x80, f);
+    v >>= 7;
+  }
+  fputc((int)v, f);
+}
+
+static void write_trace(const char *path, uint32_t n)
+{
+  FILE *f = fopen(path, "wb");
+  uint32_t objects = 1;
+
+  if (f == NULL)
+  {
+    perror(path);
+    return;
+  }
+  for (uint32_t i = 0; i < n; i++)
+  {
+    objects = recs[i].id + 1 > objects ? recs[i].id + 1 : objects;
+  }
+  fwrite("AETR", 1, 4, f);
+  put_varint(f, AEAGLE_REPLAY_VERSION);
+  put_varint(f, objects);
+  for (uint32_t i = 0; i < n; i++)
+  {
+    fputc(recs[i].op, f);
+    if (recs[i].op == AEAGLE_REPLAY_MALLOC)
+    {
+      put_varint(f, recs[i].size);
+    }
+    put_varint(f, recs[i].id);
+    put_varint(f, recs[i].dt);
+  }
+  fputc(AEAGLE_REPLAY_END, f);
+  if (fclose(f) != 0)
+  {
+    perror(path);
+  }
+}
+
+/* Monotonic wall clock for the budget; aeagle_timer_hz() is only
+ * calibrated in the translation unit that ran aeagle_timer_init(). */
+static uint64_t search_ms(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+void WorstCaseTest(void)
+{
+  static const char *const ops[3] = {"", "malloc", "free"};
+  static uint32_t obj_size[AEAGLE_REPLAY_MAX_OBJECTS];
+  aeagle_ts_t best = 0, worst;
+  uint64_t deadline = search_ms() + 1000ull * AEAGLE_SEARCH_BUDGET_S;
+  unsigned gen;
+  uint32_t improved = 0, n, at, worst_line = 0, line = 0, ac = 0, fc = 0;
+  const char *result;
+
+  shared = mmap(NULL, sizeof(*shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (shared == MAP_FAILED)
+  {
+    perror("mmap");
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "SEARCH_SETUP");
+    return;
+  }
+  aeagle_dist_begin(AEAGLE_DIST_POWERLAW);
+
+  for (unsigned i = 0; i < SEARCH_POP; i++)
+  {
+    pop[i].len = AEAGLE_SEARCH_LEN / 2;
+    for (uint32_t j = 0; j < pop[i].len; j++)
+    {
+      pop[i].g[j] = random_gene();
+    }
+    evaluate(&pop[i]);
+  }
+  qsort(pop, SEARCH_POP, sizeof(pop[0]), by_score);
+
+  for (gen = 0; gen < AEAGLE_SEARCH_GENERATIONS; gen++)
+  {
+    for (unsigned k = 0; k < AEAGLE_SEARCH_KEEP; k++)
+    {
+      for (unsigned s = 0; s < AEAGLE_SEARCH_SPAWN; s++)
+      {
+        struct candidate *c = &pop[AEAGLE_SEARCH_KEEP + k * AEAGLE_SEARCH_SPAWN + s];
+        *c = pop[k];
+        for (unsigned m = 1 + aeagle_dist_below(3); m > 0; m--)
+        {
+          mutate(c);
+        }
+        evaluate(c);
+      }
+    }
+    qsort(pop, SEARCH_POP, sizeof(pop[0]), by_score);
+    if (pop[0].score > best)
+    {
+      best = pop[0].score;
+      improved++;
+    }
+    if ((gen + 1) % AEAGLE_SEARCH_PROGRESS == 0)
+    {
+      AEAGLE_LOG_META_VALUE("search_generation", gen + 1);
+      AEAGLE_LOG_META_VALUE("search_best", best);
+    }
+    if (search_ms() >= deadline)
+    {
+      gen++;
+      break;
+    }
+  }
+
+  n = decode(&pop[0]);
+  if (!run_all(n))
+  {
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "SEARCH_CRASH");
+    return;
+  }
+  worst = slowest(n, &at);
+  for (uint32_t i = 0; i < n; i++)
+  {
+    if (fastest.result[i] == SEARCH_SKIPPED)
+    {
+      continue;
+    }
+    if (recs[i].op == AEAGLE_REPLAY_MALLOC)
+    {
+      obj_size[recs[i].id] = recs[i].size;
+    }
+    if (i == at)
+    {
+      worst_line = line;
+    }
+    line++;
+    if (fastest.result[i] == SEARCH_OK)
+    {
+      ac += recs[i].op == AEAGLE_REPLAY_MALLOC;
+      fc += recs[i].op == AEAGLE_REPLAY_FREE;
+      result = "OK";
+    }
+    else
+    {
+      result = recs[i].op == AEAGLE_REPLAY_MALLOC ? "NULL" : "ERR_FREE";
+    }
+    AEAGLE_LOG_TIME("worstcase", ops[recs[i].op], obj_size[recs[i].id], fastest.t_in[i], fastest.t_out[i], result, ac, fc);
+  }
+  AEAGLE_LOG_META_VALUE("worst_ticks", worst);
+  AEAGLE_LOG_META_VALUE("worst_call", worst_line);
+  AEAGLE_LOG_META_VALUE("search_generations", gen);
+  AEAGLE_LOG_META_VALUE("search_evaluations", evaluations);
+  AEAGLE_LOG_META_VALUE("search_improvements", improved);
+  AEAGLE_LOG_META_VALUE("search_crashes", crashes);
+  AEAGLE_LOG_META_VALUE("search_seed", AEAGLE_DIST_SEED);
+
+  if (workload_input != NULL)
+  {
+    write_trace(workload_input, n);
+  }
+  munmap(shared, sizeof(*shared));
+}
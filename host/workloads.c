@@ -0,0 +1,596 @@
+#include "workloads.h"
+#include "aeagle_alloc.h"
+#include <stdbool.h>
+#include <string.h>
+
+/* A streamed Replay trace is one phase, so hold as many calls as it may
+ * name objects; anything beyond is reported as META trace_dropped. */
+#ifndef AEAGLE_TRACE_CAPACITY
+#define AEAGLE_TRACE_CAPACITY 65536
+#endif
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
+#include "aeagle_perf.h"
+/* Host traces may name many more objects than a board keeps. */
+#define AEAGLE_REPLAY_MAX_OBJECTS 65536
+#include "aeagle_replay.h"
+#include "aeagle_dist.h"
+
+#define PIN_COUNT 5
+#define BURST_ROUNDS 10
+#define BURST_COUNT 10
+#define LEAK_MAX_BLOCKS 65536
+
+static uint32_t alloc_cnt = 0;
+static uint32_t free_cnt = 0;
+/* LeakExhaust and MixedLifetime buffer their TIME lines and write them out
+ * between phases, sampled per AEAGLE_LOG_TIME_EVERY. The other workloads
+ * corrupt the heap on purpose and may die inside the allocator, so they print
+ * each line as they go. */
+static bool defer_time = false;
+
+/* Calls bracketed by aeagle_perf_begin/end; AEAGLE_PERF builds write their
+ * TIME lines directly, with the counter columns appended, since the trace
+ * ring has no room for them. The counters stop before the write. */
+static void emit_time(const char *phase, const char *op, size_t size, aeagle_ts_t t_in, aeagle_ts_t t_out,
+                      const char *result)
+{
+#if AEAGLE_PERF && AEAGLE_LOG_LEVEL >= AEAGLE_LOG_LEVEL_TIME
+  aeagle_trace_drain();
+  AEAGLE_LOG_PRINTF(AEAGLE_LOG_TIME_FMT "%s" AEAGLE_LOG_EOL, phase, op, (unsigned long)size, t_in, t_out, result,
+                    (unsigned long)alloc_cnt, (unsigned long)free_cnt, aeagle_perf_columns());
+#else
+  if (defer_time)
+  {
+    AEAGLE_LOG_TIME_DEFERRED(phase, op, size, t_in, t_out, result, alloc_cnt, free_cnt);
+  }
+  else
+  {
+    AEAGLE_LOG_TIME(phase, op, size, t_in, t_out, result, alloc_cnt, free_cnt);
+  }
+#endif
+}
+
+static void emit_snapshot(const char *phase)
+{
+  aeagle_trace_drain();
+  if (AEAGLE_HEAPSTAT_CHECK)
+  {
+    struct aeagle_heap_stats st;
+    aeagle_allocator.stats(&st);
+    AEAGLE_LOG_HEAP(phase, st.free_bytes, st.allocated_bytes, st.max_allocated_bytes);
+  }
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+static void *timed_alloc(const char *phase, size_t size, aeagle_ts_t *t_in, aeagle_ts_t *t_out)
+{
+  void *p;
+  aeagle_perf_begin();
+  *t_in = aeagle_timer_now();
+  p = aeagle_allocator.alloc(size);
+  *t_out = aeagle_timer_now();
+  aeagle_perf_end();
+  if (p == NULL)
+  {
+    emit_time(phase, "malloc", size, *t_in, *t_out, "NULL");
+    aeagle_trace_drain();
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
+    return NULL;
+  }
+  alloc_cnt++;
+  aeagle_heapstat_alloc(size);
+  if (!defer_time || AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+  {
+    emit_time(phase, "malloc", size, *t_in, *t_out, "OK");
+  }
+  return p;
+}
+
+static void timed_free(const char *phase, void *p, size_t size)
+{
+  aeagle_ts_t t_in, t_out;
+  int rc;
+  aeagle_perf_begin();
+  t_in = aeagle_timer_now();
+  rc = aeagle_allocator.free(p);
+  t_out = aeagle_timer_now();
+  aeagle_perf_end();
+  if (rc == 0)
+  {
+    free_cnt++;
+    aeagle_heapstat_free(size);
+    if (!defer_time || AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+    {
+      emit_time(phase, "free", size, t_in, t_out, "OK");
+    }
+  }
+  else
+  {
+    emit_time(phase, "free", size, t_in, t_out, "ERR_FREE");
+  }
+}
+
+/* Once per run, before the baseline SNAP. */
+static void begin_workload(void)
+{
+  aeagle_heapstat_init(aeagle_allocator.heap_size);
+  aeagle_perf_init();
+}
+
+/* Pools hand out one fixed block per request, so the "pinned" double-size
+ * blocks of MixedLifetime degrade to single blocks, as in the device tests. */
+static size_t pin_size(void)
+{
+  return aeagle_allocator.block_size ? aeagle_allocator.block_size : BLOCK_SIZE * 2;
+}
+
+static void LeakExhaustTest(void)
+{
+  static void *blocks[LEAK_MAX_BLOCKS];
+  aeagle_ts_t t_in, t_out;
+  uint32_t n = 0;
+
+  defer_time = true;
+  begin_workload();
+  emit_snapshot("baseline");
+
+  while (n < LEAK_MAX_BLOCKS)
+  {
+    void *p = timed_alloc("leakloop", BLOCK_SIZE, &t_in, &t_out);
+    if (p == NULL)
+    {
+      break;
+    }
+    blocks[n++] = p;
+  }
+
+  emit_snapshot("after_leakloop_exhaustion");
+
+  /* Only the fixed pools are cleaned up on the boards; do the same so the
+   * host numbers line up with the device reports. */
+  if (aeagle_allocator.block_size)
+  {
+    for (uint32_t i = 0; i < n; i++)
+    {
+      timed_free("cleanup", blocks[i], BLOCK_SIZE);
+    }
+    if (n > 0)
+    {
+      emit_snapshot("post_cleanup");
+    }
+  }
+  aeagle_trace_finish();
+}
+
+static void MixedLifetimeTest(void)
+{
+  void *pinned[PIN_COUNT] = {NULL};
+  void *buf[BURST_COUNT] = {NULL};
+  char snap_phase_label[64];
+  aeagle_ts_t t_in, t_out;
+  int successfully_pinned = 0;
+  int round, i, j;
+
+  defer_time = true;
+  begin_workload();
+  emit_snapshot("baseline");
+
+  for (i = 0; i < PIN_COUNT; ++i)
+  {
+    pinned[i] = timed_alloc("pin", pin_size(), &t_in, &t_out);
+    if (pinned[i] == NULL)
+    {
+      goto cleanup_logic;
+    }
+    successfully_pinned++;
+  }
+  emit_snapshot("after_pins");
+
+  for (round = 1; round <= BURST_ROUNDS; ++round)
+  {
+    int current_burst_successful_allocs = 0;
+    for (i = 0; i < BURST_COUNT; ++i)
+    {
+      buf[i] = timed_alloc("burst", BLOCK_SIZE, &t_in, &t_out);
+      if (buf[i] == NULL)
+      {
+        goto cleanup_logic;
+      }
+      current_burst_successful_allocs++;
+    }
+    snprintf(snap_phase_label, sizeof(snap_phase_label), "after_burst_alloc_%02d", round);
+    emit_snapshot(snap_phase_label);
+
+    for (j = current_burst_successful_allocs - 1; j >= 0; --j)
+    {
+      timed_free("burst", buf[j], BLOCK_SIZE);
+      buf[j] = NULL;
+    }
+    snprintf(snap_phase_label, sizeof(snap_phase_label), "after_burst_free_%02d", round);
+    emit_snapshot(snap_phase_label);
+  }
+
+cleanup_logic:
+  for (i = 0; i < successfully_pinned; ++i)
+  {
+    if (pinned[i] != NULL)
+    {
+      timed_free("cleanup", pinned[i], pin_size());
+      pinned[i] = NULL;
+    }
+  }
+  emit_snapshot("post_cleanup");
+  aeagle_trace_finish();
+}
+
+static void DoubleFreeTest(void)
+{
+  aeagle_ts_t t_in, t_out;
+  void *p;
+
+  begin_workload();
+  emit_snapshot("baseline");
+
+  p = timed_alloc("setup", BLOCK_SIZE, &t_in, &t_out);
+  if (p == NULL)
+  {
+    return;
+  }
+  emit_snapshot("after_setup");
+
+  timed_free("setup", p, BLOCK_SIZE);
+  emit_snapshot("after_first_free");
+
+  aeagle_perf_begin();
+  t_in = aeagle_timer_now();
+  aeagle_allocator.free(p);
+  t_out = aeagle_timer_now();
+  aeagle_perf_end();
+  free_cnt++;
+  emit_time("df_trigger", "free", BLOCK_SIZE, t_in, t_out, "DF_ATTEMPT");
+
+  emit_snapshot("post_primitive_trigger");
+}
+
+static void FakeFreeTest(void)
+{
+  const size_t OFFSET = BLOCK_SIZE / 2;
+  aeagle_ts_t t_in, t_out;
+  void *p;
+
+  begin_workload();
+  emit_snapshot("baseline");
+
+  p = timed_alloc("setup", BLOCK_SIZE, &t_in, &t_out);
+  if (p == NULL)
+  {
+    return;
+  }
+  emit_snapshot("after_setup");
+
+  aeagle_perf_begin();
+  t_in = aeagle_timer_now();
+  aeagle_allocator.free((uint8_t *)p + OFFSET);
+  t_out = aeagle_timer_now();
+  aeagle_perf_end();
+  emit_time("ff_trigger", "free", BLOCK_SIZE, t_in, t_out, "FF_ATTEMPT");
+
+  emit_snapshot("post_primitive_trigger");
+
+  timed_free("cleanup", p, BLOCK_SIZE);
+  emit_snapshot("post_cleanup");
+}
+
+static void UseAfterFreeTest(void)
+{
+  aeagle_ts_t t_in, t_out;
+  uint8_t *buf2;
+  void *p1, *p2;
+  bool leaked = false;
+
+  begin_workload();
+  emit_snapshot("baseline");
+
+  p1 = timed_alloc("setup", BLOCK_SIZE, &t_in, &t_out);
+  if (p1 == NULL)
+  {
+    return;
+  }
+  memset(p1, 0x5A, BLOCK_SIZE);
+  emit_snapshot("after_setup");
+
+  timed_free("setup", p1, BLOCK_SIZE);
+  emit_snapshot("after_free1");
+
+  t_in = aeagle_timer_now();
+  memset(p1, 0xA5, BLOCK_SIZE);
+  t_out = aeagle_timer_now();
+  AEAGLE_LOG_TIME("uaf_write", "memset_uaf", BLOCK_SIZE, t_in, t_out, "UAF_WRITE_DONE", alloc_cnt, free_cnt);
+  emit_snapshot("after_uaf_write");
+
+  p2 = timed_alloc("uaf_realloc", BLOCK_SIZE, &t_in, &t_out);
+  if (p2 == NULL)
+  {
+    return;
+  }
+
+  t_in = aeagle_timer_now();
+  buf2 = (uint8_t *)p2;
+  for (unsigned i = 0; i < BLOCK_SIZE; ++i)
+  {
+    if (buf2[i] == 0xA5)
+    {
+      leaked = true;
+      break;
+    }
+  }
+  t_out = aeagle_timer_now();
+
+  if (leaked)
+  {
+    AEAGLE_LOG_TIME("uaf_inspect", "inspect_uaf", BLOCK_SIZE, t_in, t_out, "LEAK_DETECTED", alloc_cnt, free_cnt);
+    AEAGLE_LOG_LEAK(p2);
+  }
+  else
+  {
+    AEAGLE_LOG_TIME("uaf_inspect", "inspect_uaf", BLOCK_SIZE, t_in, t_out, "NO_LEAK_DETECTED", alloc_cnt, free_cnt);
+    AEAGLE_LOG_NOLEAK(p2);
+  }
+  emit_snapshot("post_primitive_realloc");
+
+  timed_free("cleanup", p2, BLOCK_SIZE);
+  emit_snapshot("post_cleanup");
+}
+
+static void HeapOverflowTest(void)
+{
+  aeagle_ts_t t_in, t_out;
+  void *A, *B, *C;
+
+  begin_workload();
+  emit_snapshot("baseline");
+
+  A = timed_alloc("setup", BLOCK_SIZE, &t_in, &t_out);
+  if (A == NULL)
+  {
+    return;
+  }
+  B = timed_alloc("setup", BLOCK_SIZE, &t_in, &t_out);
+  if (B == NULL)
+  {
+    goto cleanup_A_only;
+  }
+  emit_snapshot("after_setup");
+
+  t_in = aeagle_timer_now();
+  memset(A, 0xFF, BLOCK_SIZE + 8);
+  t_out = aeagle_timer_now();
+  AEAGLE_LOG_TIME("hof_write", "memset_overflow", BLOCK_SIZE + 8, t_in, t_out, "HOF_WRITE_DONE", alloc_cnt, free_cnt);
+  emit_snapshot("post_primitive_trigger");
+
+  aeagle_perf_begin();
+  t_in = aeagle_timer_now();
+  C = aeagle_allocator.alloc(BLOCK_SIZE);
+  t_out = aeagle_timer_now();
+  aeagle_perf_end();
+  if (C == NULL)
+  {
+    emit_time("hof_check_alloc", "malloc", BLOCK_SIZE, t_in, t_out, "NULL");
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
+  }
+  else
+  {
+    alloc_cnt++;
+    aeagle_heapstat_alloc(BLOCK_SIZE);
+    emit_time("hof_check_alloc", "malloc", BLOCK_SIZE, t_in, t_out, "OK");
+    timed_free("cleanup", C, BLOCK_SIZE);
+  }
+  emit_snapshot("after_hof_check_alloc");
+
+  timed_free("cleanup", B, BLOCK_SIZE);
+
+cleanup_A_only:
+  timed_free("cleanup", A, BLOCK_SIZE);
+  emit_snapshot("post_cleanup");
+}
+
+static FILE *replay_file;
+
+static size_t replay_refill(struct aeagle_replay *r)
+{
+  static uint8_t chunk[4096];
+  r->buf = chunk;
+  return fread(chunk, 1, sizeof(chunk), replay_file);
+}
+
+/* Streams the trace named on the command line ("-" for stdin), or replays
+ * the one compiled in from include/. Unlike timed_alloc, a NULL is not the
+ * end of the run: the trace goes on, and frees of the slot are skipped. */
+static void ReplayTest(void)
+{
+  static void *objs[AEAGLE_REPLAY_MAX_OBJECTS];
+  static uint32_t obj_size[AEAGLE_REPLAY_MAX_OBJECTS];
+  struct aeagle_replay r;
+  struct aeagle_replay_rec rec;
+  aeagle_ts_t t_in, t_out;
+  uint32_t skipped = 0;
+  int rc;
+  void *p;
+
+  defer_time = true;
+  begin_workload();
+  emit_snapshot("baseline");
+
+  if (workload_input == NULL)
+  {
+    rc = aeagle_replay_open(&r, aeagle_replay_trace, sizeof(aeagle_replay_trace), NULL, AEAGLE_REPLAY_MAX_OBJECTS);
+  }
+  else
+  {
+    replay_file = strcmp(workload_input, "-") == 0 ? stdin : fopen(workload_input, "rb");
+    if (replay_file == NULL)
+    {
+      perror(workload_input);
+      rc = -1;
+    }
+    else
+    {
+      rc = aeagle_replay_open(&r, NULL, 0, replay_refill, AEAGLE_REPLAY_MAX_OBJECTS);
+    }
+  }
+  if (rc != 0)
+  {
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "REPLAY_TRACE");
+    return;
+  }
+
+  while ((rc = aeagle_replay_next(&r, &rec)) > 0)
+  {
+    if (rec.op == AEAGLE_REPLAY_FREE)
+    {
+      if (objs[rec.id] == NULL)
+      {
+        skipped++;
+        continue;
+      }
+      timed_free("replay", objs[rec.id], obj_size[rec.id]);
+      objs[rec.id] = NULL;
+      continue;
+    }
+    if (objs[rec.id] != NULL)
+    {
+      skipped++;
+      continue;
+    }
+    aeagle_perf_begin();
+    t_in = aeagle_timer_now();
+    p = aeagle_allocator.alloc(rec.size);
+    t_out = aeagle_timer_now();
+    aeagle_perf_end();
+    if (p == NULL)
+    {
+      emit_time("replay", "malloc", rec.size, t_in, t_out, "NULL");
+      continue;
+    }
+    objs[rec.id] = p;
+    obj_size[rec.id] = rec.size;
+    alloc_cnt++;
+    aeagle_heapstat_alloc(rec.size);
+    if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+    {
+      emit_time("replay", "malloc", rec.size, t_in, t_out, "OK");
+    }
+  }
+  if (rc < 0)
+  {
+    aeagle_trace_drain();
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "REPLAY_TRACE");
+  }
+  if (replay_file != NULL && replay_file != stdin)
+  {
+    fclose(replay_file);
+  }
+  emit_snapshot("after_replay");
+
+  for (uint32_t i = 0; i < r.objects; i++)
+  {
+    if (objs[i] != NULL)
+    {
+      timed_free("cleanup", objs[i], obj_size[i]);
+      objs[i] = NULL;
+    }
+  }
+  emit_snapshot("post_cleanup");
+  AEAGLE_LOG_META_VALUE("replay_records", r.records);
+  AEAGLE_LOG_META_VALUE("replay_skipped", skipped);
+  aeagle_trace_finish();
+}
+
+/* Frees slot i of aeagle_dist_objs, if its malloc succeeded, and empties it. */
+static void dist_release(int i, const char *phase)
+{
+  struct aeagle_dist_obj *o = &aeagle_dist_objs[i];
+  if (o->p != NULL)
+  {
+    timed_free(phase, o->p, o->size);
+  }
+  o->p = NULL;
+  o->size = 0;
+}
+
+/* The device tests' seeded size distributions (include/aeagle_dist.h). As in
+ * ReplayTest a NULL does not end the run; the slot stays held until the
+ * object would have expired, so every allocator sees the same calls. */
+static void RandomSizesTest(void)
+{
+  aeagle_ts_t t_in, t_out;
+  uint32_t size;
+  void *p;
+  int i;
+
+  defer_time = true;
+  begin_workload();
+  AEAGLE_LOG_META_VALUE("dist_seed", AEAGLE_DIST_SEED);
+  emit_snapshot("baseline");
+
+  for (unsigned dist = 0; dist < AEAGLE_DIST_COUNT; dist++)
+  {
+    const char *phase = aeagle_dist_names[dist];
+    aeagle_dist_begin(dist);
+    for (uint32_t n = 0; n < AEAGLE_DIST_OPS; n++)
+    {
+      while ((i = aeagle_dist_expired(n)) >= 0)
+      {
+        dist_release(i, phase);
+      }
+      i = aeagle_dist_slot();
+      if (aeagle_dist_objs[i].size != 0)
+      {
+        dist_release(i, phase);
+      }
+      size = aeagle_dist_size(dist);
+      aeagle_dist_objs[i].size = size;
+      aeagle_dist_objs[i].expires = n + aeagle_dist_life();
+
+      aeagle_perf_begin();
+      t_in = aeagle_timer_now();
+      p = aeagle_allocator.alloc(size);
+      t_out = aeagle_timer_now();
+      aeagle_perf_end();
+      aeagle_dist_objs[i].p = p;
+      if (p == NULL)
+      {
+        emit_time(phase, "malloc", size, t_in, t_out, "NULL");
+        continue;
+      }
+      alloc_cnt++;
+      aeagle_heapstat_alloc(size);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        emit_time(phase, "malloc", size, t_in, t_out, "OK");
+      }
+    }
+    emit_snapshot(aeagle_dist_snaps[dist]);
+    for (i = 0; i < AEAGLE_DIST_SLOTS; i++)
+    {
+      dist_release(i, "cleanup");
+    }
+  }
+  emit_snapshot("post_cleanup");
+  aeagle_trace_finish();
+}
+
+const struct workload workloads[] = {
+    {"DoubleFree", "DF_CRASH", DoubleFreeTest},
+    {"FakeFree", "FF_CRASH", FakeFreeTest},
+    {"HeapOverflow", "HOF_CRASH", HeapOverflowTest},
+    {"LeakExhaust", "GENERAL_CRASH", LeakExhaustTest},
+    {"MixedLifetime", "GENERAL_CRASH", MixedLifetimeTest},
+    {"RandomSizes", "GENERAL_CRASH", RandomSizesTest},
+    {"Replay", "GENERAL_CRASH", ReplayTest},
+    {"UseAfterFree", "UAF_CRASH", UseAfterFreeTest},
+    {"WorstCase", "GENERAL_CRASH", WorstCaseTest},
+};
+
+const size_t workload_count = sizeof(workloads) / sizeof(workloads[0]);
@@ -0,0 +1,26 @@
+#ifndef AEAGLE_WORKLOADS_H_
+#define AEAGLE_WORKLOADS_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include "aeagle_log.h"
+
+#define BLOCK_SIZE 128U
+
+struct workload
+{
+  const char *name;
+  /* FAULT code reported if the workload dies on a signal. */
+  const char *crash_code;
+  void (*run)(void);
+};
+
+extern const struct workload workloads[];
+extern const size_t workload_count;
+/* Optional second command-line argument, e.g. Replay's trace file. */
+extern const char *workload_input;
+
+/* search.c */
+void WorstCaseTest(void);
+
+#endif /* AEAGLE_WORKLOADS_H_ */
@@ -0,0 +1,309 @@
+#ifndef AEAGLE_CONTENTION_H
+#define AEAGLE_CONTENTION_H
+
+/*
+ * Bookkeeping of the Contention workload: several tasks on one heap.
+ *
+ * Task 0 runs at the lowest priority and allocates without pause. Tasks 1
+ * to AEAGLE_CONTENTION_TASKS-1 sit above it, one priority level each, and
+ * sleep k * AEAGLE_CONTENTION_PERIOD_US between calls, so their wake-ups
+ * land at arbitrary points of the lower tasks' calls. Each task keeps up to
+ * AEAGLE_CONTENTION_HOLD blocks of 24 to 128 bytes, alternately allocating
+ * and freeing them. Task 0 stops once the others have made
+ * AEAGLE_CONTENTION_OPS calls each.
+ *
+ * A worker brackets every allocator call with:
+ *
+ *   seq = aeagle_contention_seq;            before t_in
+ *   ... t_in, the call, t_out ...
+ *   aeagle_contention_done(task, op, size, t_in, t_out, seq, ok);
+ *
+ * The call's blocked time is how long other tasks spent in allocator calls
+ * that finished inside this one's [t_in, t_out]: on one core, time this
+ * call was waiting for the allocator's lock or was preempted in it. Each
+ * finished call is published in a ring under the OS's interrupt lock, after
+ * t_out, so the bookkeeping is never timed. Calls that see more than
+ * AEAGLE_CONTENTION_RING other calls finish undercount.
+ *
+ * That only catches locks a task waits on, like newlib's malloc mutex. An
+ * allocator that suspends the scheduler or masks interrupts (heap_N,
+ * sys_heap, TLSF) makes the task above wake late instead. So the sleepers
+ * sleep to absolute deadlines, and after each wake-up call
+ *
+ *   aeagle_contention_woke(task, t0, due, due_hz);
+ *
+ * with t0 the timer when the schedule started and due the deadline since
+ * then, in 1/due_hz s of the OS's clock. Each task's earliest wake-up
+ * against its schedule counts as on time, as the sleep call rounds to
+ * kernel ticks; the rest are late by their distance from it. This assumes
+ * the timer and the kernel's clock run at the same rate.
+ *
+ * Only the controlling task prints, after every worker has finished:
+ * sampled TIME lines (one phase per task), one CONT line per task and
+ * operation with the totals, and one WAKE line per sleeping task
+ * (standard.txt).
+ */
+
+#include <stdint.h>
+
+#ifndef AEAGLE_CONTENTION_TASKS
+#define AEAGLE_CONTENTION_TASKS 4
+#endif
+
+#if AEAGLE_CONTENTION_TASKS < 2 || AEAGLE_CONTENTION_TASKS > 8
+#error "AEAGLE_CONTENTION_TASKS must be 2 to 8"
+#endif
+
+/* Calls of each sleeping task. */
+#ifndef AEAGLE_CONTENTION_OPS
+#define AEAGLE_CONTENTION_OPS 256
+#endif
+
+#ifndef AEAGLE_CONTENTION_PERIOD_US
+#define AEAGLE_CONTENTION_PERIOD_US 1000
+#endif
+
+#ifndef AEAGLE_CONTENTION_HOLD
+#define AEAGLE_CONTENTION_HOLD 4
+#endif
+
+/* Calls kept per task for TIME lines: every AEAGLE_CONTENTION_EVERY-th. */
+#ifndef AEAGLE_CONTENTION_SAMPLES
+#define AEAGLE_CONTENTION_SAMPLES 32
+#endif
+
+#ifndef AEAGLE_CONTENTION_EVERY
+#define AEAGLE_CONTENTION_EVERY 8
+#endif
+
+#ifndef AEAGLE_CONTENTION_RING
+#define AEAGLE_CONTENTION_RING 32
+#endif
+
+#if defined(__ZEPHYR__)
+#include <zephyr/irq.h>
+static inline unsigned aeagle_contention_lock(void)
+{
+  return irq_lock();
+}
+static inline void aeagle_contention_unlock(unsigned key)
+{
+  irq_unlock(key);
+}
+#elif defined(INC_FREERTOS_H)
+static inline unsigned aeagle_contention_lock(void)
+{
+  taskENTER_CRITICAL();
+  return 0;
+}
+static inline void aeagle_contention_unlock(unsigned key)
+{
+  (void)key;
+  taskEXIT_CRITICAL();
+}
+#elif defined(RIOT_BOARD)
+#include "irq.h"
+static inline unsigned aeagle_contention_lock(void)
+{
+  return irq_disable();
+}
+static inline void aeagle_contention_unlock(unsigned key)
+{
+  irq_restore(key);
+}
+#else
+#error "aeagle_contention.h needs a preemptive OS: Zephyr, FreeRTOS or RIOT"
+#endif
+
+enum
+{
+  AEAGLE_CONTENTION_MALLOC,
+  AEAGLE_CONTENTION_FREE,
+};
+
+static const char *const aeagle_contention_phases[] = {"task0", "task1", "task2", "task3",
+                                                       "task4", "task5", "task6", "task7"};
+static const uint32_t aeagle_contention_sizes[4] = {24, 48, 96, 128};
+
+struct aeagle_contention_stats
+{
+  uint32_t calls;
+  uint32_t failed;
+  uint32_t blocked_calls;
+  unsigned long sum;
+  aeagle_ts_t max;
+  unsigned long blocked_sum;
+  aeagle_ts_t blocked_max;
+};
+
+struct aeagle_contention_sample
+{
+  aeagle_ts_t t_in, t_out;
+  uint32_t size;
+  uint8_t op, ok;
+  uint32_t alloc_cnt, free_cnt;
+};
+
+struct aeagle_contention_task
+{
+  struct aeagle_contention_stats stats[2];
+  struct aeagle_contention_sample samples[AEAGLE_CONTENTION_SAMPLES];
+  uint32_t calls, nsamples;
+  /* Wake-ups, and their offsets from the schedule in timer ticks. */
+  uint32_t wakes;
+  int64_t wake_min, wake_max, wake_sum;
+};
+
+static struct aeagle_contention_task aeagle_contention_tasks[AEAGLE_CONTENTION_TASKS];
+static struct
+{
+  aeagle_ts_t t_in, t_out;
+} aeagle_contention_ring[AEAGLE_CONTENTION_RING];
+static volatile uint32_t aeagle_contention_seq;
+/* Workers finished, and the flag that ends task 0. */
+static volatile uint32_t aeagle_contention_finished;
+static volatile int aeagle_contention_stop;
+static uint32_t aeagle_contention_allocs, aeagle_contention_frees;
+
+static inline void aeagle_contention_reset(void)
+{
+  for (unsigned k = 0; k < AEAGLE_CONTENTION_TASKS; k++)
+  {
+    aeagle_contention_tasks[k] = (struct aeagle_contention_task){0};
+  }
+  aeagle_contention_seq = 0;
+  aeagle_contention_finished = 0;
+  aeagle_contention_stop = 0;
+  aeagle_contention_allocs = 0;
+  aeagle_contention_frees = 0;
+}
+
+/* Called by each worker as it returns. */
+static inline void aeagle_contention_exit(void)
+{
+  unsigned key = aeagle_contention_lock();
+  aeagle_contention_finished++;
+  aeagle_contention_unlock(key);
+}
+
+/* Records one call of task k; `seq` is aeagle_contention_seq as read before
+ * t_in. Also keeps the heap accounting, which is not thread-safe itself. */
+static inline void aeagle_contention_done(unsigned k, unsigned op, uint32_t size, aeagle_ts_t t_in,
+                                          aeagle_ts_t t_out, uint32_t seq, int ok)
+{
+  struct aeagle_contention_task *t = &aeagle_contention_tasks[k];
+  struct aeagle_contention_stats *st = &t->stats[op];
+  aeagle_ts_t len = t_out - t_in, blocked = 0;
+  unsigned key = aeagle_contention_lock();
+  uint32_t end = aeagle_contention_seq;
+
+  if (end - seq > AEAGLE_CONTENTION_RING)
+  {
+    seq = end - AEAGLE_CONTENTION_RING;
+  }
+  for (; seq != end; seq++)
+  {
+    aeagle_ts_t y_in = aeagle_contention_ring[seq % AEAGLE_CONTENTION_RING].t_in;
+    aeagle_ts_t y_out = aeagle_contention_ring[seq % AEAGLE_CONTENTION_RING].t_out;
+    /* Differences from t_in, so a wrapping counter compares correctly. */
+    aeagle_ts_t y_end = y_out - t_in;
+    if (y_end == 0 || y_end > len)
+    {
+      continue;
+    }
+    blocked += (aeagle_ts_t)(y_in - t_in) <= len ? y_out - y_in : y_end;
+  }
+  aeagle_contention_ring[end % AEAGLE_CONTENTION_RING].t_in = t_in;
+  aeagle_contention_ring[end % AEAGLE_CONTENTION_RING].t_out = t_out;
+  aeagle_contention_seq = end + 1;
+
+  if (ok)
+  {
+    if (op == AEAGLE_CONTENTION_MALLOC)
+    {
+      aeagle_contention_allocs++;
+      aeagle_heapstat_alloc(size);
+    }
+    else
+    {
+      aeagle_contention_frees++;
+      aeagle_heapstat_free(size);
+    }
+  }
+  if (t->calls % AEAGLE_CONTENTION_EVERY == 0 && t->nsamples < AEAGLE_CONTENTION_SAMPLES)
+  {
+    t->samples[t->nsamples++] = (struct aeagle_contention_sample){
+        t_in, t_out, size, (uint8_t)op, (uint8_t)ok, aeagle_contention_allocs, aeagle_contention_frees};
+  }
+  aeagle_contention_unlock(key);
+
+  t->calls++;
+  if (!ok)
+  {
+    st->failed++;
+    return;
+  }
+  st->calls++;
+  st->sum += len;
+  st->max = len > st->max ? len : st->max;
+  if (blocked > 0)
+  {
+    st->blocked_calls++;
+    st->blocked_sum += blocked;
+    st->blocked_max = blocked > st->blocked_max ? blocked : st->blocked_max;
+  }
+}
+
+/* Task k has just woken for the deadline `due` / `due_hz` seconds after
+ * its schedule began, at timer reading t0. Only task k writes its entry. */
+static inline void aeagle_contention_woke(unsigned k, aeagle_ts_t t0, uint64_t due, uint32_t due_hz)
+{
+  struct aeagle_contention_task *t = &aeagle_contention_tasks[k];
+  int64_t off = (int64_t)(aeagle_ts_t)(aeagle_timer_now() - t0) - (int64_t)(due * aeagle_timer_hz() / due_hz);
+
+  if (t->wakes == 0 || off < t->wake_min)
+  {
+    t->wake_min = off;
+  }
+  if (t->wakes == 0 || off > t->wake_max)
+  {
+    t->wake_max = off;
+  }
+  t->wake_sum += off;
+  t->wakes++;
+}
+
+/* The TIME samples, CONT totals and WAKE lateness of every task; call once
+ * all are done. */
+static inline void aeagle_contention_report(void)
+{
+  static const char *const ops[2] = {"malloc", "free"};
+
+  for (unsigned k = 0; k < AEAGLE_CONTENTION_TASKS; k++)
+  {
+    const struct aeagle_contention_task *t = &aeagle_contention_tasks[k];
+    for (uint32_t i = 0; i < t->nsamples; i++)
+    {
+      const struct aeagle_contention_sample *s = &t->samples[i];
+      AEAGLE_LOG_TIME(aeagle_contention_phases[k], ops[s->op], s->size, s->t_in, s->t_out, s->ok ? "OK" : "NULL",
+                      s->alloc_cnt, s->free_cnt);
+    }
+  }
+  for (unsigned k = 0; k < AEAGLE_CONTENTION_TASKS; k++)
+  {
+    for (unsigned op = 0; op < 2; op++)
+    {
+      const struct aeagle_contention_stats *st = &aeagle_contention_tasks[k].stats[op];
+      AEAGLE_LOG_CONT(aeagle_contention_phases[k], ops[op], st->calls, st->failed, st->blocked_calls, st->sum,
+                      st->max, st->blocked_sum, st->blocked_max);
+    }
+  }
+  for (unsigned k = 1; k < AEAGLE_CONTENTION_TASKS; k++)
+  {
+    const struct aeagle_contention_task *t = &aeagle_contention_tasks[k];
+    AEAGLE_LOG_WAKE(aeagle_contention_phases[k], t->wakes, t->wake_sum - (int64_t)t->wakes * t->wake_min,
+                    t->wake_max - t->wake_min);
+  }
+}
+
+#endif /* AEAGLE_CONTENTION_H */
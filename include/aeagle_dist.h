@@ -0,0 +1,234 @@
+#ifndef AEAGLE_DIST_H
+#define AEAGLE_DIST_H
+
+/*
+ * Seeded request sizes and lifetimes for the RandomSizes workload.
+ *
+ * The scripted tests only ever ask for 128 bytes, which never reaches
+ * TLSF's second-level bins, sys_heap's other buckets or heap_4's block
+ * splitting. RandomSizes runs one phase per size distribution:
+ *
+ *   uniform   AEAGLE_DIST_MIN..AEAGLE_DIST_MAX, all equally likely
+ *   powerlaw  octave k above MIN with probability 2^-(k+1), uniform inside
+ *             it: density ~ size^-2, most requests small, a long tail
+ *   bimodal   AEAGLE_DIST_SMALL_PCT percent headers/ACKs up to
+ *             AEAGLE_DIST_SMALL, the rest full frames in the top quarter
+ *             up to MAX
+ *   hist      sizes from aeagle_dist_hist[] by weight: AEAgle.py --sizes's
+ *             histogram if one was given, else the built-in one below
+ *
+ * Each malloc also draws a lifetime, counted in later mallocs:
+ * AEAGLE_DIST_LONG_PCT percent live up to AEAGLE_DIST_LONG, the rest up to
+ * AEAGLE_DIST_SHORT. A phase makes AEAGLE_DIST_OPS mallocs into
+ * AEAGLE_DIST_SLOTS slots; before each one it frees what has expired and,
+ * if every slot is taken, the object due first.
+ *
+ * Everything comes from one xorshift32 stream reseeded per phase from
+ * AEAGLE_DIST_SEED, with integer arithmetic only. A failed malloc keeps its
+ * slot until its lifetime ends, so every allocator, board or host, gets the
+ * same calls in the same order for a given seed.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef AEAGLE_DIST_SEED
+#define AEAGLE_DIST_SEED 1
+#endif
+
+/* Mallocs per distribution. */
+#ifndef AEAGLE_DIST_OPS
+#define AEAGLE_DIST_OPS 256
+#endif
+
+/* Objects live at once, at most. */
+#ifndef AEAGLE_DIST_SLOTS
+#define AEAGLE_DIST_SLOTS 32
+#endif
+
+#ifndef AEAGLE_DIST_MIN
+#define AEAGLE_DIST_MIN 8
+#endif
+
+#ifndef AEAGLE_DIST_MAX
+#define AEAGLE_DIST_MAX 1024
+#endif
+
+#ifndef AEAGLE_DIST_SMALL
+#define AEAGLE_DIST_SMALL 64
+#endif
+
+#ifndef AEAGLE_DIST_SMALL_PCT
+#define AEAGLE_DIST_SMALL_PCT 70
+#endif
+
+#ifndef AEAGLE_DIST_SHORT
+#define AEAGLE_DIST_SHORT 8
+#endif
+
+#ifndef AEAGLE_DIST_LONG
+#define AEAGLE_DIST_LONG 256
+#endif
+
+#ifndef AEAGLE_DIST_LONG_PCT
+#define AEAGLE_DIST_LONG_PCT 10
+#endif
+
+enum
+{
+  AEAGLE_DIST_UNIFORM,
+  AEAGLE_DIST_POWERLAW,
+  AEAGLE_DIST_BIMODAL,
+  AEAGLE_DIST_HIST,
+  AEAGLE_DIST_COUNT,
+};
+
+/* TIME phases and the SNAP taken at the end of each; string literals, as
+ * the deferred trace keeps them by pointer. */
+static const char *const aeagle_dist_names[AEAGLE_DIST_COUNT] = {"uniform", "powerlaw", "bimodal", "hist"};
+static const char *const aeagle_dist_snaps[AEAGLE_DIST_COUNT] = {"after_uniform", "after_powerlaw",
+                                                                 "after_bimodal", "after_hist"};
+
+struct aeagle_dist_bin
+{
+  uint32_t size;
+  uint32_t weight;
+};
+
+#if __has_include("aeagle_dist_hist.h")
+#include "aeagle_dist_hist.h"
+#else
+/* Small control blocks and buffers, a few larger ones; roughly what a
+ * networked sensor node asks its heap for. */
+static const struct aeagle_dist_bin aeagle_dist_hist[] = {
+    {16, 30}, {24, 20}, {32, 15}, {48, 10}, {64, 10}, {96, 5}, {128, 5}, {256, 3}, {512, 2},
+};
+#endif
+
+/* One slot: size is 0 while the slot is free. p stays NULL if the malloc
+ * failed; the slot is still held until `expires`. */
+struct aeagle_dist_obj
+{
+  void *p;
+  uint32_t size;
+  uint32_t expires;
+};
+
+static struct aeagle_dist_obj aeagle_dist_objs[AEAGLE_DIST_SLOTS];
+static uint32_t aeagle_dist_state;
+
+static inline uint32_t aeagle_dist_rand(void)
+{
+  uint32_t x = aeagle_dist_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return aeagle_dist_state = x;
+}
+
+/* 0..n-1; the modulo bias is below 2^-20 for the ranges used here. */
+static inline uint32_t aeagle_dist_below(uint32_t n)
+{
+  return aeagle_dist_rand() % n;
+}
+
+/* Starts phase `dist` with its own stream, so phases do not depend on the
+ * ones before them. */
+static inline void aeagle_dist_begin(unsigned dist)
+{
+  aeagle_dist_state = ((uint32_t)AEAGLE_DIST_SEED ^ 0x9E3779B9u) * 0x85EBCA6Bu + dist * 0xC2B2AE35u;
+  if (aeagle_dist_state == 0)
+  {
+    aeagle_dist_state = 1;
+  }
+  for (unsigned i = 0; i < AEAGLE_DIST_SLOTS; i++)
+  {
+    aeagle_dist_objs[i].p = NULL;
+    aeagle_dist_objs[i].size = 0;
+  }
+}
+
+static inline uint32_t aeagle_dist_size(unsigned dist)
+{
+  uint32_t size, total = 0, pick;
+  unsigned k = 0;
+
+  switch (dist)
+  {
+  case AEAGLE_DIST_UNIFORM:
+    return AEAGLE_DIST_MIN + aeagle_dist_below(AEAGLE_DIST_MAX - AEAGLE_DIST_MIN + 1);
+  case AEAGLE_DIST_POWERLAW:
+    /* Count the low zero bits of one draw, stopping below MAX. */
+    pick = aeagle_dist_rand();
+    while ((pick & 1) == 0 && ((uint32_t)AEAGLE_DIST_MIN << (k + 1)) < AEAGLE_DIST_MAX)
+    {
+      pick >>= 1;
+      k++;
+    }
+    size = ((uint32_t)AEAGLE_DIST_MIN << k) + aeagle_dist_below((uint32_t)AEAGLE_DIST_MIN << k);
+    return size < AEAGLE_DIST_MAX ? size : AEAGLE_DIST_MAX;
+  case AEAGLE_DIST_BIMODAL:
+    if (aeagle_dist_below(100) < AEAGLE_DIST_SMALL_PCT)
+    {
+      return AEAGLE_DIST_MIN + aeagle_dist_below(AEAGLE_DIST_SMALL - AEAGLE_DIST_MIN + 1);
+    }
+    return AEAGLE_DIST_MAX - aeagle_dist_below(AEAGLE_DIST_MAX / 4);
+  default:
+    for (unsigned i = 0; i < sizeof(aeagle_dist_hist) / sizeof(aeagle_dist_hist[0]); i++)
+    {
+      total += aeagle_dist_hist[i].weight;
+    }
+    pick = aeagle_dist_below(total);
+    for (unsigned i = 0;; i++)
+    {
+      if (pick < aeagle_dist_hist[i].weight)
+      {
+        return aeagle_dist_hist[i].size;
+      }
+      pick -= aeagle_dist_hist[i].weight;
+    }
+  }
+}
+
+/* Mallocs the object will outlive, at least 1. */
+static inline uint32_t aeagle_dist_life(void)
+{
+  if (aeagle_dist_below(100) < AEAGLE_DIST_LONG_PCT)
+  {
+    return 1 + aeagle_dist_below(AEAGLE_DIST_LONG);
+  }
+  return 1 + aeagle_dist_below(AEAGLE_DIST_SHORT);
+}
+
+/* A held slot whose object has expired by malloc number `now`, or -1. */
+static inline int aeagle_dist_expired(uint32_t now)
+{
+  for (unsigned i = 0; i < AEAGLE_DIST_SLOTS; i++)
+  {
+    if (aeagle_dist_objs[i].size != 0 && aeagle_dist_objs[i].expires <= now)
+    {
+      return (int)i;
+    }
+  }
+  return -1;
+}
+
+/* A free slot, else the held one due first; the caller frees that. */
+static inline int aeagle_dist_slot(void)
+{
+  unsigned best = 0;
+  for (unsigned i = 0; i < AEAGLE_DIST_SLOTS; i++)
+  {
+    if (aeagle_dist_objs[i].size == 0)
+    {
+      return (int)i;
+    }
+    if (aeagle_dist_objs[i].expires < aeagle_dist_objs[best].expires)
+    {
+      best = i;
+    }
+  }
+  return (int)best;
+}
+
+#endif /* AEAGLE_DIST_H */
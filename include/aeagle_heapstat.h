@@ -0,0 +1,69 @@
+#ifndef AEAGLE_HEAPSTAT_H
+#define AEAGLE_HEAPSTAT_H
+
+/*
+ * Live-heap accounting for SNAP lines, in O(1) per call.
+ *
+ * The allocators' own statistics are not free: mallinfo() and
+ * heapmem_stats() walk every chunk, memb_numfree() and memarray_available()
+ * every block, so a SNAP near a timed region costs more the fuller the heap.
+ * Instead the tests report each successful allocation and free here, after
+ * the second timestamp, with the size they asked for:
+ *
+ *   aeagle_heapstat_init(heap_bytes);   once, before the baseline SNAP
+ *   aeagle_heapstat_alloc(size);        after a successful malloc
+ *   aeagle_heapstat_free(size);         after a successful free
+ *
+ * SNAP then reports requested bytes: live and peak, and heap_bytes minus
+ * live as free (0 if the heap size is not known). Allocator overhead and
+ * fragmentation are not included. Build with -DAEAGLE_HEAPSTAT_CHECK=1 to
+ * also call the native statistics at every SNAP and log them as a HEAP
+ * line for comparison.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef AEAGLE_HEAPSTAT_CHECK
+#define AEAGLE_HEAPSTAT_CHECK 0
+#endif
+
+struct aeagle_heapstat
+{
+  unsigned long heap_bytes;
+  unsigned long live_bytes;
+  unsigned long peak_bytes;
+};
+
+static struct aeagle_heapstat aeagle_heapstat;
+
+static inline void aeagle_heapstat_init(unsigned long heap_bytes)
+{
+  aeagle_heapstat.heap_bytes = heap_bytes;
+  aeagle_heapstat.live_bytes = 0;
+  aeagle_heapstat.peak_bytes = 0;
+}
+
+static inline void aeagle_heapstat_alloc(size_t size)
+{
+  aeagle_heapstat.live_bytes += size;
+  if (aeagle_heapstat.live_bytes > aeagle_heapstat.peak_bytes)
+  {
+    aeagle_heapstat.peak_bytes = aeagle_heapstat.live_bytes;
+  }
+}
+
+/* Clamped at zero, in case a test reports a free it did not allocate. */
+static inline void aeagle_heapstat_free(size_t size)
+{
+  aeagle_heapstat.live_bytes = aeagle_heapstat.live_bytes > size ? aeagle_heapstat.live_bytes - size : 0;
+}
+
+static inline unsigned long aeagle_heapstat_free_bytes(void)
+{
+  return aeagle_heapstat.heap_bytes > aeagle_heapstat.live_bytes
+             ? aeagle_heapstat.heap_bytes - aeagle_heapstat.live_bytes
+             : 0;
+}
+
+#endif /* AEAGLE_HEAPSTAT_H */
@@ -0,0 +1,181 @@
+#ifndef AEAGLE_ISR_H
+#define AEAGLE_ISR_H
+
+/*
+ * Bookkeeping of the IsrLatency workload: heap calls from a periodic timer
+ * interrupt, and how long the heap's critical sections hold that interrupt
+ * off.
+ *
+ * The interrupt fires every AEAGLE_ISR_PERIOD_US (every kernel tick on
+ * FreeRTOS) and alternately allocates and frees one AEAGLE_ISR_SIZE block:
+ * from the main heap where its allocator may be called from an ISR, else
+ * from a pool only the ISR uses. Each phase takes AEAGLE_ISR_TICKS
+ * interrupts while the test task
+ *
+ *   isr_idle   spins without touching the heap
+ *   isr_churn  allocates and frees AEAGLE_ISR_HOLD blocks of 16 to 128
+ *              bytes on the main heap, back to back
+ *
+ * The handler reads the timer first thing. Entry lateness is that reading
+ * against the periodic schedule: the idle phase's entries give the period,
+ * and each phase's earliest entry relative to it counts as on time. An
+ * interrupt lock the main heap takes during the churn shows up as entries
+ * later than that, up to the lock's longest hold; a heap that only stops
+ * the scheduler leaves them where they were in isr_idle.
+ *
+ * A handler does
+ *
+ *   s = aeagle_isr_enter(aeagle_timer_now());   NULL: not sampling
+ *   ... s->t_in, its malloc or free, s->t_out, s->op, s->ok ...
+ *   aeagle_isr_leave();
+ *
+ * and the task runs a phase with aeagle_isr_begin() and aeagle_isr_pending(),
+ * then prints it with aeagle_isr_report(): per interrupt one TIME line with
+ * op isr_entry (t_in the scheduled entry, t_out the actual one) and one for
+ * the ISR's call, then META isr_<phase>_late_max. The ISR's blocks are not
+ * in the SNAP accounting, which the task keeps alone.
+ */
+
+#include <stdint.h>
+
+#ifndef AEAGLE_ISR_PERIOD_US
+#define AEAGLE_ISR_PERIOD_US 1000
+#endif
+
+/* Interrupts sampled per phase. */
+#ifndef AEAGLE_ISR_TICKS
+#define AEAGLE_ISR_TICKS 128
+#endif
+
+#if AEAGLE_ISR_TICKS < 2
+#error "AEAGLE_ISR_TICKS must be at least 2"
+#endif
+
+#ifndef AEAGLE_ISR_SIZE
+#define AEAGLE_ISR_SIZE 64
+#endif
+
+/* Blocks the churning task keeps. */
+#ifndef AEAGLE_ISR_HOLD
+#define AEAGLE_ISR_HOLD 8
+#endif
+
+enum
+{
+  AEAGLE_ISR_IDLE,
+  AEAGLE_ISR_CHURN,
+  AEAGLE_ISR_PHASES,
+};
+
+enum
+{
+  AEAGLE_ISR_MALLOC,
+  AEAGLE_ISR_FREE,
+};
+
+static const char *const aeagle_isr_phases[AEAGLE_ISR_PHASES] = {"isr_idle", "isr_churn"};
+static const char *const aeagle_isr_snaps[AEAGLE_ISR_PHASES] = {"after_isr_idle", "after_isr_churn"};
+static const char *const aeagle_isr_late_keys[AEAGLE_ISR_PHASES] = {"isr_idle_late_max", "isr_churn_late_max"};
+static const uint32_t aeagle_isr_sizes[4] = {16, 32, 64, 128};
+
+struct aeagle_isr_sample
+{
+  aeagle_ts_t entry, t_in, t_out;
+  uint8_t op, ok;
+};
+
+static struct aeagle_isr_sample aeagle_isr_samples[AEAGLE_ISR_TICKS];
+static volatile uint32_t aeagle_isr_count;
+static volatile int aeagle_isr_running;
+/* The ISR's block between its malloc and its free; the task frees what is
+ * left once a phase is over. */
+static void *volatile aeagle_isr_block;
+/* The idle phase's entries: the period is span / intervals. */
+static aeagle_ts_t aeagle_isr_span;
+static uint32_t aeagle_isr_intervals;
+
+static inline void aeagle_isr_begin(void)
+{
+  aeagle_isr_count = 0;
+  aeagle_isr_running = 1;
+}
+
+/* This interrupt's sample, or NULL outside a phase. */
+static inline struct aeagle_isr_sample *aeagle_isr_enter(aeagle_ts_t entry)
+{
+  if (!aeagle_isr_running)
+  {
+    return NULL;
+  }
+  aeagle_isr_samples[aeagle_isr_count].entry = entry;
+  return &aeagle_isr_samples[aeagle_isr_count];
+}
+
+static inline void aeagle_isr_leave(void)
+{
+  if (++aeagle_isr_count == AEAGLE_ISR_TICKS)
+  {
+    aeagle_isr_running = 0;
+  }
+}
+
+/* Whether the phase begun at `start` still samples. Gives up after four
+ * times the phase's length, e.g. when the interrupt never fires. */
+static inline int aeagle_isr_pending(aeagle_ts_t start)
+{
+  uint64_t limit = aeagle_timer_hz() * AEAGLE_ISR_PERIOD_US * AEAGLE_ISR_TICKS * 4 / 1000000u;
+
+  if (aeagle_isr_running && (uint64_t)(aeagle_ts_t)(aeagle_timer_now() - start) > limit)
+  {
+    aeagle_isr_running = 0;
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "ISR_TIMEOUT");
+  }
+  return aeagle_isr_running;
+}
+
+/* TIME lines and META late_max of the phase just run. The idle phase has
+ * to come first, as it sets the period. */
+static inline void aeagle_isr_report(unsigned phase)
+{
+  static const char *const ops[2] = {"malloc", "free"};
+  const struct aeagle_isr_sample *s = aeagle_isr_samples;
+  uint32_t n, count = aeagle_isr_count, ac = 0, fc = 0;
+  int64_t dev, early = 0;
+  aeagle_ts_t late, late_max = 0;
+
+  if (phase == AEAGLE_ISR_IDLE && count >= 2)
+  {
+    aeagle_isr_span = s[count - 1].entry - s[0].entry;
+    aeagle_isr_intervals = count - 1;
+  }
+  if (aeagle_isr_intervals == 0)
+  {
+    return;
+  }
+  /* Entry n against the schedule through entry 0; the earliest is on time. */
+#define AEAGLE_ISR_DEV(n)                                     \
+  ((int64_t)(aeagle_ts_t)(s[(n)].entry - s[0].entry) -        \
+   (int64_t)((uint64_t)(n) * aeagle_isr_span / aeagle_isr_intervals))
+  for (n = 0; n < count; n++)
+  {
+    dev = AEAGLE_ISR_DEV(n);
+    early = dev < early ? dev : early;
+  }
+  for (n = 0; n < count; n++)
+  {
+    late = (aeagle_ts_t)(AEAGLE_ISR_DEV(n) - early);
+    late_max = late > late_max ? late : late_max;
+    AEAGLE_LOG_TIME(aeagle_isr_phases[phase], "isr_entry", 0, s[n].entry - late, s[n].entry, "OK", ac, fc);
+    if (s[n].ok)
+    {
+      ac += s[n].op == AEAGLE_ISR_MALLOC;
+      fc += s[n].op == AEAGLE_ISR_FREE;
+    }
+    AEAGLE_LOG_TIME(aeagle_isr_phases[phase], ops[s[n].op], AEAGLE_ISR_SIZE, s[n].t_in, s[n].t_out,
+                    s[n].ok ? "OK" : "NULL", ac, fc);
+  }
+#undef AEAGLE_ISR_DEV
+  AEAGLE_LOG_META_VALUE(aeagle_isr_late_keys[phase], late_max);
+}
+
+#endif /* AEAGLE_ISR_H */
@@ -0,0 +1,260 @@
+#ifndef AEAGLE_LOG_H
+#define AEAGLE_LOG_H
+
+/*
+ * The CSV records of standard.txt, written the same way by every suite.
+ *
+ * The backend is picked from the OS headers included before this one:
+ *
+ *   Zephyr (newlib, newlib-nano)  printk, "\n"
+ *   FreeRTOS                      UART2_write on the test's `uart`, "\r\n"
+ *   RIOT                          printf + fflush, "\r\n"
+ *   Contiki                       printf, "\r\n"
+ *   anything else (host engine)   printf, "\n"
+ *
+ * Define AEAGLE_LOG_PRINTF(...) and AEAGLE_LOG_EOL first to use another
+ * writer, or AEAGLE_LOG_UART if the FreeRTOS handle has another name.
+ *
+ * AEAGLE_LOG_LEVEL selects the records at compile time (-D from AEAgle.py):
+ *
+ *   0  banners only: the "pure latency" build
+ *   1  + META, FAULT, LEAK/NOLEAK, CONT, WAKE
+ *   2  + SNAP, HEAP
+ *   3  + TIME (default)
+ *
+ * A disabled record compiles to nothing and evaluates none of its arguments;
+ * they only stay referenced so timestamps read for it do not warn. The start
+ * and end banners are always written, since the runner waits for them.
+ *
+ * TIME and SNAP have _DEFERRED variants that go through aeagle_trace.h's
+ * ring instead; include that header after this one, which sets its writer.
+ *
+ * Loops that log every operation ask AEAGLE_LOG_TIME_DUE(n) /
+ * AEAGLE_LOG_SNAP_DUE(n) first, with n the running operation count, so long
+ * runs keep a fixed logging cost per op. AEAGLE_LOG_TIME_EVERY and
+ * AEAGLE_LOG_SNAP_EVERY set the policy: 1 logs every op (default), N every
+ * Nth, 0 only ops whose count is a power of two. Phase boundaries and
+ * failed calls are logged unconditionally.
+ */
+
+#include <stdint.h>
+#include "aeagle_timer.h"
+
+#define AEAGLE_LOG_LEVEL_NONE 0
+#define AEAGLE_LOG_LEVEL_FAULT 1
+#define AEAGLE_LOG_LEVEL_SNAP 2
+#define AEAGLE_LOG_LEVEL_TIME 3
+
+#ifndef AEAGLE_LOG_LEVEL
+#define AEAGLE_LOG_LEVEL AEAGLE_LOG_LEVEL_TIME
+#endif
+
+#if defined(AEAGLE_LOG_PRINTF)
+/* Supplied by the includer. */
+#elif defined(__ZEPHYR__)
+
+#include <zephyr/sys/printk.h>
+#define AEAGLE_LOG_PRINTF(...) printk(__VA_ARGS__)
+
+#elif defined(INC_FREERTOS_H)
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <ti/drivers/UART2.h>
+
+#ifndef AEAGLE_LOG_UART
+#define AEAGLE_LOG_UART uart
+#endif
+
+/* Longest line written in one piece; a HIST line is written in parts. */
+#ifndef AEAGLE_LOG_LINE_MAX
+#define AEAGLE_LOG_LINE_MAX 128
+#endif
+
+static inline void aeagle_log_uart_printf(UART2_Handle handle, const char *fmt, ...)
+{
+  char buf[AEAGLE_LOG_LINE_MAX];
+  va_list args;
+  va_start(args, fmt);
+  int len = vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  if (len > 0)
+  {
+    UART2_write(handle, buf, len, NULL);
+  }
+}
+
+#define AEAGLE_LOG_PRINTF(...) aeagle_log_uart_printf(AEAGLE_LOG_UART, __VA_ARGS__)
+#define AEAGLE_LOG_EOL "\r\n"
+
+#elif defined(RIOT_BOARD)
+
+#include <stdio.h>
+/* Flushed per line so output survives a crash in the allocator. */
+#define AEAGLE_LOG_PRINTF(...) \
+  do                           \
+  {                            \
+    printf(__VA_ARGS__);       \
+    fflush(stdout);            \
+  } while (0)
+#define AEAGLE_LOG_EOL "\r\n"
+/* Separates the start banner from RIOT's boot message. */
+#ifndef AEAGLE_LOG_BANNER_PREFIX
+#define AEAGLE_LOG_BANNER_PREFIX "\r\n"
+#endif
+
+#elif defined(CONTIKI)
+
+#include <stdio.h>
+#define AEAGLE_LOG_PRINTF(...) printf(__VA_ARGS__)
+#define AEAGLE_LOG_EOL "\r\n"
+
+#else
+
+#include <stdio.h>
+#define AEAGLE_LOG_PRINTF(...) printf(__VA_ARGS__)
+
+#endif
+
+#ifndef AEAGLE_LOG_EOL
+#define AEAGLE_LOG_EOL "\n"
+#endif
+
+#ifndef AEAGLE_LOG_BANNER_PREFIX
+#define AEAGLE_LOG_BANNER_PREFIX ""
+#endif
+
+#ifndef AEAGLE_TRACE_PRINTF
+#define AEAGLE_TRACE_PRINTF(...) AEAGLE_LOG_PRINTF(__VA_ARGS__)
+#define AEAGLE_TRACE_EOL AEAGLE_LOG_EOL
+#endif
+
+static inline void aeagle_log_discard(int unused, ...)
+{
+  (void)unused;
+}
+
+/* Never called: keeps the arguments "used" without evaluating them. */
+#define AEAGLE_LOG_DISCARD(...) (0 ? aeagle_log_discard(0, __VA_ARGS__) : (void)0)
+
+#ifndef AEAGLE_LOG_TIME_EVERY
+#define AEAGLE_LOG_TIME_EVERY 1
+#endif
+
+#ifndef AEAGLE_LOG_SNAP_EVERY
+#define AEAGLE_LOG_SNAP_EVERY 1
+#endif
+
+/* `every` is a compile-time constant, so this folds to a mask or a modulo. */
+static inline int aeagle_log_due(uint32_t n, uint32_t every)
+{
+  if (every == 0)
+  {
+    return (n & (n - 1)) == 0;
+  }
+  return every == 1 || n % every == 0;
+}
+
+#define AEAGLE_LOG_TIME_DUE(n) \
+  (AEAGLE_LOG_LEVEL >= AEAGLE_LOG_LEVEL_TIME && aeagle_log_due((uint32_t)(n), AEAGLE_LOG_TIME_EVERY))
+
+#define AEAGLE_LOG_SNAP_DUE(n) \
+  (AEAGLE_LOG_LEVEL >= AEAGLE_LOG_LEVEL_SNAP && aeagle_log_due((uint32_t)(n), AEAGLE_LOG_SNAP_EVERY))
+
+#define AEAGLE_LOG_START(alloc_name, test_name) \
+  AEAGLE_LOG_PRINTF(AEAGLE_LOG_BANNER_PREFIX "# %s %s start" AEAGLE_LOG_EOL, (alloc_name), (test_name))
+
+#define AEAGLE_LOG_END(alloc_name, test_name) \
+  AEAGLE_LOG_PRINTF("# %s %s end" AEAGLE_LOG_EOL, (alloc_name), (test_name))
+
+#if AEAGLE_LOG_LEVEL >= AEAGLE_LOG_LEVEL_FAULT
+
+/* Both META lines; call right after aeagle_timer_init(). */
+#define AEAGLE_LOG_META()                                                                            \
+  do                                                                                                 \
+  {                                                                                                  \
+    AEAGLE_LOG_PRINTF("META,tick_hz," AEAGLE_TS_FMT AEAGLE_LOG_EOL, (aeagle_ts_t)aeagle_timer_hz()); \
+    AEAGLE_LOG_PRINTF("META,timer_overhead," AEAGLE_TS_FMT "," AEAGLE_TS_FMT AEAGLE_LOG_EOL,         \
+                      aeagle_timer_overhead_min(), aeagle_timer_overhead_median());                  \
+  } while (0)
+
+/* Any other run-level value, e.g. META,replay_records,<n>. */
+#define AEAGLE_LOG_META_VALUE(key, value) \
+  AEAGLE_LOG_PRINTF("META,%s,%lu" AEAGLE_LOG_EOL, (key), (unsigned long)(value))
+
+#define AEAGLE_LOG_FAULT(ticks, error_str) \
+  AEAGLE_LOG_PRINTF("FAULT," AEAGLE_TS_FMT ",0xDEAD,%s" AEAGLE_LOG_EOL, (aeagle_ts_t)(ticks), (error_str))
+
+#define AEAGLE_LOG_LEAK(addr) AEAGLE_LOG_PRINTF("LEAK,%p" AEAGLE_LOG_EOL, (void *)(addr))
+#define AEAGLE_LOG_NOLEAK(addr) AEAGLE_LOG_PRINTF("NOLEAK,%p" AEAGLE_LOG_EOL, (void *)(addr))
+
+/* Per-task totals of the Contention test (aeagle_contention.h). */
+#define AEAGLE_LOG_CONT(phase, op, calls, failed, blocked_calls, sum, max, blocked_sum, blocked_max)         \
+  AEAGLE_LOG_PRINTF("CONT,%s,%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu" AEAGLE_LOG_EOL, (phase), (op),                \
+                    (unsigned long)(calls), (unsigned long)(failed), (unsigned long)(blocked_calls),          \
+                    (unsigned long)(sum), (unsigned long)(max), (unsigned long)(blocked_sum),                 \
+                    (unsigned long)(blocked_max))
+
+/* Wake-up lateness of one sleeping task of the Contention test. */
+#define AEAGLE_LOG_WAKE(phase, wakes, late_sum, late_max)                                        \
+  AEAGLE_LOG_PRINTF("WAKE,%s,%lu,%lu,%lu" AEAGLE_LOG_EOL, (phase), (unsigned long)(wakes),      \
+                    (unsigned long)(late_sum), (unsigned long)(late_max))
+
+#else
+
+#define AEAGLE_LOG_META() ((void)0)
+#define AEAGLE_LOG_META_VALUE(key, value) AEAGLE_LOG_DISCARD(key, value)
+#define AEAGLE_LOG_FAULT(ticks, error_str) AEAGLE_LOG_DISCARD(ticks, error_str)
+#define AEAGLE_LOG_LEAK(addr) AEAGLE_LOG_DISCARD(addr)
+#define AEAGLE_LOG_NOLEAK(addr) AEAGLE_LOG_DISCARD(addr)
+#define AEAGLE_LOG_CONT(phase, op, calls, failed, blocked_calls, sum, max, blocked_sum, blocked_max) \
+  AEAGLE_LOG_DISCARD(phase, op, calls, failed, blocked_calls, sum, max, blocked_sum, blocked_max)
+#define AEAGLE_LOG_WAKE(phase, wakes, late_sum, late_max) AEAGLE_LOG_DISCARD(phase, wakes, late_sum, late_max)
+
+#endif
+
+#if AEAGLE_LOG_LEVEL >= AEAGLE_LOG_LEVEL_SNAP
+
+#define AEAGLE_LOG_SNAP(phase, free_b, alloc_b, max_b)                           \
+  AEAGLE_LOG_PRINTF("SNAP,%s,%lu,%lu,%lu" AEAGLE_LOG_EOL, (phase),               \
+                    (unsigned long)(free_b), (unsigned long)(alloc_b), (unsigned long)(max_b))
+
+#define AEAGLE_LOG_SNAP_DEFERRED(phase, free_b, alloc_b, max_b) \
+  aeagle_trace_snap((phase), (free_b), (alloc_b), (max_b))
+
+/* The allocator's own statistics, beside SNAP (aeagle_heapstat.h). */
+#define AEAGLE_LOG_HEAP(phase, free_b, alloc_b, max_b)                           \
+  AEAGLE_LOG_PRINTF("HEAP,%s,%lu,%lu,%lu" AEAGLE_LOG_EOL, (phase),               \
+                    (unsigned long)(free_b), (unsigned long)(alloc_b), (unsigned long)(max_b))
+
+#else
+
+#define AEAGLE_LOG_SNAP(phase, free_b, alloc_b, max_b) AEAGLE_LOG_DISCARD(phase, free_b, alloc_b, max_b)
+#define AEAGLE_LOG_SNAP_DEFERRED(phase, free_b, alloc_b, max_b) AEAGLE_LOG_DISCARD(phase, free_b, alloc_b, max_b)
+#define AEAGLE_LOG_HEAP(phase, free_b, alloc_b, max_b) AEAGLE_LOG_DISCARD(phase, free_b, alloc_b, max_b)
+
+#endif
+
+#if AEAGLE_LOG_LEVEL >= AEAGLE_LOG_LEVEL_TIME
+
+/* The TIME fields without the line end, for writers that append columns. */
+#define AEAGLE_LOG_TIME_FMT "TIME,%s,%s,%lu," AEAGLE_TS_FMT "," AEAGLE_TS_FMT ",%s,%lu,%lu"
+
+#define AEAGLE_LOG_TIME(phase, op, size, t_in, t_out, result, ac, fc)                                \
+  AEAGLE_LOG_PRINTF(AEAGLE_LOG_TIME_FMT AEAGLE_LOG_EOL, (phase), (op), (unsigned long)(size),        \
+                    (aeagle_ts_t)(t_in), (aeagle_ts_t)(t_out), (result), (unsigned long)(ac),        \
+                    (unsigned long)(fc))
+
+#define AEAGLE_LOG_TIME_DEFERRED(phase, op, size, t_in, t_out, result, ac, fc) \
+  aeagle_trace_time((phase), (op), (size), (t_in), (t_out), (result), (ac), (fc))
+
+#else
+
+#define AEAGLE_LOG_TIME(phase, op, size, t_in, t_out, result, ac, fc) \
+  AEAGLE_LOG_DISCARD(phase, op, size, t_in, t_out, result, ac, fc)
+#define AEAGLE_LOG_TIME_DEFERRED(phase, op, size, t_in, t_out, result, ac, fc) \
+  AEAGLE_LOG_DISCARD(phase, op, size, t_in, t_out, result, ac, fc)
+
+#endif
+
+#endif /* AEAGLE_LOG_H */
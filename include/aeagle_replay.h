@@ -0,0 +1,161 @@
+#ifndef AEAGLE_REPLAY_H
+#define AEAGLE_REPLAY_H
+
+/*
+ * Recorded allocation traces for the Replay workload.
+ *
+ * A trace is a malloc/free sequence taken from real firmware, so allocators
+ * can be ranked on it instead of on the scripted 128-byte patterns. Integers
+ * are LEB128 varints, as in aeagle_wire.h:
+ *
+ *   header  "AETR", version (1), objects
+ *   record  op, [size,] id, dt
+ *
+ *   op      1 malloc (followed by size), 2 free, 0 end of trace
+ *   id      object slot, below `objects`; a free names the slot of the
+ *           malloc it releases, and the slot can be reused after that
+ *   dt      ticks of the recording clock since the previous record
+ *
+ * Replay issues the records back to back; dt is carried so a trace keeps
+ * its original timing for analysis and tools. A typical record takes 3 to
+ * 5 bytes. AEAgle.py --trace converts a text trace (op,size,id,dt per line)
+ * and checks it before any build.
+ *
+ * The reader walks a buffer, so a trace compiled into flash is read in
+ * place. Streamed input passes a refill function instead, which points
+ * r->buf at the next chunk and returns its length (0 at the end).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define AEAGLE_REPLAY_VERSION 1
+
+/* Object slots the workloads keep (a pointer and a size each). */
+#ifndef AEAGLE_REPLAY_MAX_OBJECTS
+#define AEAGLE_REPLAY_MAX_OBJECTS 128
+#endif
+
+enum
+{
+  AEAGLE_REPLAY_END = 0,
+  AEAGLE_REPLAY_MALLOC = 1,
+  AEAGLE_REPLAY_FREE = 2,
+};
+
+struct aeagle_replay_rec
+{
+  uint8_t op;
+  uint32_t size;
+  uint32_t id;
+  uint32_t dt;
+};
+
+struct aeagle_replay
+{
+  const uint8_t *buf;
+  size_t len;
+  size_t pos;
+  size_t (*refill)(struct aeagle_replay *r);
+  uint32_t objects;
+  uint32_t records;
+};
+
+static inline int aeagle_replay_byte(struct aeagle_replay *r)
+{
+  if (r->pos == r->len)
+  {
+    r->pos = 0;
+    r->len = r->refill ? r->refill(r) : 0;
+    if (r->len == 0)
+    {
+      return -1;
+    }
+  }
+  return r->buf[r->pos++];
+}
+
+/* 0 on success, -1 if the input ends inside the varint or it overflows. */
+static inline int aeagle_replay_varint(struct aeagle_replay *r, uint32_t *out)
+{
+  uint32_t v = 0;
+  for (unsigned shift = 0; shift < 35; shift += 7)
+  {
+    int b = aeagle_replay_byte(r);
+    if (b < 0)
+    {
+      return -1;
+    }
+    v |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80))
+    {
+      *out = v;
+      return 0;
+    }
+  }
+  return -1;
+}
+
+/* Checks the header. Returns -1 if it is not a trace of this version or
+ * needs more than max_objects slots. */
+static inline int aeagle_replay_open(struct aeagle_replay *r, const uint8_t *buf, size_t len,
+                                     size_t (*refill)(struct aeagle_replay *r), uint32_t max_objects)
+{
+  static const char magic[4] = {'A', 'E', 'T', 'R'};
+  uint32_t version;
+
+  r->buf = buf;
+  r->len = len;
+  r->pos = 0;
+  r->refill = refill;
+  r->records = 0;
+  for (unsigned i = 0; i < sizeof(magic); i++)
+  {
+    if (aeagle_replay_byte(r) != magic[i])
+    {
+      return -1;
+    }
+  }
+  if (aeagle_replay_varint(r, &version) != 0 || version != AEAGLE_REPLAY_VERSION ||
+      aeagle_replay_varint(r, &r->objects) != 0 || r->objects > max_objects)
+  {
+    return -1;
+  }
+  return 0;
+}
+
+/* 1 with the next record in *rec, 0 at the end, -1 if the trace is
+ * truncated or malformed. */
+static inline int aeagle_replay_next(struct aeagle_replay *r, struct aeagle_replay_rec *rec)
+{
+  int op = aeagle_replay_byte(r);
+  if (op == AEAGLE_REPLAY_END)
+  {
+    return 0;
+  }
+  if (op != AEAGLE_REPLAY_MALLOC && op != AEAGLE_REPLAY_FREE)
+  {
+    return -1;
+  }
+  rec->op = (uint8_t)op;
+  rec->size = 0;
+  if (op == AEAGLE_REPLAY_MALLOC && aeagle_replay_varint(r, &rec->size) != 0)
+  {
+    return -1;
+  }
+  if (aeagle_replay_varint(r, &rec->id) != 0 || rec->id >= r->objects || aeagle_replay_varint(r, &rec->dt) != 0)
+  {
+    return -1;
+  }
+  r->records++;
+  return 1;
+}
+
+/* The trace: AEAgle.py --trace's if one was given, else the built-in one. */
+#if __has_include("aeagle_replay_trace.h")
+#include "aeagle_replay_trace.h"
+#else
+#include "aeagle_replay_default.h"
+#endif
+
+#endif /* AEAGLE_REPLAY_H */
@@ -0,0 +1,209 @@
+#ifndef AEAGLE_REPLAY_DEFAULT_H
+#define AEAGLE_REPLAY_DEFAULT_H
+
+/*
+ * Built-in trace of the Replay tests: 614 records shaped like a sensor
+ * node (AEAgle.py --trace replaces it). Eight long-lived objects from boot
+ * (96 B to 1 KiB) stay live; then 60 cycles of a radio packet with 2-5 parsed
+ * fields freed in random order, occasional replies, 32-byte timers and log
+ * strings. dt is in microseconds. Sizes above 128 bytes fail on the pools.
+ */
+
+#include <stdint.h>
+
+static const uint8_t aeagle_replay_trace[2299] = {
+    0x41, 0x45, 0x54, 0x52, 0x01, 0x10, 0x01, 0x60, 0x00, 0x86, 0x06, 0x01,
+    0x80, 0x04, 0x01, 0x86, 0x02, 0x01, 0x80, 0x02, 0x02, 0xc8, 0x08, 0x01,
+    0x80, 0x02, 0x03, 0xbe, 0x04, 0x01, 0x80, 0x03, 0x04, 0x96, 0x0c, 0x01,
+    0x30, 0x05, 0xc0, 0x03, 0x01, 0x80, 0x08, 0x06, 0xa8, 0x09, 0x01, 0x40,
+    0x07, 0xa0, 0x0e, 0x01, 0x7f, 0x08, 0xdb, 0x8b, 0x01, 0x01, 0x28, 0x09,
+    0x10, 0x01, 0x20, 0x0a, 0x25, 0x01, 0x20, 0x0b, 0x28, 0x01, 0x28, 0x0c,
+    0x0a, 0x01, 0x30, 0x0d, 0x3d, 0x02, 0x0d, 0xef, 0x08, 0x02, 0x0b, 0x17,
+    0x02, 0x0a, 0x0e, 0x02, 0x09, 0x03, 0x02, 0x0c, 0x26, 0x02, 0x08, 0x14,
+    0x01, 0x7f, 0x08, 0xcc, 0x65, 0x01, 0x20, 0x09, 0x1d, 0x01, 0x10, 0x0a,
+    0x14, 0x01, 0x18, 0x0b, 0x19, 0x01, 0x18, 0x0c, 0x1e, 0x02, 0x0c, 0x0b,
+    0x02, 0x0a, 0x27, 0x02, 0x0b, 0x0e, 0x02, 0x09, 0x27, 0x02, 0x08, 0x37,
+    0x01, 0x7f, 0x08, 0xe6, 0x0d, 0x01, 0x18, 0x09, 0x18, 0x01, 0x10, 0x0a,
+    0x18, 0x01, 0x20, 0x0b, 0x36, 0x01, 0x20, 0x0c, 0x0a, 0x01, 0x40, 0x0d,
+    0x15, 0x02, 0x0d, 0x86, 0x0a, 0x02, 0x0c, 0x08, 0x02, 0x0a, 0x0a, 0x02,
+    0x0b, 0x1b, 0x02, 0x09, 0x0e, 0x02, 0x08, 0x35, 0x01, 0x20, 0x08, 0x29,
+    0x01, 0x40, 0x09, 0x89, 0x36, 0x01, 0x10, 0x0a, 0x08, 0x01, 0x20, 0x0b,
+    0x09, 0x01, 0x28, 0x0c, 0x09, 0x01, 0x10, 0x0d, 0x21, 0x01, 0x20, 0x0e,
+    0x25, 0x01, 0x30, 0x0f, 0xb0, 0x01, 0x02, 0x0f, 0xa2, 0x0a, 0x02, 0x0e,
+    0x09, 0x02, 0x0a, 0x03, 0x02, 0x0d, 0x27, 0x02, 0x0c, 0x0a, 0x02, 0x0b,
+    0x23, 0x02, 0x09, 0x42, 0x01, 0x7f, 0x09, 0xb1, 0x83, 0x01, 0x01, 0x20,
+    0x0a, 0x06, 0x01, 0x20, 0x0b, 0x31, 0x01, 0x20, 0x0c, 0x1c, 0x01, 0x20,
+    0x0d, 0x2a, 0x01, 0x30, 0x0e, 0x17, 0x02, 0x0e, 0x93, 0x12, 0x02, 0x0d,
+    0x0c, 0x02, 0x0c, 0x28, 0x02, 0x0a, 0x26, 0x02, 0x0b, 0x0f, 0x02, 0x09,
+    0x43, 0x01, 0x7f, 0x09, 0xbb, 0x10, 0x01, 0x28, 0x0a, 0x28, 0x01, 0x20,
+    0x0b, 0x06, 0x01, 0x40, 0x0c, 0x7a, 0x02, 0x0c, 0xcb, 0x01, 0x02, 0x0a,
+    0x1b, 0x02, 0x0b, 0x25, 0x02, 0x09, 0x37, 0x01, 0x60, 0x09, 0xe0, 0x7d,
+    0x01, 0x18, 0x0a, 0x3b, 0x01, 0x28, 0x0b, 0x1c, 0x02, 0x0b, 0x21, 0x02,
+    0x0a, 0x22, 0x02, 0x09, 0x59, 0x01, 0x7f, 0x09, 0xc4, 0x24, 0x01, 0x28,
+    0x0a, 0x27, 0x01, 0x20, 0x0b, 0x26, 0x01, 0x0c, 0x0c, 0x21, 0x01, 0x28,
+    0x0d, 0x17, 0x02, 0x0a, 0x15, 0x02, 0x0c, 0x19, 0x02, 0x0b, 0x1a, 0x02,
+    0x0d, 0x1f, 0x02, 0x09, 0x4d, 0x01, 0x7f, 0x09, 0xe5, 0x62, 0x01, 0x10,
+    0x0a, 0x37, 0x01, 0x10, 0x0b, 0x18, 0x02, 0x0a, 0x1e, 0x02, 0x0b, 0x18,
+    0x02, 0x09, 0x22, 0x02, 0x08, 0xc2, 0x37, 0x01, 0x80, 0x02, 0x08, 0xcd,
+    0x70, 0x01, 0x20, 0x09, 0x2b, 0x01, 0x20, 0x0a, 0x16, 0x01, 0x20, 0x0b,
+    0x10, 0x01, 0x20, 0x0c, 0x13, 0x01, 0x0c, 0x0d, 0x3c, 0x02, 0x0d, 0x1d,
+    0x02, 0x0c, 0x16, 0x02, 0x0b, 0x0e, 0x02, 0x09, 0x1c, 0x02, 0x0a, 0x1d,
+    0x02, 0x08, 0x3d, 0x01, 0x50, 0x08, 0x25, 0x02, 0x08, 0xef, 0x0f, 0x01,
+    0x7f, 0x08, 0xdf, 0x56, 0x01, 0x18, 0x09, 0x2c, 0x01, 0x0c, 0x0a, 0x22,
+    0x01, 0x18, 0x0b, 0x29, 0x01, 0x20, 0x0c, 0x1d, 0x01, 0x20, 0x0d, 0x0a,
+    0x01, 0x7f, 0x0e, 0xc2, 0x01, 0x02, 0x0e, 0xea, 0x10, 0x02, 0x09, 0x1e,
+    0x02, 0x0c, 0x20, 0x02, 0x0d, 0x19, 0x02, 0x0a, 0x24, 0x02, 0x0b, 0x12,
+    0x02, 0x08, 0x5f, 0x01, 0x40, 0x08, 0x97, 0x39, 0x01, 0x20, 0x09, 0x0b,
+    0x01, 0x20, 0x0a, 0x26, 0x01, 0x0c, 0x0b, 0x0f, 0x01, 0x10, 0x0c, 0x38,
+    0x01, 0x20, 0x0d, 0x30, 0x02, 0x09, 0x1f, 0x02, 0x0a, 0x0a, 0x02, 0x0b,
+    0x16, 0x02, 0x0c, 0x21, 0x02, 0x0d, 0x10, 0x02, 0x08, 0x48, 0x01, 0x7f,
+    0x08, 0x9a, 0x7d, 0x01, 0x28, 0x09, 0x08, 0x01, 0x28, 0x0a, 0x39, 0x02,
+    0x0a, 0x11, 0x02, 0x09, 0x28, 0x02, 0x08, 0x4f, 0x01, 0x80, 0x02, 0x08,
+    0xc2, 0x13, 0x01, 0x0c, 0x09, 0x33, 0x01, 0x18, 0x0a, 0x3c, 0x01, 0x20,
+    0x0b, 0x0b, 0x01, 0x40, 0x0c, 0x65, 0x02, 0x0c, 0x9b, 0x0b, 0x02, 0x0a,
+    0x15, 0x02, 0x09, 0x0d, 0x02, 0x0b, 0x14, 0x02, 0x08, 0x16, 0x01, 0x40,
+    0x08, 0x95, 0x1a, 0x01, 0x0c, 0x09, 0x11, 0x01, 0x10, 0x0a, 0x12, 0x01,
+    0x20, 0x0b, 0x39, 0x01, 0x20, 0x0c, 0x1f, 0x01, 0x18, 0x0d, 0x28, 0x01,
+    0x7f, 0x0e, 0x80, 0x01, 0x02, 0x0e, 0x8b, 0x17, 0x02, 0x09, 0x03, 0x02,
+    0x0d, 0x28, 0x02, 0x0c, 0x21, 0x02, 0x0b, 0x1d, 0x02, 0x0a, 0x13, 0x02,
+    0x08, 0x39, 0x01, 0x60, 0x08, 0xd4, 0x95, 0x01, 0x01, 0x28, 0x09, 0x13,
+    0x01, 0x18, 0x0a, 0x1e, 0x01, 0x18, 0x0b, 0x17, 0x01, 0x10, 0x0c, 0x0d,
+    0x02, 0x09, 0x09, 0x02, 0x0a, 0x27, 0x02, 0x0b, 0x0c, 0x02, 0x0c, 0x26,
+    0x02, 0x08, 0x0c, 0x01, 0x40, 0x08, 0xeb, 0x1c, 0x01, 0x20, 0x09, 0x08,
+    0x01, 0x10, 0x0a, 0x12, 0x01, 0x18, 0x0b, 0x28, 0x01, 0x10, 0x0c, 0x33,
+    0x01, 0x18, 0x0d, 0x31, 0x02, 0x09, 0x06, 0x02, 0x0a, 0x19, 0x02, 0x0d,
+    0x1a, 0x02, 0x0c, 0x1a, 0x02, 0x0b, 0x0d, 0x02, 0x08, 0x29, 0x01, 0x80,
+    0x02, 0x08, 0xbf, 0x79, 0x01, 0x28, 0x09, 0x3b, 0x01, 0x20, 0x0a, 0x13,
+    0x01, 0x28, 0x0b, 0x0d, 0x01, 0x0c, 0x0c, 0x07, 0x01, 0x10, 0x0d, 0x39,
+    0x02, 0x09, 0x05, 0x02, 0x0b, 0x0c, 0x02, 0x0c, 0x10, 0x02, 0x0d, 0x08,
+    0x02, 0x0a, 0x0f, 0x02, 0x08, 0x22, 0x01, 0x7f, 0x08, 0xda, 0x0e, 0x01,
+    0x28, 0x09, 0x3b, 0x01, 0x10, 0x0a, 0x1c, 0x02, 0x09, 0x15, 0x02, 0x0a,
+    0x1b, 0x02, 0x08, 0x49, 0x01, 0x60, 0x08, 0x90, 0x6b, 0x01, 0x20, 0x09,
+    0x2f, 0x01, 0x20, 0x0a, 0x22, 0x01, 0x20, 0x0b, 0x06, 0x01, 0x20, 0x0c,
+    0x0f, 0x01, 0x18, 0x0d, 0x14, 0x02, 0x0d, 0x25, 0x02, 0x0a, 0x1f, 0x02,
+    0x0c, 0x1f, 0x02, 0x09, 0x10, 0x02, 0x0b, 0x28, 0x02, 0x08, 0x40, 0x01,
+    0xc8, 0x01, 0x08, 0x0b, 0x02, 0x08, 0x9a, 0x09, 0x01, 0x40, 0x08, 0xaa,
+    0x43, 0x01, 0x18, 0x09, 0x2f, 0x01, 0x18, 0x0a, 0x25, 0x01, 0x20, 0x0b,
+    0x3b, 0x01, 0x7f, 0x0c, 0x4e, 0x02, 0x0c, 0xa3, 0x08, 0x02, 0x0b, 0x13,
+    0x02, 0x0a, 0x03, 0x02, 0x09, 0x05, 0x02, 0x08, 0x3a, 0x01, 0x20, 0x08,
+    0x1b, 0x01, 0x40, 0x09, 0x84, 0x56, 0x01, 0x20, 0x0a, 0x31, 0x01, 0x28,
+    0x0b, 0x0f, 0x01, 0x18, 0x0c, 0x1f, 0x01, 0x30, 0x0d, 0x3e, 0x02, 0x0d,
+    0xbe, 0x0d, 0x02, 0x0c, 0x22, 0x02, 0x0b, 0x20, 0x02, 0x0a, 0x1b, 0x02,
+    0x09, 0x28, 0x01, 0x40, 0x09, 0x8e, 0x3c, 0x01, 0x0c, 0x0a, 0x12, 0x01,
+    0x10, 0x0b, 0x1b, 0x01, 0x28, 0x0c, 0x2c, 0x01, 0x18, 0x0d, 0x2d, 0x01,
+    0x7f, 0x0e, 0xa4, 0x01, 0x02, 0x0e, 0xdb, 0x10, 0x02, 0x0d, 0x17, 0x02,
+    0x0a, 0x14, 0x02, 0x0c, 0x0c, 0x02, 0x0b, 0x06, 0x02, 0x09, 0x11, 0x01,
+    0x7f, 0x09, 0x9e, 0x5c, 0x01, 0x20, 0x0a, 0x33, 0x01, 0x18, 0x0b, 0x2b,
+    0x01, 0x28, 0x0c, 0x12, 0x01, 0x0c, 0x0d, 0x31, 0x02, 0x0a, 0x18, 0x02,
+    0x0c, 0x09, 0x02, 0x0b, 0x18, 0x02, 0x0d, 0x22, 0x02, 0x09, 0x35, 0x01,
+    0x7f, 0x09, 0xb8, 0x59, 0x01, 0x28, 0x0a, 0x29, 0x01, 0x0c, 0x0b, 0x23,
+    0x01, 0x30, 0x0c, 0xb6, 0x01, 0x02, 0x0c, 0x96, 0x0c, 0x02, 0x0a, 0x23,
+    0x02, 0x0b, 0x03, 0x02, 0x09, 0x1b, 0x01, 0x40, 0x09, 0xa7, 0x59, 0x01,
+    0x20, 0x0a, 0x1c, 0x01, 0x10, 0x0b, 0x1d, 0x01, 0x0c, 0x0c, 0x13, 0x01,
+    0x18, 0x0d, 0x35, 0x01, 0x0c, 0x0e, 0x37, 0x01, 0x40, 0x0f, 0x79, 0x02,
+    0x0f, 0xe6, 0x0e, 0x02, 0x0a, 0x04, 0x02, 0x0c, 0x07, 0x02, 0x0d, 0x06,
+    0x02, 0x0e, 0x0a, 0x02, 0x0b, 0x03, 0x02, 0x09, 0x2b, 0x01, 0x80, 0x02,
+    0x09, 0xd7, 0x62, 0x01, 0x0c, 0x0a, 0x11, 0x01, 0x20, 0x0b, 0x15, 0x01,
+    0x0c, 0x0c, 0x22, 0x02, 0x0b, 0x1d, 0x02, 0x0c, 0x25, 0x02, 0x0a, 0x21,
+    0x02, 0x09, 0x39, 0x01, 0x60, 0x09, 0xb8, 0x08, 0x01, 0x10, 0x0a, 0x2d,
+    0x01, 0x20, 0x0b, 0x0c, 0x01, 0x20, 0x0c, 0x2e, 0x02, 0x0a, 0x13, 0x02,
+    0x0b, 0x04, 0x02, 0x0c, 0x14, 0x02, 0x09, 0x0d, 0x01, 0x20, 0x09, 0x1e,
+    0x01, 0x7f, 0x0a, 0xaf, 0x73, 0x01, 0x10, 0x0b, 0x1f, 0x01, 0x0c, 0x0c,
+    0x05, 0x01, 0x28, 0x0d, 0x39, 0x01, 0x20, 0x0e, 0x08, 0x02, 0x0c, 0x03,
+    0x02, 0x0b, 0x0a, 0x02, 0x0e, 0x18, 0x02, 0x0d, 0x23, 0x02, 0x0a, 0x5c,
+    0x01, 0x60, 0x0a, 0xc9, 0x60, 0x01, 0x20, 0x0b, 0x28, 0x01, 0x10, 0x0c,
+    0x20, 0x02, 0x0b, 0x09, 0x02, 0x0c, 0x1a, 0x02, 0x0a, 0x57, 0x02, 0x09,
+    0x82, 0x3a, 0x01, 0x50, 0x09, 0x0e, 0x02, 0x09, 0xfb, 0x16, 0x01, 0x60,
+    0x09, 0xdd, 0x50, 0x01, 0x10, 0x0a, 0x2c, 0x01, 0x28, 0x0b, 0x08, 0x01,
+    0x0c, 0x0c, 0x29, 0x02, 0x0c, 0x15, 0x02, 0x0b, 0x15, 0x02, 0x0a, 0x0c,
+    0x02, 0x09, 0x3f, 0x01, 0x7f, 0x09, 0x80, 0x84, 0x01, 0x01, 0x20, 0x0a,
+    0x25, 0x01, 0x28, 0x0b, 0x06, 0x01, 0x0c, 0x0c, 0x23, 0x01, 0x30, 0x0d,
+    0x9d, 0x01, 0x02, 0x0d, 0xa3, 0x05, 0x02, 0x0a, 0x1c, 0x02, 0x0c, 0x09,
+    0x02, 0x0b, 0x10, 0x02, 0x09, 0x46, 0x01, 0x7f, 0x09, 0xfa, 0x18, 0x01,
+    0x20, 0x0a, 0x28, 0x01, 0x18, 0x0b, 0x07, 0x01, 0x28, 0x0c, 0x2c, 0x01,
+    0x28, 0x0d, 0x2f, 0x01, 0x40, 0x0e, 0x54, 0x02, 0x0e, 0x89, 0x0d, 0x02,
+    0x0b, 0x0b, 0x02, 0x0a, 0x10, 0x02, 0x0d, 0x1f, 0x02, 0x0c, 0x28, 0x02,
+    0x09, 0x0f, 0x01, 0x60, 0x09, 0xdb, 0x2a, 0x01, 0x0c, 0x0a, 0x07, 0x01,
+    0x28, 0x0b, 0x3c, 0x01, 0x28, 0x0c, 0x29, 0x02, 0x0c, 0x28, 0x02, 0x0a,
+    0x08, 0x02, 0x0b, 0x09, 0x02, 0x09, 0x5b, 0x01, 0x40, 0x09, 0xf3, 0x36,
+    0x01, 0x20, 0x0a, 0x13, 0x01, 0x10, 0x0b, 0x13, 0x01, 0x18, 0x0c, 0x25,
+    0x01, 0x10, 0x0d, 0x3c, 0x02, 0x0d, 0x1e, 0x02, 0x0a, 0x0e, 0x02, 0x0b,
+    0x10, 0x02, 0x0c, 0x07, 0x02, 0x09, 0x42, 0x01, 0x60, 0x09, 0xc7, 0x97,
+    0x01, 0x01, 0x0c, 0x0a, 0x18, 0x01, 0x20, 0x0b, 0x20, 0x01, 0x28, 0x0c,
+    0x25, 0x02, 0x0c, 0x28, 0x02, 0x0b, 0x04, 0x02, 0x0a, 0x19, 0x02, 0x09,
+    0x10, 0x01, 0x7f, 0x09, 0xdb, 0x62, 0x01, 0x20, 0x0a, 0x37, 0x01, 0x18,
+    0x0b, 0x0e, 0x01, 0x7f, 0x0c, 0x66, 0x02, 0x0c, 0xf6, 0x0a, 0x02, 0x0a,
+    0x1d, 0x02, 0x0b, 0x13, 0x02, 0x09, 0x22, 0x02, 0x08, 0xc7, 0x36, 0x01,
+    0x7f, 0x08, 0xfa, 0x44, 0x01, 0x0c, 0x09, 0x2e, 0x01, 0x18, 0x0a, 0x22,
+    0x01, 0x40, 0x0b, 0xb1, 0x01, 0x02, 0x0b, 0x97, 0x13, 0x02, 0x0a, 0x16,
+    0x02, 0x09, 0x1a, 0x02, 0x08, 0x59, 0x01, 0x20, 0x08, 0x21, 0x01, 0x7f,
+    0x09, 0x90, 0x95, 0x01, 0x01, 0x0c, 0x0a, 0x33, 0x01, 0x28, 0x0b, 0x2a,
+    0x01, 0x28, 0x0c, 0x2f, 0x01, 0x18, 0x0d, 0x1c, 0x01, 0x28, 0x0e, 0x2c,
+    0x02, 0x0d, 0x03, 0x02, 0x0c, 0x08, 0x02, 0x0b, 0x15, 0x02, 0x0a, 0x09,
+    0x02, 0x0e, 0x1a, 0x02, 0x09, 0x35, 0x01, 0x7f, 0x09, 0xf7, 0x5a, 0x01,
+    0x20, 0x0a, 0x30, 0x01, 0x0c, 0x0b, 0x0e, 0x02, 0x0a, 0x24, 0x02, 0x0b,
+    0x07, 0x02, 0x09, 0x2d, 0x01, 0xc8, 0x01, 0x09, 0x31, 0x02, 0x09, 0x9f,
+    0x1d, 0x01, 0x7f, 0x09, 0xc5, 0x1b, 0x01, 0x28, 0x0a, 0x09, 0x01, 0x0c,
+    0x0b, 0x22, 0x01, 0x28, 0x0c, 0x0b, 0x01, 0x20, 0x0d, 0x23, 0x02, 0x0c,
+    0x10, 0x02, 0x0b, 0x0f, 0x02, 0x0a, 0x21, 0x02, 0x0d, 0x13, 0x02, 0x09,
+    0x10, 0x01, 0x7f, 0x09, 0x87, 0x80, 0x01, 0x01, 0x18, 0x0a, 0x2e, 0x01,
+    0x0c, 0x0b, 0x3b, 0x02, 0x0a, 0x23, 0x02, 0x0b, 0x27, 0x02, 0x09, 0x49,
+    0x01, 0x7f, 0x09, 0xfb, 0x26, 0x01, 0x28, 0x0a, 0x06, 0x01, 0x28, 0x0b,
+    0x31, 0x01, 0x20, 0x0c, 0x1e, 0x01, 0x0c, 0x0d, 0x0d, 0x01, 0x0c, 0x0e,
+    0x0a, 0x01, 0x40, 0x0f, 0xc8, 0x01, 0x02, 0x0f, 0xfa, 0x01, 0x02, 0x0b,
+    0x0f, 0x02, 0x0e, 0x0b, 0x02, 0x0d, 0x0d, 0x02, 0x0c, 0x10, 0x02, 0x0a,
+    0x1f, 0x02, 0x09, 0x0a, 0x01, 0x7f, 0x09, 0xe4, 0x11, 0x01, 0x20, 0x0a,
+    0x29, 0x01, 0x28, 0x0b, 0x29, 0x02, 0x0a, 0x0c, 0x02, 0x0b, 0x20, 0x02,
+    0x09, 0x4d, 0x02, 0x08, 0xb5, 0x45, 0x01, 0x7f, 0x08, 0xb0, 0x67, 0x01,
+    0x28, 0x09, 0x28, 0x01, 0x10, 0x0a, 0x2c, 0x01, 0x20, 0x0b, 0x13, 0x01,
+    0x18, 0x0c, 0x07, 0x02, 0x09, 0x1d, 0x02, 0x0c, 0x15, 0x02, 0x0b, 0x11,
+    0x02, 0x0a, 0x13, 0x02, 0x08, 0x27, 0x01, 0x20, 0x08, 0x0a, 0x01, 0x60,
+    0x09, 0xa2, 0x73, 0x01, 0x0c, 0x0a, 0x1c, 0x01, 0x20, 0x0b, 0x2a, 0x01,
+    0x18, 0x0c, 0x13, 0x01, 0x18, 0x0d, 0x25, 0x01, 0x18, 0x0e, 0x11, 0x02,
+    0x0b, 0x16, 0x02, 0x0d, 0x20, 0x02, 0x0c, 0x28, 0x02, 0x0a, 0x19, 0x02,
+    0x0e, 0x10, 0x02, 0x09, 0x2a, 0x01, 0x7f, 0x09, 0xf5, 0x98, 0x01, 0x01,
+    0x18, 0x0a, 0x0d, 0x01, 0x10, 0x0b, 0x2b, 0x01, 0x40, 0x0c, 0x53, 0x02,
+    0x0c, 0xd9, 0x12, 0x02, 0x0a, 0x16, 0x02, 0x0b, 0x19, 0x02, 0x09, 0x24,
+    0x01, 0x7f, 0x09, 0xd8, 0x2b, 0x01, 0x0c, 0x0a, 0x3a, 0x01, 0x10, 0x0b,
+    0x23, 0x01, 0x10, 0x0c, 0x14, 0x01, 0x10, 0x0d, 0x06, 0x01, 0x0c, 0x0e,
+    0x2a, 0x02, 0x0e, 0x20, 0x02, 0x0c, 0x08, 0x02, 0x0b, 0x0b, 0x02, 0x0a,
+    0x26, 0x02, 0x0d, 0x07, 0x02, 0x09, 0x61, 0x01, 0x40, 0x09, 0x8c, 0x63,
+    0x01, 0x28, 0x0a, 0x1b, 0x01, 0x0c, 0x0b, 0x35, 0x01, 0x10, 0x0c, 0x2c,
+    0x02, 0x0a, 0x1e, 0x02, 0x0c, 0x23, 0x02, 0x0b, 0x09, 0x02, 0x09, 0x36,
+    0x01, 0x80, 0x02, 0x09, 0xeb, 0x49, 0x01, 0x10, 0x0a, 0x0a, 0x01, 0x28,
+    0x0b, 0x33, 0x01, 0x40, 0x0c, 0x9d, 0x01, 0x02, 0x0c, 0xb2, 0x05, 0x02,
+    0x0b, 0x07, 0x02, 0x0a, 0x21, 0x02, 0x09, 0x56, 0x01, 0x20, 0x09, 0x14,
+    0x01, 0xa0, 0x01, 0x0a, 0x27, 0x02, 0x0a, 0xee, 0x0a, 0x01, 0x7f, 0x0a,
+    0xf6, 0x82, 0x01, 0x01, 0x20, 0x0b, 0x0f, 0x01, 0x20, 0x0c, 0x39, 0x01,
+    0x10, 0x0d, 0x3a, 0x01, 0x18, 0x0e, 0x15, 0x02, 0x0e, 0x14, 0x02, 0x0d,
+    0x1a, 0x02, 0x0c, 0x22, 0x02, 0x0b, 0x18, 0x02, 0x0a, 0x59, 0x02, 0x08,
+    0xb6, 0x0c, 0x01, 0x7f, 0x08, 0xeb, 0x7a, 0x01, 0x18, 0x0a, 0x06, 0x01,
+    0x18, 0x0b, 0x09, 0x01, 0x0c, 0x0c, 0x14, 0x01, 0x20, 0x0d, 0x10, 0x02,
+    0x0c, 0x27, 0x02, 0x0a, 0x06, 0x02, 0x0d, 0x04, 0x02, 0x0b, 0x19, 0x02,
+    0x08, 0x64, 0x02, 0x09, 0xc8, 0x3a, 0x01, 0x80, 0x02, 0x08, 0xa7, 0x7f,
+    0x01, 0x18, 0x09, 0x1f, 0x01, 0x20, 0x0a, 0x27, 0x02, 0x0a, 0x11, 0x02,
+    0x09, 0x0e, 0x02, 0x08, 0x1f, 0x01, 0x7f, 0x08, 0xc2, 0x2d, 0x01, 0x20,
+    0x09, 0x37, 0x01, 0x20, 0x0a, 0x0b, 0x02, 0x0a, 0x20, 0x02, 0x09, 0x19,
+    0x02, 0x08, 0x33, 0x01, 0x7f, 0x08, 0xff, 0x2d, 0x01, 0x28, 0x09, 0x28,
+    0x01, 0x18, 0x0a, 0x3c, 0x01, 0x18, 0x0b, 0x0d, 0x01, 0x28, 0x0c, 0x12,
+    0x01, 0x10, 0x0d, 0x19, 0x01, 0x40, 0x0e, 0xa1, 0x01, 0x02, 0x0e, 0xb1,
+    0x08, 0x02, 0x0a, 0x0d, 0x02, 0x0c, 0x1e, 0x02, 0x0b, 0x05, 0x02, 0x0d,
+    0x0d, 0x02, 0x09, 0x09, 0x02, 0x08, 0x36, 0x01, 0x40, 0x08, 0x89, 0x4b,
+    0x01, 0x28, 0x09, 0x31, 0x01, 0x20, 0x0a, 0x2a, 0x02, 0x0a, 0x26, 0x02,
+    0x09, 0x03, 0x02, 0x08, 0x41, 0x01, 0x7f, 0x08, 0xfd, 0x26, 0x01, 0x18,
+    0x09, 0x11, 0x01, 0x28, 0x0a, 0x38, 0x01, 0x7f, 0x0b, 0x81, 0x01, 0x02,
+    0x0b, 0x81, 0x01, 0x02, 0x09, 0x0d, 0x02, 0x0a, 0x14, 0x02, 0x08, 0x21,
+    0x01, 0x20, 0x08, 0x2c, 0x01, 0x60, 0x09, 0xde, 0x6f, 0x01, 0x20, 0x0a,
+    0x36, 0x01, 0x20, 0x0b, 0x1c, 0x01, 0x10, 0x0c, 0x18, 0x01, 0x18, 0x0d,
+    0x1e, 0x01, 0x40, 0x0e, 0xb5, 0x01, 0x02, 0x0e, 0xb6, 0x14, 0x02, 0x0d,
+    0x19, 0x02, 0x0a, 0x28, 0x02, 0x0b, 0x09, 0x02, 0x0c, 0x1d, 0x02, 0x09,
+    0x10, 0x01, 0x7f, 0x09, 0xf5, 0x43, 0x01, 0x10, 0x0a, 0x15, 0x01, 0x20,
+    0x0b, 0x09, 0x01, 0x0c, 0x0c, 0x17, 0x01, 0x0c, 0x0d, 0x26, 0x01, 0x30,
+    0x0e, 0x29, 0x02, 0x0e, 0x92, 0x05, 0x02, 0x0b, 0x12, 0x02, 0x0d, 0x0e,
+    0x02, 0x0a, 0x0f, 0x02, 0x0c, 0x0e, 0x02, 0x09, 0x17, 0x01, 0x60, 0x09,
+    0xf7, 0x21, 0x01, 0x0c, 0x0a, 0x23, 0x01, 0x28, 0x0b, 0x0a, 0x02, 0x0b,
+    0x10, 0x02, 0x0a, 0x14, 0x02, 0x09, 0x34, 0x01, 0x50, 0x09, 0x30, 0x02,
+    0x09, 0x90, 0x1b, 0x02, 0x08, 0x17, 0x00,
+};
+
+#endif /* AEAGLE_REPLAY_DEFAULT_H */
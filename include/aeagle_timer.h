@@ -0,0 +1,275 @@
+#ifndef AEAGLE_TIMER_H
+#define AEAGLE_TIMER_H
+
+/*
+ * One timestamp source for every suite, as fine-grained as the target allows:
+ *
+ *   Cortex-M3/M4/M33   DWT cycle counter (CYCCNT), at the core clock
+ *   native_sim (x86)   the TSC; its simulated clocks do not move while code runs,
+ *                      so its rate is measured against the host clock
+ *   Linux/POSIX hosts  CLOCK_MONOTONIC_RAW in ns, or the TSC with -DAEAGLE_TIMER_TSC
+ *   anything else      the OS's own counter (k_cycle_get_32, xTaskGetTickCount,
+ *                      ztimer_now, RTIMER_NOW), e.g. QEMU with -DAEAGLE_TIMER_NO_DWT
+ *
+ * Include it after the OS headers, call aeagle_timer_init() once before the
+ * first reading, and report aeagle_timer_hz() as META tick_hz and
+ * aeagle_timer_overhead_min()/_median() as META timer_overhead. The DWT path
+ * needs the core clock: taken from the devicetree on Zephyr,
+ * configCPU_CLOCK_HZ on FreeRTOS and CLOCK_CORECLOCK on RIOT; define
+ * AEAGLE_TIMER_CPU_HZ anywhere else (Contiki's project-conf.h does).
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+
+#if !defined(AEAGLE_TIMER_NO_DWT) &&                                  \
+    (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) ||         \
+     defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__))
+#define AEAGLE_TIMER_BACKEND_DWT 1
+#elif (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(AEAGLE_TIMER_TSC) || defined(CONFIG_ARCH_POSIX))
+#define AEAGLE_TIMER_BACKEND_TSC 1
+#elif defined(__unix__) && !defined(__ZEPHYR__)
+#define AEAGLE_TIMER_BACKEND_CLOCK 1
+#else
+#define AEAGLE_TIMER_BACKEND_OS 1
+#endif
+
+#if defined(AEAGLE_TIMER_BACKEND_DWT) || defined(AEAGLE_TIMER_BACKEND_OS)
+typedef uint32_t aeagle_ts_t;
+#define AEAGLE_TS_FMT "%" PRIu32
+#else
+typedef uint64_t aeagle_ts_t;
+#define AEAGLE_TS_FMT "%" PRIu64
+#endif
+
+#if defined(__ZEPHYR__)
+#include <zephyr/devicetree.h>
+#include <zephyr/kernel.h>
+#elif defined(RIOT_BOARD)
+#include "periph_conf.h"
+#include "ztimer.h"
+#elif defined(CONTIKI)
+#include "sys/rtimer.h"
+#endif
+
+static uint64_t aeagle_timer_freq;
+static aeagle_ts_t aeagle_timer_ovh_min;
+static aeagle_ts_t aeagle_timer_ovh_median;
+
+#if defined(AEAGLE_TIMER_BACKEND_DWT)
+
+#define AEAGLE_DEMCR (*(volatile uint32_t *)0xE000EDFCu)
+#define AEAGLE_DWT_CTRL (*(volatile uint32_t *)0xE0001000u)
+#define AEAGLE_DWT_CYCCNT (*(volatile uint32_t *)0xE0001004u)
+#define AEAGLE_DWT_LAR (*(volatile uint32_t *)0xE0001FB0u)
+
+#if defined(AEAGLE_TIMER_CPU_HZ)
+#define AEAGLE_TIMER_DWT_HZ() ((uint64_t)(AEAGLE_TIMER_CPU_HZ))
+#elif defined(__ZEPHYR__)
+#if DT_NODE_HAS_PROP(DT_PATH(cpus, cpu_0), clock_frequency)
+#define AEAGLE_TIMER_DWT_HZ() ((uint64_t)DT_PROP(DT_PATH(cpus, cpu_0), clock_frequency))
+#else
+#define AEAGLE_TIMER_DWT_HZ() ((uint64_t)sys_clock_hw_cycles_per_sec())
+#endif
+#elif defined(INC_FREERTOS_H)
+#define AEAGLE_TIMER_DWT_HZ() ((uint64_t)configCPU_CLOCK_HZ)
+#elif defined(CLOCK_CORECLOCK)
+#define AEAGLE_TIMER_DWT_HZ() ((uint64_t)CLOCK_CORECLOCK)
+#else
+#error "aeagle_timer.h: define AEAGLE_TIMER_CPU_HZ to the core clock"
+#endif
+
+static inline void aeagle_timer_start(void)
+{
+  AEAGLE_DEMCR |= 1u << 24; /* TRCENA */
+  AEAGLE_DWT_LAR = 0xC5ACCE55u; /* only locked on the M7, ignored elsewhere */
+  AEAGLE_DWT_CYCCNT = 0;
+  AEAGLE_DWT_CTRL |= 1u; /* CYCCNTENA */
+  aeagle_timer_freq = AEAGLE_TIMER_DWT_HZ();
+}
+
+static inline aeagle_ts_t aeagle_timer_now(void)
+{
+  return AEAGLE_DWT_CYCCNT;
+}
+
+#elif defined(AEAGLE_TIMER_BACKEND_TSC)
+
+#include <cpuid.h>
+#if !defined(__ZEPHYR__)
+#include <time.h>
+#endif
+
+static inline aeagle_ts_t aeagle_timer_now(void)
+{
+  uint32_t lo, hi;
+  /* lfence keeps rdtsc from being hoisted above the code being timed. */
+  __asm__ volatile("lfence\n\trdtsc" : "=a"(lo), "=d"(hi) : : "memory");
+  return ((uint64_t)hi << 32) | lo;
+}
+
+/* The host's CLOCK_MONOTONIC_RAW in ns; 0 if it cannot be read. native_sim
+ * builds against Zephyr's libc, so there it asks the Linux kernel directly. */
+static inline uint64_t aeagle_timer_host_ns(void)
+{
+#if !defined(__ZEPHYR__)
+  struct timespec ts;
+  if (clock_gettime(CLOCK_MONOTONIC_RAW, &ts) != 0)
+  {
+    return 0;
+  }
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#elif defined(__linux__)
+  long ts[2], ret;
+#if defined(__x86_64__)
+  __asm__ volatile("syscall"
+                   : "=a"(ret)
+                   : "0"(228L /* clock_gettime */), "D"(4L /* CLOCK_MONOTONIC_RAW */), "S"(ts)
+                   : "rcx", "r11", "memory");
+#else
+  __asm__ volatile("int $0x80"
+                   : "=a"(ret)
+                   : "0"(265L /* clock_gettime */), "b"(4L /* CLOCK_MONOTONIC_RAW */), "c"(ts)
+                   : "memory");
+#endif
+  if (ret != 0)
+  {
+    return 0;
+  }
+  return (uint64_t)ts[0] * 1000000000u + (uint64_t)ts[1];
+#else
+  return 0;
+#endif
+}
+
+/* Measures the TSC against the host's raw monotonic clock for 20 ms. Only
+ * if that clock is unavailable does it trust CPUID: leaf 0x15 gives the
+ * crystal ratio, 0x16 the nominal base frequency in MHz, which the TSC may
+ * not run at; and both read 0 on AMD and under many hypervisors. */
+static inline void aeagle_timer_start(void)
+{
+  unsigned int eax, ebx, ecx, edx;
+  uint64_t a = aeagle_timer_host_ns(), b, c0, c1;
+
+  if (a != 0)
+  {
+    c0 = aeagle_timer_now();
+    do
+    {
+      b = aeagle_timer_host_ns();
+    } while (b != 0 && b - a < 20000000u);
+    c1 = aeagle_timer_now();
+    if (b != 0)
+    {
+      aeagle_timer_freq = (c1 - c0) * 1000000000u / (b - a);
+      return;
+    }
+  }
+  aeagle_timer_freq = 0;
+  if (__get_cpuid(0x15, &eax, &ebx, &ecx, &edx) && eax && ebx && ecx)
+  {
+    aeagle_timer_freq = (uint64_t)ecx * ebx / eax;
+  }
+  else if (__get_cpuid(0x16, &eax, &ebx, &ecx, &edx) && (eax & 0xffff))
+  {
+    aeagle_timer_freq = (uint64_t)(eax & 0xffff) * 1000000u;
+  }
+}
+
+#elif defined(AEAGLE_TIMER_BACKEND_CLOCK)
+
+#include <time.h>
+
+static inline void aeagle_timer_start(void)
+{
+  aeagle_timer_freq = 1000000000u;
+}
+
+/* Nanoseconds from the raw monotonic clock, immune to NTP slewing. */
+static inline aeagle_ts_t aeagle_timer_now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+#else /* AEAGLE_TIMER_BACKEND_OS */
+
+#if defined(__ZEPHYR__)
+#define AEAGLE_TIMER_OS_NOW() k_cycle_get_32()
+#define AEAGLE_TIMER_OS_HZ() sys_clock_hw_cycles_per_sec()
+#elif defined(INC_FREERTOS_H)
+#define AEAGLE_TIMER_OS_NOW() xTaskGetTickCount()
+#define AEAGLE_TIMER_OS_HZ() configTICK_RATE_HZ
+#elif defined(RIOT_BOARD)
+#define AEAGLE_TIMER_OS_NOW() ztimer_now(ZTIMER_USEC)
+#define AEAGLE_TIMER_OS_HZ() 1000000u
+#elif defined(CONTIKI)
+#define AEAGLE_TIMER_OS_NOW() RTIMER_NOW()
+#define AEAGLE_TIMER_OS_HZ() RTIMER_SECOND
+#else
+#error "aeagle_timer.h: no timer for this target"
+#endif
+
+static inline void aeagle_timer_start(void)
+{
+  aeagle_timer_freq = (uint64_t)AEAGLE_TIMER_OS_HZ();
+}
+
+static inline aeagle_ts_t aeagle_timer_now(void)
+{
+  return (aeagle_ts_t)AEAGLE_TIMER_OS_NOW();
+}
+
+#endif
+
+/* Back-to-back reads timed at start-up; odd, so the median is a sample. */
+#ifndef AEAGLE_TIMER_CALIBRATION_READS
+#define AEAGLE_TIMER_CALIBRATION_READS 31
+#endif
+
+/* Starts the counter, then measures what one aeagle_timer_now() pair costs
+ * with nothing between the reads. Every TIME row includes that cost. */
+static inline void aeagle_timer_init(void)
+{
+  aeagle_ts_t d[AEAGLE_TIMER_CALIBRATION_READS];
+
+  aeagle_timer_start();
+  (void)aeagle_timer_now(); /* warm up the instruction cache */
+  for (int i = 0; i < AEAGLE_TIMER_CALIBRATION_READS; ++i)
+  {
+    aeagle_ts_t t_in = aeagle_timer_now();
+    aeagle_ts_t t_out = aeagle_timer_now();
+    aeagle_ts_t v = (aeagle_ts_t)(t_out - t_in);
+    int j = i;
+    /* Insertion sort as we go; the array is tiny. */
+    while (j > 0 && d[j - 1] > v)
+    {
+      d[j] = d[j - 1];
+      --j;
+    }
+    d[j] = v;
+  }
+  aeagle_timer_ovh_min = d[0];
+  aeagle_timer_ovh_median = d[AEAGLE_TIMER_CALIBRATION_READS / 2];
+}
+
+/* Smallest and median cost of a back-to-back read pair, in counter ticks. */
+static inline aeagle_ts_t aeagle_timer_overhead_min(void)
+{
+  return aeagle_timer_ovh_min;
+}
+
+static inline aeagle_ts_t aeagle_timer_overhead_median(void)
+{
+  return aeagle_timer_ovh_median;
+}
+
+/* Counts per second of aeagle_timer_now(); valid after aeagle_timer_init(). */
+static inline uint64_t aeagle_timer_hz(void)
+{
+  return aeagle_timer_freq;
+}
+
+#endif /* AEAGLE_TIMER_H */
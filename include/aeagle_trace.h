@@ -0,0 +1,381 @@
+#ifndef AEAGLE_TRACE_H
+#define AEAGLE_TRACE_H
+
+/*
+ * Deferred TIME/SNAP logging for the timed loops of the tests.
+ *
+ * Records are fixed-size binary entries in a static ring; nothing is
+ * formatted or written to the console until aeagle_trace_drain(), which the
+ * tests call between phases (before every SNAP, FAULT and the end banner).
+ * The console is never written mid-phase: once the ring is full, further
+ * records are dropped and counted, and the next drain reports them as
+ *   META,trace_dropped,<n>
+ * after the records it kept; AEAgle.py fails such a run. Size
+ * AEAGLE_TRACE_CAPACITY to a whole phase.
+ *
+ * Before including this header, define AEAGLE_TRACE_PRINTF(...) as the
+ * test's printf-style line writer, and AEAGLE_TRACE_EOL if lines end in
+ * something other than "\n". Phase/op/result strings are stored by pointer
+ * and must stay valid until the next drain (string literals in practice).
+ * Each translation unit gets its own ring.
+ *
+ * With -DAEAGLE_TRACE_HIST, successful TIME records are not kept one by one:
+ * each (phase, op, size) gets a log-bucketed latency histogram instead, and
+ * aeagle_trace_finish() prints every histogram once as a HIST line before the
+ * end banner. Results other than "OK", and keys beyond the
+ * AEAGLE_TRACE_HIST_SLOTS histograms, are still traced as TIME records.
+ * A crash before aeagle_trace_finish() loses the histograms.
+ *
+ * With -DAEAGLE_WIRE, records are delta-encoded into a byte ring of the same
+ * size instead (aeagle_wire.h), which holds about five times as many, and the
+ * drain sends them as binary frames instead of CSV lines.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef AEAGLE_TRACE_PRINTF
+#error "Define AEAGLE_TRACE_PRINTF(...) before including aeagle_trace.h"
+#endif
+
+#ifndef AEAGLE_TRACE_EOL
+#define AEAGLE_TRACE_EOL "\n"
+#endif
+
+/* 64 records are ~2.3 KiB on a 32-bit target, which still fits next to the
+ * 64 KiB heaps on the CC1352, but is short of a LeakExhaust or RandomSizes
+ * phase: boards need -DAEAGLE_WIRE, AEAGLE_LOG_TIME_EVERY or histogram mode
+ * for those. In histogram mode the ring only holds SNAPs and failed calls,
+ * and the histograms need the RAM. The native ports have RAM to spare and
+ * hold the longest phase (LeakExhaust's, ~512 records). */
+#ifndef AEAGLE_TRACE_CAPACITY
+#if defined(__unix__) || defined(CONFIG_ARCH_POSIX)
+#define AEAGLE_TRACE_CAPACITY 4096
+#elif defined(AEAGLE_TRACE_HIST)
+#define AEAGLE_TRACE_CAPACITY 16
+#else
+#define AEAGLE_TRACE_CAPACITY 64
+#endif
+#endif
+
+/* Timestamps are aeagle_timer.h's when it is included first; otherwise
+ * override both if the counter does not fit in an unsigned long. */
+#ifndef AEAGLE_TRACE_TS_T
+#ifdef AEAGLE_TS_FMT
+#define AEAGLE_TRACE_TS_T aeagle_ts_t
+#define AEAGLE_TRACE_TS_FMT AEAGLE_TS_FMT
+#else
+#define AEAGLE_TRACE_TS_T unsigned long
+#define AEAGLE_TRACE_TS_FMT "%lu"
+#endif
+#endif
+
+/* Nonzero, so a slot never written (e.g. with TIME compiled out by
+ * aeagle_log.h) is not mistaken for a record. */
+enum aeagle_trace_kind
+{
+  AEAGLE_TRACE_TIME = 1,
+  AEAGLE_TRACE_SNAP,
+};
+
+struct aeagle_trace_rec
+{
+  uint8_t kind;
+  const char *phase;
+  union
+  {
+    struct
+    {
+      const char *op;
+      const char *result;
+      unsigned long size;
+      AEAGLE_TRACE_TS_T t_in;
+      AEAGLE_TRACE_TS_T t_out;
+      uint32_t alloc_cnt;
+      uint32_t free_cnt;
+    } time;
+    struct
+    {
+      unsigned long free_bytes;
+      unsigned long allocated_bytes;
+      unsigned long max_allocated_bytes;
+    } snap;
+  } u;
+};
+
+#ifdef AEAGLE_WIRE
+
+#ifndef AEAGLE_WIRE_PRINTF
+#define AEAGLE_WIRE_PRINTF(...) AEAGLE_TRACE_PRINTF(__VA_ARGS__)
+#endif
+#define AEAGLE_WIRE_TS_BITS (8 * sizeof(AEAGLE_TRACE_TS_T))
+#ifndef AEAGLE_WIRE_RING
+#define AEAGLE_WIRE_RING (AEAGLE_TRACE_CAPACITY * sizeof(struct aeagle_trace_rec))
+#endif
+#include "aeagle_wire.h"
+
+/* Records that did not fit since the last drain. */
+static unsigned long aeagle_trace_dropped;
+
+static void aeagle_trace_drain(void)
+{
+  aeagle_wire_flush();
+  if (aeagle_trace_dropped)
+  {
+    AEAGLE_TRACE_PRINTF("META,trace_dropped,%lu" AEAGLE_TRACE_EOL, aeagle_trace_dropped);
+    aeagle_trace_dropped = 0;
+  }
+}
+
+#else
+
+static struct aeagle_trace_rec aeagle_trace_ring[AEAGLE_TRACE_CAPACITY];
+static size_t aeagle_trace_len;
+/* Records that did not fit since the last drain. */
+static unsigned long aeagle_trace_dropped;
+
+static void aeagle_trace_drain(void)
+{
+  for (size_t i = 0; i < aeagle_trace_len; ++i)
+  {
+    const struct aeagle_trace_rec *r = &aeagle_trace_ring[i];
+    if (r->kind == AEAGLE_TRACE_TIME)
+    {
+      AEAGLE_TRACE_PRINTF("TIME,%s,%s,%lu," AEAGLE_TRACE_TS_FMT "," AEAGLE_TRACE_TS_FMT ",%s,%lu,%lu" AEAGLE_TRACE_EOL,
+                          r->phase, r->u.time.op, r->u.time.size,
+                          r->u.time.t_in, r->u.time.t_out, r->u.time.result,
+                          (unsigned long)r->u.time.alloc_cnt, (unsigned long)r->u.time.free_cnt);
+    }
+    else if (r->kind == AEAGLE_TRACE_SNAP)
+    {
+      AEAGLE_TRACE_PRINTF("SNAP,%s,%lu,%lu,%lu" AEAGLE_TRACE_EOL,
+                          r->phase, r->u.snap.free_bytes, r->u.snap.allocated_bytes,
+                          r->u.snap.max_allocated_bytes);
+    }
+  }
+  aeagle_trace_len = 0;
+  if (aeagle_trace_dropped)
+  {
+    AEAGLE_TRACE_PRINTF("META,trace_dropped,%lu" AEAGLE_TRACE_EOL, aeagle_trace_dropped);
+    aeagle_trace_dropped = 0;
+  }
+}
+
+/* The next free slot, or NULL (and one more dropped record) if full. */
+static inline struct aeagle_trace_rec *aeagle_trace_next(void)
+{
+  if (aeagle_trace_len == AEAGLE_TRACE_CAPACITY)
+  {
+    aeagle_trace_dropped++;
+    return NULL;
+  }
+  return &aeagle_trace_ring[aeagle_trace_len++];
+}
+
+#endif /* AEAGLE_WIRE */
+
+#ifdef AEAGLE_TRACE_HIST
+
+/* HDR-style buckets: durations below 2^SUB_BITS ticks are exact, and every
+ * power of two above is split into 2^SUB_BITS equal buckets, so a bucket is
+ * at most 1/2^SUB_BITS of its lower bound wide. Durations of 2^MAX_BITS
+ * ticks or more share the last bucket; min and max stay exact. The defaults
+ * give 176 counters (704 bytes) per histogram. */
+#ifndef AEAGLE_TRACE_HIST_SLOTS
+#define AEAGLE_TRACE_HIST_SLOTS 4
+#endif
+#ifndef AEAGLE_TRACE_HIST_SUB_BITS
+#define AEAGLE_TRACE_HIST_SUB_BITS 3
+#endif
+#ifndef AEAGLE_TRACE_HIST_MAX_BITS
+#define AEAGLE_TRACE_HIST_MAX_BITS 24
+#endif
+#define AEAGLE_TRACE_HIST_BUCKETS \
+  ((AEAGLE_TRACE_HIST_MAX_BITS - AEAGLE_TRACE_HIST_SUB_BITS + 1) << AEAGLE_TRACE_HIST_SUB_BITS)
+
+struct aeagle_trace_hist
+{
+  const char *phase;
+  const char *op;
+  unsigned long size;
+  uint32_t count;
+  AEAGLE_TRACE_TS_T min;
+  AEAGLE_TRACE_TS_T max;
+  uint32_t bucket[AEAGLE_TRACE_HIST_BUCKETS];
+};
+
+static struct aeagle_trace_hist aeagle_trace_hists[AEAGLE_TRACE_HIST_SLOTS];
+static size_t aeagle_trace_hist_len;
+
+static inline unsigned aeagle_trace_hist_index(AEAGLE_TRACE_TS_T d)
+{
+  uint32_t v;
+  unsigned group;
+
+  if (d >= ((AEAGLE_TRACE_TS_T)1 << AEAGLE_TRACE_HIST_MAX_BITS))
+  {
+    return AEAGLE_TRACE_HIST_BUCKETS - 1;
+  }
+  v = (uint32_t)d;
+  if (v < (1u << AEAGLE_TRACE_HIST_SUB_BITS))
+  {
+    return v;
+  }
+  /* v >> (group - 1) keeps the top SUB_BITS + 1 bits, leading 1 included. */
+  group = 32u - (unsigned)__builtin_clz(v) - AEAGLE_TRACE_HIST_SUB_BITS;
+  return (group << AEAGLE_TRACE_HIST_SUB_BITS) + (v >> (group - 1)) - (1u << AEAGLE_TRACE_HIST_SUB_BITS);
+}
+
+/* Smallest duration that lands in bucket i. */
+static unsigned long aeagle_trace_hist_lower(unsigned i)
+{
+  unsigned group = i >> AEAGLE_TRACE_HIST_SUB_BITS;
+  unsigned long sub = i & ((1u << AEAGLE_TRACE_HIST_SUB_BITS) - 1);
+
+  if (group == 0)
+  {
+    return sub;
+  }
+  return ((1ul << AEAGLE_TRACE_HIST_SUB_BITS) + sub) << (group - 1);
+}
+
+static inline int aeagle_trace_same(const char *a, const char *b)
+{
+  return a == b || strcmp(a, b) == 0;
+}
+
+/* The histogram for (phase, op, size), or NULL once all slots are taken. */
+static inline struct aeagle_trace_hist *aeagle_trace_hist_find(const char *phase, const char *op,
+                                                               unsigned long size)
+{
+  struct aeagle_trace_hist *h;
+
+  for (size_t i = 0; i < aeagle_trace_hist_len; ++i)
+  {
+    h = &aeagle_trace_hists[i];
+    if (h->size == size && aeagle_trace_same(h->phase, phase) && aeagle_trace_same(h->op, op))
+    {
+      return h;
+    }
+  }
+  if (aeagle_trace_hist_len == AEAGLE_TRACE_HIST_SLOTS)
+  {
+    return NULL;
+  }
+  h = &aeagle_trace_hists[aeagle_trace_hist_len++];
+  h->phase = phase;
+  h->op = op;
+  h->size = size;
+  return h;
+}
+
+/* Writes out the histograms as
+ *   HIST,<phase>,<op>,<size>,<count>,<min>,<max>,<sub_bits>,<lo>:<n>,...
+ * with one <lo>:<n> pair per non-empty bucket, <lo> being its lower bound. */
+static void aeagle_trace_hist_emit(void)
+{
+  for (size_t i = 0; i < aeagle_trace_hist_len; ++i)
+  {
+    const struct aeagle_trace_hist *h = &aeagle_trace_hists[i];
+    AEAGLE_TRACE_PRINTF("HIST,%s,%s,%lu,%lu," AEAGLE_TRACE_TS_FMT "," AEAGLE_TRACE_TS_FMT ",%u",
+                        h->phase, h->op, h->size, (unsigned long)h->count, h->min, h->max,
+                        (unsigned)AEAGLE_TRACE_HIST_SUB_BITS);
+    for (unsigned b = 0; b < AEAGLE_TRACE_HIST_BUCKETS; ++b)
+    {
+      if (h->bucket[b])
+      {
+        AEAGLE_TRACE_PRINTF(",%lu:%lu", aeagle_trace_hist_lower(b), (unsigned long)h->bucket[b]);
+      }
+    }
+    AEAGLE_TRACE_PRINTF(AEAGLE_TRACE_EOL);
+  }
+  aeagle_trace_hist_len = 0;
+  memset(aeagle_trace_hists, 0, sizeof(aeagle_trace_hists));
+}
+
+#endif /* AEAGLE_TRACE_HIST */
+
+/* Drains the ring and, in histogram mode, prints the histograms; call it
+ * once, right before the end banner. */
+static inline void aeagle_trace_finish(void)
+{
+  aeagle_trace_drain();
+#ifdef AEAGLE_TRACE_HIST
+  aeagle_trace_hist_emit();
+#endif
+}
+
+/* Both recorders are a bounds check and a handful of stores (a few varints
+ * with AEAGLE_WIRE); call them right after the second timestamp. */
+static inline void aeagle_trace_time(const char *phase, const char *op, unsigned long size,
+                                     AEAGLE_TRACE_TS_T t_in, AEAGLE_TRACE_TS_T t_out,
+                                     const char *result, uint32_t alloc_cnt, uint32_t free_cnt)
+{
+#ifdef AEAGLE_TRACE_HIST
+  if (strcmp(result, "OK") == 0)
+  {
+    struct aeagle_trace_hist *h = aeagle_trace_hist_find(phase, op, size);
+    if (h)
+    {
+      AEAGLE_TRACE_TS_T d = (AEAGLE_TRACE_TS_T)(t_out - t_in);
+      if (h->count == 0 || d < h->min)
+      {
+        h->min = d;
+      }
+      if (d > h->max)
+      {
+        h->max = d;
+      }
+      h->count++;
+      h->bucket[aeagle_trace_hist_index(d)]++;
+      return;
+    }
+  }
+#endif
+#ifdef AEAGLE_WIRE
+  if (!aeagle_wire_time(phase, op, result, size, t_in, t_out, alloc_cnt, free_cnt))
+  {
+    aeagle_trace_dropped++;
+  }
+#else
+  struct aeagle_trace_rec *r = aeagle_trace_next();
+  if (!r)
+  {
+    return;
+  }
+  r->kind = AEAGLE_TRACE_TIME;
+  r->phase = phase;
+  r->u.time.op = op;
+  r->u.time.result = result;
+  r->u.time.size = size;
+  r->u.time.t_in = t_in;
+  r->u.time.t_out = t_out;
+  r->u.time.alloc_cnt = alloc_cnt;
+  r->u.time.free_cnt = free_cnt;
+#endif
+}
+
+static inline void aeagle_trace_snap(const char *phase, unsigned long free_bytes,
+                                     unsigned long allocated_bytes, unsigned long max_allocated_bytes)
+{
+#ifdef AEAGLE_WIRE
+  if (!aeagle_wire_snap(phase, free_bytes, allocated_bytes, max_allocated_bytes))
+  {
+    aeagle_trace_dropped++;
+  }
+#else
+  struct aeagle_trace_rec *r = aeagle_trace_next();
+  if (!r)
+  {
+    return;
+  }
+  r->kind = AEAGLE_TRACE_SNAP;
+  r->phase = phase;
+  r->u.snap.free_bytes = free_bytes;
+  r->u.snap.allocated_bytes = allocated_bytes;
+  r->u.snap.max_allocated_bytes = max_allocated_bytes;
+#endif
+}
+
+#endif /* AEAGLE_TRACE_H */
@@ -0,0 +1,406 @@
+#ifndef AEAGLE_WIRE_H
+#define AEAGLE_WIRE_H
+
+/*
+ * Binary trace records for slow consoles (-DAEAGLE_WIRE).
+ *
+ * aeagle_trace.h hands its TIME and SNAP records to aeagle_wire_time() and
+ * aeagle_wire_snap(), which encode them straight into a byte ring, and
+ * aeagle_wire_flush() sends the ring as frames, each between two 0x00 bytes:
+ *
+ *   0x00, COBS(seq u16le, type u8, payload, crc u16le), 0x00
+ *
+ * COBS removes every 0x00 from the frame, so text lines (banners, META,
+ * FAULT) can share the console with frames, and the frame can be written
+ * with "%s". The CRC is CRC-16/CCITT-FALSE over everything before it. seq
+ * counts frames from 0, so the reader sees every frame it missed. Payload
+ * integers are LEB128 varints, signed ones zigzag-encoded:
+ *
+ *   HELLO  version, timestamp bits, AEAGLE_WIRE_BATCH  (once, first)
+ *   STR    id, bytes                         (names a string for later frames)
+ *   BATCH  records, up to AEAGLE_WIRE_BATCH bytes of them
+ *
+ * A record starts with a tag byte. SNAP (0x80): phase, free_bytes,
+ * allocated_bytes, max_allocated_bytes. TIME: the tag bits say which of
+ * phase (0x01), op (0x02), result (0x04) and size (0x08) changed since the
+ * previous TIME record and follow in that order; then t_in, alloc_cnt and
+ * free_cnt as signed deltas from the previous TIME record, and t_out - t_in.
+ * Every BATCH starts from zero and no fields, so its first TIME record is a
+ * keyframe with absolute values, and a lost frame costs only its own records.
+ *
+ * phase, op and result are STR ids. A string's STR frame goes out before
+ * the first BATCH that uses it. AEAgle.py's decoder turns the frames back
+ * into the CSV rows and reports lost and corrupt frames.
+ *
+ * Nothing is sent before aeagle_wire_flush(). A record that does not fit in
+ * the ring, or needs a new string once AEAGLE_WIRE_STRINGS ids are taken,
+ * is not written, and its recorder returns 0 so the caller can count it.
+ * In the latter case the ids start over after the next flush.
+ *
+ * Define AEAGLE_WIRE_PRINTF(...) before including this header.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef AEAGLE_WIRE_PRINTF
+#error "Define AEAGLE_WIRE_PRINTF(...) before including aeagle_wire.h"
+#endif
+
+/* Width of the timestamps; deltas wrap at it like the counter does. */
+#ifndef AEAGLE_WIRE_TS_BITS
+#define AEAGLE_WIRE_TS_BITS 64
+#endif
+
+/* Bytes of encoded records held until the next flush; a TIME record in a
+ * tight loop takes 5 to 8. */
+#ifndef AEAGLE_WIRE_RING
+#define AEAGLE_WIRE_RING 2048
+#endif
+
+#ifndef AEAGLE_WIRE_STRINGS
+#define AEAGLE_WIRE_STRINGS 32
+#endif
+
+/* Record bytes per BATCH frame. A frame then prints as at most 120
+ * characters, within the 128-byte line buffer of the FreeRTOS tests. */
+#ifndef AEAGLE_WIRE_BATCH
+#define AEAGLE_WIRE_BATCH 112
+#endif
+
+#define AEAGLE_WIRE_VERSION 3
+/* Largest record: tag, three ids, and five varints. */
+#define AEAGLE_WIRE_REC_MAX 44
+/* seq, type and CRC around the payload. */
+#define AEAGLE_WIRE_MAX (AEAGLE_WIRE_BATCH + 5)
+
+enum aeagle_wire_type
+{
+  AEAGLE_WIRE_HELLO,
+  AEAGLE_WIRE_STR,
+  AEAGLE_WIRE_BATCH_FRAME,
+};
+
+#define AEAGLE_WIRE_TAG_PHASE 0x01u
+#define AEAGLE_WIRE_TAG_OP 0x02u
+#define AEAGLE_WIRE_TAG_RESULT 0x04u
+#define AEAGLE_WIRE_TAG_SIZE 0x08u
+#define AEAGLE_WIRE_TAG_SNAP 0x80u
+
+/* Frame being built. */
+static uint8_t aeagle_wire_buf[AEAGLE_WIRE_MAX];
+static size_t aeagle_wire_len;
+static uint16_t aeagle_wire_seq;
+static uint8_t aeagle_wire_started;
+
+/* Encoded records, as segments of one length byte and up to
+ * AEAGLE_WIRE_BATCH bytes; each segment becomes one BATCH frame. */
+static uint8_t aeagle_wire_ring[AEAGLE_WIRE_RING];
+static size_t aeagle_wire_ring_len;
+static size_t aeagle_wire_seg;
+static uint8_t aeagle_wire_seg_open;
+
+/* Fields of the previous TIME record in the open segment. */
+static struct
+{
+  unsigned phase, op, result;
+  unsigned long size;
+  uint64_t t_in;
+  uint32_t alloc_cnt, free_cnt;
+} aeagle_wire_prev;
+
+static const char *aeagle_wire_strs[AEAGLE_WIRE_STRINGS];
+static unsigned aeagle_wire_nstrs;
+static unsigned aeagle_wire_announced;
+/* Set when a record found the table full; the next flush empties it. */
+static uint8_t aeagle_wire_strs_full;
+
+static void aeagle_wire_byte(uint8_t b)
+{
+  if (aeagle_wire_len < AEAGLE_WIRE_MAX)
+  {
+    aeagle_wire_buf[aeagle_wire_len++] = b;
+  }
+}
+
+static void aeagle_wire_uint(uint64_t v)
+{
+  while (v >= 0x80)
+  {
+    aeagle_wire_byte((uint8_t)(v | 0x80));
+    v >>= 7;
+  }
+  aeagle_wire_byte((uint8_t)v);
+}
+
+static uint16_t aeagle_wire_crc16(const uint8_t *p, size_t n)
+{
+  uint16_t crc = 0xFFFF;
+
+  while (n--)
+  {
+    crc ^= (uint16_t)(*p++ << 8);
+    for (int i = 0; i < 8; ++i)
+    {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+static void aeagle_wire_send(void)
+{
+  /* Frames stay under 254 bytes, so COBS adds exactly one code byte; one
+   * more for the NUL that "%s" needs. */
+  char out[AEAGLE_WIRE_MAX + 2];
+  size_t code_at = 0, o = 1;
+  uint8_t code = 1;
+  uint16_t crc = aeagle_wire_crc16(aeagle_wire_buf, aeagle_wire_len);
+
+  aeagle_wire_byte((uint8_t)crc);
+  aeagle_wire_byte((uint8_t)(crc >> 8));
+  for (size_t i = 0; i < aeagle_wire_len; ++i)
+  {
+    if (aeagle_wire_buf[i] == 0)
+    {
+      out[code_at] = (char)code;
+      code_at = o++;
+      code = 1;
+    }
+    else
+    {
+      out[o++] = (char)aeagle_wire_buf[i];
+      code++;
+    }
+  }
+  out[code_at] = (char)code;
+  out[o] = '\0';
+  AEAGLE_WIRE_PRINTF("%c%s%c", 0, out, 0);
+}
+
+static void aeagle_wire_begin(uint8_t type)
+{
+  if (!aeagle_wire_started)
+  {
+    aeagle_wire_started = 1;
+    aeagle_wire_begin(AEAGLE_WIRE_HELLO);
+    aeagle_wire_uint(AEAGLE_WIRE_VERSION);
+    aeagle_wire_uint(AEAGLE_WIRE_TS_BITS);
+    aeagle_wire_uint(AEAGLE_WIRE_BATCH);
+    aeagle_wire_send();
+  }
+  aeagle_wire_len = 0;
+  aeagle_wire_byte((uint8_t)aeagle_wire_seq);
+  aeagle_wire_byte((uint8_t)(aeagle_wire_seq >> 8));
+  aeagle_wire_byte(type);
+  aeagle_wire_seq++;
+}
+
+/* Sends the STR frames the reader is missing, then one BATCH frame per
+ * segment, and empties the ring. */
+static void aeagle_wire_flush(void)
+{
+  for (; aeagle_wire_announced < aeagle_wire_nstrs; ++aeagle_wire_announced)
+  {
+    const char *s = aeagle_wire_strs[aeagle_wire_announced];
+    size_t n = strlen(s);
+    if (n > AEAGLE_WIRE_BATCH - 2)
+    {
+      n = AEAGLE_WIRE_BATCH - 2;
+    }
+    aeagle_wire_begin(AEAGLE_WIRE_STR);
+    aeagle_wire_uint(aeagle_wire_announced);
+    for (size_t i = 0; i < n; ++i)
+    {
+      aeagle_wire_byte((uint8_t)s[i]);
+    }
+    aeagle_wire_send();
+  }
+
+  for (size_t at = 0; at < aeagle_wire_ring_len; at += 1u + aeagle_wire_ring[at])
+  {
+    aeagle_wire_begin(AEAGLE_WIRE_BATCH_FRAME);
+    for (size_t i = 0; i < aeagle_wire_ring[at]; ++i)
+    {
+      aeagle_wire_byte(aeagle_wire_ring[at + 1 + i]);
+    }
+    aeagle_wire_send();
+  }
+  aeagle_wire_ring_len = 0;
+  aeagle_wire_seg_open = 0;
+  if (aeagle_wire_strs_full)
+  {
+    aeagle_wire_nstrs = 0;
+    aeagle_wire_announced = 0;
+    aeagle_wire_strs_full = 0;
+  }
+}
+
+static int aeagle_wire_find(const char *s)
+{
+  for (unsigned id = 0; id < aeagle_wire_nstrs; ++id)
+  {
+    if (aeagle_wire_strs[id] == s || strcmp(aeagle_wire_strs[id], s) == 0)
+    {
+      return (int)id;
+    }
+  }
+  return -1;
+}
+
+/* Ids for up to three strings, all added to the table at once; 0 if it has
+ * no room for them, so the record must be dropped. */
+static int aeagle_wire_ids(const char *const *s, unsigned *id, unsigned n)
+{
+  unsigned missing = 0;
+
+  for (unsigned i = 0; i < n; ++i)
+  {
+    missing += aeagle_wire_find(s[i]) < 0;
+  }
+  if (aeagle_wire_nstrs + missing > AEAGLE_WIRE_STRINGS)
+  {
+    aeagle_wire_strs_full = 1;
+    return 0;
+  }
+  for (unsigned i = 0; i < n; ++i)
+  {
+    int found = aeagle_wire_find(s[i]);
+    if (found < 0)
+    {
+      found = (int)aeagle_wire_nstrs;
+      aeagle_wire_strs[aeagle_wire_nstrs++] = s[i];
+    }
+    id[i] = (unsigned)found;
+  }
+  return 1;
+}
+
+static void aeagle_wire_put(uint8_t b)
+{
+  aeagle_wire_ring[aeagle_wire_ring_len++] = b;
+}
+
+static void aeagle_wire_put_uint(uint64_t v)
+{
+  while (v >= 0x80)
+  {
+    aeagle_wire_put((uint8_t)(v | 0x80));
+    v >>= 7;
+  }
+  aeagle_wire_put((uint8_t)v);
+}
+
+/* cur - prev on a `bits`-wide counter, as a zigzag varint. */
+static void aeagle_wire_put_delta(uint64_t cur, uint64_t prev, unsigned bits)
+{
+  uint64_t d = cur - prev;
+  int64_t s;
+
+  if (bits < 64)
+  {
+    uint64_t sign = (uint64_t)1 << (bits - 1);
+    d &= (sign << 1) - 1;
+    d = (d ^ sign) - sign; /* sign-extend */
+  }
+  s = (int64_t)d;
+  aeagle_wire_put_uint(((uint64_t)s << 1) ^ (uint64_t)(s >> 63));
+}
+
+/* Room for one more record, in a segment that has room for it too; 0 if
+ * the ring is full. */
+static int aeagle_wire_reserve(void)
+{
+  if (aeagle_wire_ring_len + 1 + AEAGLE_WIRE_REC_MAX > AEAGLE_WIRE_RING)
+  {
+    return 0;
+  }
+  if (!aeagle_wire_seg_open ||
+      aeagle_wire_ring_len - aeagle_wire_seg - 1 + AEAGLE_WIRE_REC_MAX > AEAGLE_WIRE_BATCH)
+  {
+    aeagle_wire_seg = aeagle_wire_ring_len;
+    aeagle_wire_put(0);
+    aeagle_wire_seg_open = 1;
+    memset(&aeagle_wire_prev, 0, sizeof(aeagle_wire_prev));
+    /* Forces every field into the keyframe. */
+    aeagle_wire_prev.phase = aeagle_wire_prev.op = aeagle_wire_prev.result = ~0u;
+    aeagle_wire_prev.size = ~0ul;
+  }
+  return 1;
+}
+
+static void aeagle_wire_close_record(void)
+{
+  aeagle_wire_ring[aeagle_wire_seg] = (uint8_t)(aeagle_wire_ring_len - aeagle_wire_seg - 1);
+}
+
+static int aeagle_wire_time(const char *phase, const char *op, const char *result,
+                             unsigned long size, uint64_t t_in, uint64_t t_out,
+                            uint32_t alloc_cnt, uint32_t free_cnt)
+{
+  const char *s[3] = {phase, op, result};
+  unsigned id[3];
+  uint8_t tag = 0;
+  uint64_t ts_mask = ~(uint64_t)0 >> (64 - AEAGLE_WIRE_TS_BITS);
+
+  if (!aeagle_wire_ids(s, id, 3) || !aeagle_wire_reserve())
+  {
+    return 0;
+  }
+  tag |= id[0] != aeagle_wire_prev.phase ? AEAGLE_WIRE_TAG_PHASE : 0;
+  tag |= id[1] != aeagle_wire_prev.op ? AEAGLE_WIRE_TAG_OP : 0;
+  tag |= id[2] != aeagle_wire_prev.result ? AEAGLE_WIRE_TAG_RESULT : 0;
+  tag |= size != aeagle_wire_prev.size ? AEAGLE_WIRE_TAG_SIZE : 0;
+  aeagle_wire_put(tag);
+  if (tag & AEAGLE_WIRE_TAG_PHASE)
+  {
+    aeagle_wire_put_uint(id[0]);
+  }
+  if (tag & AEAGLE_WIRE_TAG_OP)
+  {
+    aeagle_wire_put_uint(id[1]);
+  }
+  if (tag & AEAGLE_WIRE_TAG_RESULT)
+  {
+    aeagle_wire_put_uint(id[2]);
+  }
+  if (tag & AEAGLE_WIRE_TAG_SIZE)
+  {
+    aeagle_wire_put_uint(size);
+  }
+  aeagle_wire_put_delta(t_in, aeagle_wire_prev.t_in, AEAGLE_WIRE_TS_BITS);
+  aeagle_wire_put_delta(alloc_cnt, aeagle_wire_prev.alloc_cnt, 32);
+  aeagle_wire_put_delta(free_cnt, aeagle_wire_prev.free_cnt, 32);
+  aeagle_wire_put_uint((t_out - t_in) & ts_mask);
+  aeagle_wire_close_record();
+
+  aeagle_wire_prev.phase = id[0];
+  aeagle_wire_prev.op = id[1];
+  aeagle_wire_prev.result = id[2];
+  aeagle_wire_prev.size = size;
+  aeagle_wire_prev.t_in = t_in;
+  aeagle_wire_prev.alloc_cnt = alloc_cnt;
+  aeagle_wire_prev.free_cnt = free_cnt;
+  return 1;
+}
+
+static int aeagle_wire_snap(const char *phase, unsigned long free_bytes,
+                            unsigned long allocated_bytes, unsigned long max_allocated_bytes)
+{
+  unsigned id;
+
+  if (!aeagle_wire_ids(&phase, &id, 1) || !aeagle_wire_reserve())
+  {
+    return 0;
+  }
+  aeagle_wire_put(AEAGLE_WIRE_TAG_SNAP);
+  aeagle_wire_put_uint(id);
+  aeagle_wire_put_uint(free_bytes);
+  aeagle_wire_put_uint(allocated_bytes);
+  aeagle_wire_put_uint(max_allocated_bytes);
+  aeagle_wire_close_record();
+  return 1;
+}
+
+#endif /* AEAGLE_WIRE_H */
@@ -5,49 +5,30 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include "aeagle_log.h"
+#include "aeagle_heapstat.h"
 
 #define ALLOCATOR_NAME "contiki-heapmem"
 #define TEST_NAME "DoubleFree"
 #define BLOCK_SIZE 128
 
-#define PRINTF_LOG_CONTIKI(format, ...) printf(format, ##__VA_ARGS__)
-
-#define LOG_TEST_START(alloc_name, test_name_str) \
-  PRINTF_LOG_CONTIKI("# %s %s start\r\n", (alloc_name), (test_name_str))
-
-#define LOG_TEST_END(alloc_name, test_name_str) \
-  PRINTF_LOG_CONTIKI("# %s %s end\r\n", (alloc_name), (test_name_str))
-
-#define LOG_META_CONTIKI(tick_hz_val) \
-  PRINTF_LOG_CONTIKI("META,tick_hz,%u\r\n", (unsigned)(tick_hz_val))
-
-#define LOG_TIME_CONTIKI(phase_str, op_str, size_val, time_in, time_out, result_str, ac, fc) \
-  PRINTF_LOG_CONTIKI("TIME,%s,%s,%u,%lu,%lu,%s,%lu,%lu\r\n",                                 \
-                     (phase_str), (op_str), (unsigned)(size_val),                            \
-                     (unsigned long)(time_in), (unsigned long)(time_out), (result_str),      \
-                     (unsigned long)(ac), (unsigned long)(fc))
-
-#define LOG_SNAP_CONTIKI(phase_str, free_b_val, allocated_b_val, max_alloc_b_val) \
-  PRINTF_LOG_CONTIKI("SNAP,%s,%lu,%lu,%lu\r\n",                                   \
-                     (phase_str), (unsigned long)(free_b_val),                    \
-                     (unsigned long)(allocated_b_val), (unsigned long)(max_alloc_b_val))
-
-#define LOG_FAULT_CONTIKI(current_ticks, error_str) \
-  PRINTF_LOG_CONTIKI("FAULT,%lu,0xDEAD,%s\r\n", (unsigned long)(current_ticks), (error_str))
-
 static uint32_t alloc_cnt = 0, free_cnt = 0;
 
 static unsigned long max_observed_allocated_bytes_heapmem = 0;
 static void emit_snapshot_contiki_heapmem(const char *phase)
 {
-  heapmem_stats_t stats;
-  heapmem_stats(&stats);
-
-  if (stats.allocated > max_observed_allocated_bytes_heapmem)
+  if (AEAGLE_HEAPSTAT_CHECK)
   {
-    max_observed_allocated_bytes_heapmem = stats.allocated;
+    heapmem_stats_t stats;
+    heapmem_stats(&stats);
+
+    if (stats.allocated > max_observed_allocated_bytes_heapmem)
+    {
+      max_observed_allocated_bytes_heapmem = stats.allocated;
+    }
+    AEAGLE_LOG_HEAP(phase, stats.available, stats.allocated, max_observed_allocated_bytes_heapmem);
   }
-  LOG_SNAP_CONTIKI(phase, stats.available, stats.allocated, max_observed_allocated_bytes_heapmem);
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
 }
 
 PROCESS(double_free_test, "Double Free Test");
@@ -56,7 +37,7 @@ AUTOSTART_PROCESSES(&double_free_test);
 PROCESS_THREAD(double_free_test, ev, data)
 {
   static void *p = NULL;
-  static rtimer_clock_t tin, tout;
+  static aeagle_ts_t tin, tout;
 
   PROCESS_BEGIN();
 
@@ -64,42 +45,46 @@ PROCESS_THREAD(double_free_test, ev, data)
   free_cnt = 0;
   max_observed_allocated_bytes_heapmem = 0;
 
-  LOG_TEST_START(ALLOCATOR_NAME, TEST_NAME);
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
 
-    LOG_META_CONTIKI(RTIMER_SECOND);
+    aeagle_timer_init();
+    AEAGLE_LOG_META();
+    aeagle_heapstat_init(HEAPMEM_CONF_ARENA_SIZE);
 
   emit_snapshot_contiki_heapmem("baseline");
 
-  tin = RTIMER_NOW();
+  tin = aeagle_timer_now();
   p = heapmem_alloc(BLOCK_SIZE);
-  tout = RTIMER_NOW();
+  tout = aeagle_timer_now();
 
   if (p == NULL)
   {
-    LOG_TIME_CONTIKI("setup", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
-    LOG_FAULT_CONTIKI(RTIMER_NOW(), "OOM");
+    AEAGLE_LOG_TIME("setup", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
     goto done_label;
   }
   alloc_cnt++;
+  aeagle_heapstat_alloc(BLOCK_SIZE);
 
-  LOG_TIME_CONTIKI("setup", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+  AEAGLE_LOG_TIME("setup", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
   emit_snapshot_contiki_heapmem("after_setup");
 
-  tin = RTIMER_NOW();
+  tin = aeagle_timer_now();
   heapmem_free(p);
-  tout = RTIMER_NOW();
+  tout = aeagle_timer_now();
   free_cnt++;
+  aeagle_heapstat_free(BLOCK_SIZE);
 
-  LOG_TIME_CONTIKI("setup", "free", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+  AEAGLE_LOG_TIME("setup", "free", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
   emit_snapshot_contiki_heapmem("after_first_free");
 
-  tin = RTIMER_NOW();
+  tin = aeagle_timer_now();
   heapmem_free(p);
-  tout = RTIMER_NOW();
-  LOG_TIME_CONTIKI("df_trigger", "free", BLOCK_SIZE, tin, tout, "DF_ATTEMPT", alloc_cnt, free_cnt);
+  tout = aeagle_timer_now();
+  AEAGLE_LOG_TIME("df_trigger", "free", BLOCK_SIZE, tin, tout, "DF_ATTEMPT", alloc_cnt, free_cnt);
   emit_snapshot_contiki_heapmem("post_primitive_trigger");
 
 done_label:
-  LOG_TEST_END(ALLOCATOR_NAME, TEST_NAME);
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
   PROCESS_END();
 }
\ No newline at end of file
@@ -13,44 +13,28 @@
 #define BURST_ROUNDS 10
 #define BURST_COUNT 10
 
-#define PRINTF_LOG_CONTIKI(format, ...) printf(format, ##__VA_ARGS__)
-
-#define LOG_TEST_START(alloc_name, test_name_str) \
-    PRINTF_LOG_CONTIKI("# %s %s start\r\n", (alloc_name), (test_name_str))
-
-#define LOG_TEST_END(alloc_name, test_name_str) \
-    PRINTF_LOG_CONTIKI("# %s %s end\r\n", (alloc_name), (test_name_str))
-
-#define LOG_META_CONTIKI(tick_hz_val) \
-    PRINTF_LOG_CONTIKI("META,tick_hz,%u\r\n", (unsigned)(tick_hz_val))
-
-#define LOG_TIME_CONTIKI(phase_str, op_str, size_val, time_in, time_out, result_str, ac, fc) \
-    PRINTF_LOG_CONTIKI("TIME,%s,%s,%u,%lu,%lu,%s,%lu,%lu\r\n",                               \
-                       (phase_str), (op_str), (unsigned)(size_val),                          \
-                       (unsigned long)(time_in), (unsigned long)(time_out), (result_str),    \
-                       (unsigned long)(ac), (unsigned long)(fc))
-
-#define LOG_SNAP_CONTIKI(phase_str, free_b_val, allocated_b_val, max_alloc_b_val) \
-    PRINTF_LOG_CONTIKI("SNAP,%s,%lu,%lu,%lu\r\n",                                 \
-                       (phase_str), (unsigned long)(free_b_val),                  \
-                       (unsigned long)(allocated_b_val), (unsigned long)(max_alloc_b_val))
-
-#define LOG_FAULT_CONTIKI(current_ticks, error_str) \
-    PRINTF_LOG_CONTIKI("FAULT,%lu,0xDEAD,%s\r\n", (unsigned long)(current_ticks), (error_str))
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
 
 static uint32_t alloc_cnt = 0;
 static uint32_t free_cnt = 0;
 static unsigned long max_observed_allocated_bytes_heapmem = 0;
 static void emit_snapshot_contiki_heapmem(const char *phase)
 {
-    heapmem_stats_t stats;
-    heapmem_stats(&stats);
-
-    if (stats.allocated > max_observed_allocated_bytes_heapmem)
+    aeagle_trace_drain();
+    if (AEAGLE_HEAPSTAT_CHECK)
     {
-        max_observed_allocated_bytes_heapmem = stats.allocated;
+        heapmem_stats_t stats;
+        heapmem_stats(&stats);
+
+        if (stats.allocated > max_observed_allocated_bytes_heapmem)
+        {
+            max_observed_allocated_bytes_heapmem = stats.allocated;
+        }
+        AEAGLE_LOG_HEAP(phase, stats.available, stats.allocated, max_observed_allocated_bytes_heapmem);
     }
-    LOG_SNAP_CONTIKI(phase, stats.available, stats.allocated, max_observed_allocated_bytes_heapmem);
+    AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
 }
 
 PROCESS(mixed_lifetime_test, "Mixed Lifetime Test");
@@ -60,7 +44,7 @@ PROCESS_THREAD(mixed_lifetime_test, ev, data)
 {
     static void *pinned[PIN_COUNT];
     static void *buf[BURST_COUNT];
-    static rtimer_clock_t tin, tout, t_cleanup_in, t_cleanup_out;
+    static aeagle_ts_t tin, tout, t_cleanup_in, t_cleanup_out;
     static int i, round_idx, j_idx;
     static char snap_phase_label[64];
     static int successfully_pinned = 0;
@@ -78,25 +62,32 @@ PROCESS_THREAD(mixed_lifetime_test, ev, data)
     for (i = 0; i < BURST_COUNT; ++i)
         buf[i] = NULL;
 
-    LOG_TEST_START(ALLOCATOR_NAME, TEST_NAME);
+    AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
 
-        LOG_META_CONTIKI(RTIMER_SECOND);
+        aeagle_timer_init();
+        AEAGLE_LOG_META();
+        aeagle_heapstat_init(HEAPMEM_CONF_ARENA_SIZE);
 
     emit_snapshot_contiki_heapmem("baseline");
 
     for (i = 0; i < PIN_COUNT; ++i)
     {
-        tin = RTIMER_NOW();
+        tin = aeagle_timer_now();
         pinned[i] = heapmem_alloc(BLOCK_SIZE * 2);
-        tout = RTIMER_NOW();
+        tout = aeagle_timer_now();
         if (!pinned[i])
         {
-            LOG_TIME_CONTIKI("pin", "malloc", BLOCK_SIZE * 2, tin, tout, "NULL", alloc_cnt, free_cnt);
-            LOG_FAULT_CONTIKI(RTIMER_NOW(), "OOM");
+            AEAGLE_LOG_TIME_DEFERRED("pin", "malloc", BLOCK_SIZE * 2, tin, tout, "NULL", alloc_cnt, free_cnt);
+            aeagle_trace_drain();
+            AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
             goto cleanup_logic;
         }
         alloc_cnt++;
-        LOG_TIME_CONTIKI("pin", "malloc", BLOCK_SIZE * 2, tin, tout, "OK", alloc_cnt, free_cnt);
+        aeagle_heapstat_alloc(BLOCK_SIZE * 2);
+        if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+        {
+            AEAGLE_LOG_TIME_DEFERRED("pin", "malloc", BLOCK_SIZE * 2, tin, tout, "OK", alloc_cnt, free_cnt);
+        }
         successfully_pinned++;
     }
     emit_snapshot_contiki_heapmem("after_pins");
@@ -106,18 +97,23 @@ PROCESS_THREAD(mixed_lifetime_test, ev, data)
         current_burst_successful_allocs = 0;
         for (i = 0; i < BURST_COUNT; ++i)
         {
-            tin = RTIMER_NOW();
+            tin = aeagle_timer_now();
             buf[i] = heapmem_alloc(BLOCK_SIZE);
-            tout = RTIMER_NOW();
+            tout = aeagle_timer_now();
             if (!buf[i])
             {
-                LOG_TIME_CONTIKI("burst", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
-                LOG_FAULT_CONTIKI(RTIMER_NOW(), "OOM");
+                AEAGLE_LOG_TIME_DEFERRED("burst", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
+                aeagle_trace_drain();
+                AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
                 goto cleanup_logic;
             }
             alloc_cnt++;
+            aeagle_heapstat_alloc(BLOCK_SIZE);
 
-            LOG_TIME_CONTIKI("burst", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+            if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+            {
+                AEAGLE_LOG_TIME_DEFERRED("burst", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+            }
             current_burst_successful_allocs++;
         }
 
@@ -126,12 +122,16 @@ PROCESS_THREAD(mixed_lifetime_test, ev, data)
 
         for (j_idx = current_burst_successful_allocs - 1; j_idx >= 0; --j_idx)
         {
-            tin = RTIMER_NOW();
+            tin = aeagle_timer_now();
             heapmem_free(buf[j_idx]);
-            tout = RTIMER_NOW();
+            tout = aeagle_timer_now();
             free_cnt++;
+            aeagle_heapstat_free(BLOCK_SIZE);
 
-            LOG_TIME_CONTIKI("burst", "free", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+            if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+            {
+                AEAGLE_LOG_TIME_DEFERRED("burst", "free", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+            }
             buf[j_idx] = NULL;
         }
         snprintf(snap_phase_label, sizeof(snap_phase_label), "after_burst_free_%02d", round_idx);
@@ -143,16 +143,21 @@ cleanup_logic:
     {
         if (pinned[i] != NULL)
         {
-            t_cleanup_in = RTIMER_NOW();
+            t_cleanup_in = aeagle_timer_now();
             heapmem_free(pinned[i]);
-            t_cleanup_out = RTIMER_NOW();
+            t_cleanup_out = aeagle_timer_now();
             pinned[i] = NULL;
             free_cnt++;
-            LOG_TIME_CONTIKI("cleanup", "free", BLOCK_SIZE * 2, t_cleanup_in, t_cleanup_out, "OK", alloc_cnt, free_cnt);
+            aeagle_heapstat_free(BLOCK_SIZE * 2);
+            if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+            {
+                AEAGLE_LOG_TIME_DEFERRED("cleanup", "free", BLOCK_SIZE * 2, t_cleanup_in, t_cleanup_out, "OK", alloc_cnt, free_cnt);
+            }
         }
     }
     emit_snapshot_contiki_heapmem("post_cleanup");
 
-    LOG_TEST_END(ALLOCATOR_NAME, TEST_NAME);
+    aeagle_trace_finish();
+    AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
     PROCESS_END();
 }
\ No newline at end of file
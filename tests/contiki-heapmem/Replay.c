@@ -0,0 +1,152 @@
+#include "contiki.h"
+#include "sys/rtimer.h"
+#include "lib/heapmem.h"
+#include "sys/cc.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define ALLOCATOR_NAME "contiki-heapmem"
+#define TEST_NAME "Replay"
+
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
+#include "aeagle_replay.h"
+
+static uint32_t alloc_cnt = 0;
+static uint32_t free_cnt = 0;
+static unsigned long max_observed_allocated_bytes_heapmem = 0;
+static void emit_snapshot_contiki_heapmem(const char *phase)
+{
+    aeagle_trace_drain();
+    if (AEAGLE_HEAPSTAT_CHECK)
+    {
+        heapmem_stats_t stats;
+        heapmem_stats(&stats);
+
+        if (stats.allocated > max_observed_allocated_bytes_heapmem)
+        {
+            max_observed_allocated_bytes_heapmem = stats.allocated;
+        }
+        AEAGLE_LOG_HEAP(phase, stats.available, stats.allocated, max_observed_allocated_bytes_heapmem);
+    }
+    AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+/* The live object of every trace slot, and the size it was asked for. */
+static void *objs[AEAGLE_REPLAY_MAX_OBJECTS];
+static uint32_t obj_size[AEAGLE_REPLAY_MAX_OBJECTS];
+
+PROCESS(replay_test, "Replay Test");
+AUTOSTART_PROCESSES(&replay_test);
+
+PROCESS_THREAD(replay_test, ev, data)
+{
+    static struct aeagle_replay r;
+    static struct aeagle_replay_rec rec;
+    static aeagle_ts_t tin, tout;
+    static uint32_t skipped, i;
+    static int rc;
+    static void *p;
+
+    PROCESS_BEGIN();
+
+    alloc_cnt = 0;
+    free_cnt = 0;
+    skipped = 0;
+
+    AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+    aeagle_timer_init();
+    AEAGLE_LOG_META();
+    aeagle_heapstat_init(HEAPMEM_CONF_ARENA_SIZE);
+
+    emit_snapshot_contiki_heapmem("baseline");
+
+    if (aeagle_replay_open(&r, aeagle_replay_trace, sizeof(aeagle_replay_trace), NULL,
+                           AEAGLE_REPLAY_MAX_OBJECTS) != 0)
+    {
+        AEAGLE_LOG_FAULT(aeagle_timer_now(), "REPLAY_TRACE");
+        goto done;
+    }
+
+    while ((rc = aeagle_replay_next(&r, &rec)) > 0)
+    {
+        if (rec.op == AEAGLE_REPLAY_MALLOC)
+        {
+            if (objs[rec.id] != NULL)
+            {
+                skipped++;
+                continue;
+            }
+            tin = aeagle_timer_now();
+            p = heapmem_alloc(rec.size);
+            tout = aeagle_timer_now();
+            if (!p)
+            {
+                AEAGLE_LOG_TIME_DEFERRED("replay", "malloc", rec.size, tin, tout, "NULL", alloc_cnt, free_cnt);
+                continue;
+            }
+            objs[rec.id] = p;
+            obj_size[rec.id] = rec.size;
+            alloc_cnt++;
+            aeagle_heapstat_alloc(rec.size);
+            if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+            {
+                AEAGLE_LOG_TIME_DEFERRED("replay", "malloc", rec.size, tin, tout, "OK", alloc_cnt, free_cnt);
+            }
+        }
+        else
+        {
+            /* The malloc of this slot failed here. */
+            if (objs[rec.id] == NULL)
+            {
+                skipped++;
+                continue;
+            }
+            tin = aeagle_timer_now();
+            heapmem_free(objs[rec.id]);
+            tout = aeagle_timer_now();
+            objs[rec.id] = NULL;
+            free_cnt++;
+            aeagle_heapstat_free(obj_size[rec.id]);
+            if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+            {
+                AEAGLE_LOG_TIME_DEFERRED("replay", "free", obj_size[rec.id], tin, tout, "OK", alloc_cnt, free_cnt);
+            }
+        }
+    }
+    if (rc < 0)
+    {
+        aeagle_trace_drain();
+        AEAGLE_LOG_FAULT(aeagle_timer_now(), "REPLAY_TRACE");
+    }
+    emit_snapshot_contiki_heapmem("after_replay");
+
+    /* Whatever the trace leaves live. */
+    for (i = 0; i < r.objects; i++)
+    {
+        if (objs[i] == NULL)
+        {
+            continue;
+        }
+        tin = aeagle_timer_now();
+        heapmem_free(objs[i]);
+        tout = aeagle_timer_now();
+        objs[i] = NULL;
+        free_cnt++;
+        aeagle_heapstat_free(obj_size[i]);
+        if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+        {
+            AEAGLE_LOG_TIME_DEFERRED("cleanup", "free", obj_size[i], tin, tout, "OK", alloc_cnt, free_cnt);
+        }
+    }
+    emit_snapshot_contiki_heapmem("post_cleanup");
+
+done:
+    AEAGLE_LOG_META_VALUE("replay_records", r.records);
+    AEAGLE_LOG_META_VALUE("replay_skipped", skipped);
+    aeagle_trace_finish();
+    AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
+    PROCESS_END();
+}
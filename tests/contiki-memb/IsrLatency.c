@@ -0,0 +1,177 @@
+#include "contiki.h"
+#include "sys/rtimer.h"
+#include "lib/memb.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define ALLOCATOR_NAME "contiki-memb"
+#define TEST_NAME "IsrLatency"
+#define BLOCK_SIZE 128
+#define TOTAL_BLOCKS 64
+
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
+#include "aeagle_isr.h"
+
+struct block
+{
+  uint8_t data[BLOCK_SIZE];
+};
+
+MEMB(test_mem, struct block, TOTAL_BLOCKS);
+
+static unsigned long max_allocated_bytes_contiki_memb = 0;
+
+static void emit_snapshot_contiki_memb(const char *phase)
+{
+  aeagle_trace_drain();
+  if (AEAGLE_HEAPSTAT_CHECK)
+  {
+    unsigned int free_blocks = memb_numfree(&test_mem);
+    unsigned int used_blocks = TOTAL_BLOCKS - free_blocks;
+    unsigned long current_allocated_bytes = (unsigned long)used_blocks * BLOCK_SIZE;
+    unsigned long current_free_bytes = (unsigned long)free_blocks * BLOCK_SIZE;
+
+    if (current_allocated_bytes > max_allocated_bytes_contiki_memb)
+    {
+      max_allocated_bytes_contiki_memb = current_allocated_bytes;
+    }
+    AEAGLE_LOG_HEAP(phase, current_free_bytes, current_allocated_bytes, max_allocated_bytes_contiki_memb);
+  }
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+/* memb has no lock, so test_mem cannot be shared with an interrupt: the
+ * rtimer takes its block from a memb of its own. */
+struct isr_block
+{
+  uint8_t data[AEAGLE_ISR_SIZE];
+};
+
+MEMB(isr_mem, struct isr_block, 2);
+
+#define ISR_PERIOD ((rtimer_clock_t)((uint64_t)RTIMER_SECOND * AEAGLE_ISR_PERIOD_US / 1000000u))
+
+static struct rtimer isr_timer;
+
+/* The rtimer callback, in its interrupt. Re-armed against its own deadline
+ * while a phase samples, so the schedule does not drift. */
+static void isr_tick(struct rtimer *t, void *ptr)
+{
+  struct aeagle_isr_sample *s = aeagle_isr_enter(aeagle_timer_now());
+  void *p;
+
+  (void)ptr;
+  if (s == NULL)
+  {
+    return;
+  }
+  rtimer_set(t, t->time + ISR_PERIOD, 1, isr_tick, NULL);
+  if (aeagle_isr_block == NULL)
+  {
+    s->t_in = aeagle_timer_now();
+    p = memb_alloc(&isr_mem);
+    s->t_out = aeagle_timer_now();
+    s->op = AEAGLE_ISR_MALLOC;
+    s->ok = p != NULL;
+    aeagle_isr_block = p;
+  }
+  else
+  {
+    s->t_in = aeagle_timer_now();
+    memb_free(&isr_mem, aeagle_isr_block);
+    s->t_out = aeagle_timer_now();
+    s->op = AEAGLE_ISR_FREE;
+    s->ok = 1;
+    aeagle_isr_block = NULL;
+  }
+  aeagle_isr_leave();
+}
+
+/* The process's side of a phase, until the ISR has its samples; returns the
+ * heap calls made. It never yields: the rtimer interrupt is all that runs. */
+static uint32_t isr_background(unsigned phase)
+{
+  void *held[AEAGLE_ISR_HOLD] = {0};
+  uint32_t held_size[AEAGLE_ISR_HOLD];
+  aeagle_ts_t start = aeagle_timer_now();
+  uint32_t calls = 0, h;
+
+  while (aeagle_isr_pending(start))
+  {
+    if (phase == AEAGLE_ISR_IDLE)
+    {
+      continue;
+    }
+    h = calls % AEAGLE_ISR_HOLD;
+    if (held[h] == NULL)
+    {
+      held_size[h] = aeagle_isr_sizes[(calls / AEAGLE_ISR_HOLD) % 4];
+      held[h] = memb_alloc(&test_mem);
+      if (held[h] != NULL)
+      {
+        aeagle_heapstat_alloc(held_size[h]);
+      }
+    }
+    else
+    {
+      memb_free(&test_mem, held[h]);
+      aeagle_heapstat_free(held_size[h]);
+      held[h] = NULL;
+    }
+    calls++;
+  }
+  for (h = 0; h < AEAGLE_ISR_HOLD; h++)
+  {
+    if (held[h] != NULL)
+    {
+      memb_free(&test_mem, held[h]);
+      aeagle_heapstat_free(held_size[h]);
+    }
+  }
+  return calls;
+}
+
+PROCESS(isr_latency_test, "ISR Latency Test");
+AUTOSTART_PROCESSES(&isr_latency_test);
+
+PROCESS_THREAD(isr_latency_test, ev, data)
+{
+  static unsigned phase;
+  static uint32_t calls;
+
+  PROCESS_BEGIN();
+
+  calls = 0;
+  memb_init(&isr_mem);
+  memb_init(&test_mem);
+
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  AEAGLE_LOG_META_VALUE("isr_period_us", AEAGLE_ISR_PERIOD_US);
+  aeagle_heapstat_init(TOTAL_BLOCKS * BLOCK_SIZE);
+
+  emit_snapshot_contiki_memb("baseline");
+
+  for (phase = 0; phase < AEAGLE_ISR_PHASES; phase++)
+  {
+    aeagle_isr_begin();
+    rtimer_set(&isr_timer, RTIMER_NOW() + ISR_PERIOD, 1, isr_tick, NULL);
+    calls += isr_background(phase);
+    /* The rtimer fires once more and, outside the phase, stops. */
+    if (aeagle_isr_block != NULL)
+    {
+      memb_free(&isr_mem, aeagle_isr_block);
+      aeagle_isr_block = NULL;
+    }
+    emit_snapshot_contiki_memb(aeagle_isr_snaps[phase]);
+    aeagle_isr_report(phase);
+  }
+  AEAGLE_LOG_META_VALUE("isr_churn_calls", calls);
+
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
+  PROCESS_END();
+}
@@ -10,30 +10,9 @@
 #define BLOCK_COUNT 256
 #define BLOCK_SIZE 128
 
-#define PRINTF_LOG_CONTIKI(format, ...) printf(format, ##__VA_ARGS__)
-
-#define LOG_TEST_START(alloc_name, test_name_str) \
-  PRINTF_LOG_CONTIKI("# %s %s start\r\n", (alloc_name), (test_name_str))
-
-#define LOG_TEST_END(alloc_name, test_name_str) \
-  PRINTF_LOG_CONTIKI("# %s %s end\r\n", (alloc_name), (test_name_str))
-
-#define LOG_META_CONTIKI(tick_hz_val) \
-  PRINTF_LOG_CONTIKI("META,tick_hz,%u\r\n", (unsigned)(tick_hz_val))
-
-#define LOG_TIME_CONTIKI(phase_str, op_str, size_val, time_in, time_out, result_str, ac, fc) \
-  PRINTF_LOG_CONTIKI("TIME,%s,%s,%u,%lu,%lu,%s,%lu,%lu\r\n",                                 \
-                     (phase_str), (op_str), (unsigned)(size_val),                            \
-                     (unsigned long)(time_in), (unsigned long)(time_out), (result_str),      \
-                     (unsigned long)(ac), (unsigned long)(fc))
-
-#define LOG_SNAP_CONTIKI(phase_str, free_b_val, allocated_b_val, max_alloc_b_val) \
-  PRINTF_LOG_CONTIKI("SNAP,%s,%lu,%lu,%lu\r\n",                                   \
-                     (phase_str), (unsigned long)(free_b_val),                    \
-                     (unsigned long)(allocated_b_val), (unsigned long)(max_alloc_b_val))
-
-#define LOG_FAULT_CONTIKI(current_ticks, error_str) \
-  PRINTF_LOG_CONTIKI("FAULT,%lu,0xDEAD,%s\r\n", (unsigned long)(current_ticks), (error_str))
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
 
 struct block
 {
@@ -48,16 +27,21 @@ static unsigned long max_allocated_bytes_contiki_memb = 0;
 
 static void emit_snapshot_contiki_memb(const char *phase)
 {
-  unsigned int free_blocks = memb_numfree(&test_mem);
-  unsigned int used_blocks = BLOCK_COUNT - free_blocks;
-  unsigned long current_allocated_bytes = (unsigned long)used_blocks * BLOCK_SIZE;
-  unsigned long current_free_bytes = (unsigned long)free_blocks * BLOCK_SIZE;
-
-  if (current_allocated_bytes > max_allocated_bytes_contiki_memb)
+  if (AEAGLE_HEAPSTAT_CHECK)
   {
-    max_allocated_bytes_contiki_memb = current_allocated_bytes;
+    aeagle_trace_drain();
+    unsigned int free_blocks = memb_numfree(&test_mem);
+    unsigned int used_blocks = BLOCK_COUNT - free_blocks;
+    unsigned long current_allocated_bytes = (unsigned long)used_blocks * BLOCK_SIZE;
+    unsigned long current_free_bytes = (unsigned long)free_blocks * BLOCK_SIZE;
+
+    if (current_allocated_bytes > max_allocated_bytes_contiki_memb)
+    {
+      max_allocated_bytes_contiki_memb = current_allocated_bytes;
+    }
+    AEAGLE_LOG_HEAP(phase, current_free_bytes, current_allocated_bytes, max_allocated_bytes_contiki_memb);
   }
-  LOG_SNAP_CONTIKI(phase, current_free_bytes, current_allocated_bytes, max_allocated_bytes_contiki_memb);
+  AEAGLE_LOG_SNAP_DEFERRED(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
 }
 
 PROCESS(leak_exhaust_test, "Leak Exhaust Test");
@@ -66,36 +50,47 @@ AUTOSTART_PROCESSES(&leak_exhaust_test);
 PROCESS_THREAD(leak_exhaust_test, ev, data)
 {
   static struct block *p;
-  static rtimer_clock_t tin, tout;
+  static aeagle_ts_t tin, tout;
 
   PROCESS_BEGIN();
 
-  LOG_TEST_START(ALLOCATOR_NAME, TEST_NAME);
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
 
-  LOG_META_CONTIKI(RTIMER_SECOND);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  aeagle_heapstat_init(BLOCK_COUNT * BLOCK_SIZE);
 
   memb_init(&test_mem);
   emit_snapshot_contiki_memb("baseline");
 
   while (1)
   {
-    tin = RTIMER_NOW();
+    tin = aeagle_timer_now();
     p = memb_alloc(&test_mem);
-    tout = RTIMER_NOW();
+    tout = aeagle_timer_now();
 
     if (p == NULL)
     {
-      LOG_TIME_CONTIKI("leakloop", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
-      LOG_FAULT_CONTIKI(RTIMER_NOW(), "OOM");
+      AEAGLE_LOG_TIME_DEFERRED("leakloop", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
+      aeagle_trace_drain();
+      AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
       break;
     }
     alloc_cnt++;
-    LOG_TIME_CONTIKI("leakloop", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
-    emit_snapshot_contiki_memb("after_alloc");
+    aeagle_heapstat_alloc(BLOCK_SIZE);
+    if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+    {
+      AEAGLE_LOG_TIME_DEFERRED("leakloop", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+    }
+    if (AEAGLE_LOG_SNAP_DUE(alloc_cnt))
+    {
+      emit_snapshot_contiki_memb("after_alloc");
+    }
   }
 
   emit_snapshot_contiki_memb("after_leakloop_exhaustion");
 
-  LOG_TEST_END(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_trace_finish();
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
   PROCESS_END();
 }
\ No newline at end of file
@@ -13,30 +13,9 @@
 #define BURST_COUNT 10
 #define TOTAL_BLOCKS (PIN_COUNT + BURST_COUNT)
 
-#define PRINTF_LOG_CONTIKI(format, ...) printf(format, ##__VA_ARGS__)
-
-#define LOG_TEST_START(alloc_name, test_name_str) \
-  PRINTF_LOG_CONTIKI("# %s %s start\r\n", (alloc_name), (test_name_str))
-
-#define LOG_TEST_END(alloc_name, test_name_str) \
-  PRINTF_LOG_CONTIKI("# %s %s end\r\n", (alloc_name), (test_name_str))
-
-#define LOG_META_CONTIKI(tick_hz_val) \
-  PRINTF_LOG_CONTIKI("META,tick_hz,%u\r\n", (unsigned)(tick_hz_val))
-
-#define LOG_TIME_CONTIKI(phase_str, op_str, size_val, time_in, time_out, result_str, ac, fc) \
-  PRINTF_LOG_CONTIKI("TIME,%s,%s,%u,%lu,%lu,%s,%lu,%lu\r\n",                                 \
-                     (phase_str), (op_str), (unsigned)(size_val),                            \
-                     (unsigned long)(time_in), (unsigned long)(time_out), (result_str),      \
-                     (unsigned long)(ac), (unsigned long)(fc))
-
-#define LOG_SNAP_CONTIKI(phase_str, free_b_val, allocated_b_val, max_alloc_b_val) \
-  PRINTF_LOG_CONTIKI("SNAP,%s,%lu,%lu,%lu\r\n",                                   \
-                     (phase_str), (unsigned long)(free_b_val),                    \
-                     (unsigned long)(allocated_b_val), (unsigned long)(max_alloc_b_val))
-
-#define LOG_FAULT_CONTIKI(current_ticks, error_str) \
-  PRINTF_LOG_CONTIKI("FAULT,%lu,0xDEAD,%s\r\n", (unsigned long)(current_ticks), (error_str))
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
 
 struct block
 {
@@ -50,16 +29,21 @@ static unsigned long max_allocated_bytes_contiki_memb = 0;
 
 static void emit_snapshot_contiki_memb(const char *phase)
 {
-  unsigned int free_blocks = memb_numfree(&test_mem);
-  unsigned int used_blocks = TOTAL_BLOCKS - free_blocks;
-  unsigned long current_allocated_bytes = (unsigned long)used_blocks * BLOCK_SIZE;
-  unsigned long current_free_bytes = (unsigned long)free_blocks * BLOCK_SIZE;
-
-  if (current_allocated_bytes > max_allocated_bytes_contiki_memb)
+  aeagle_trace_drain();
+  if (AEAGLE_HEAPSTAT_CHECK)
   {
-    max_allocated_bytes_contiki_memb = current_allocated_bytes;
+    unsigned int free_blocks = memb_numfree(&test_mem);
+    unsigned int used_blocks = TOTAL_BLOCKS - free_blocks;
+    unsigned long current_allocated_bytes = (unsigned long)used_blocks * BLOCK_SIZE;
+    unsigned long current_free_bytes = (unsigned long)free_blocks * BLOCK_SIZE;
+
+    if (current_allocated_bytes > max_allocated_bytes_contiki_memb)
+    {
+      max_allocated_bytes_contiki_memb = current_allocated_bytes;
+    }
+    AEAGLE_LOG_HEAP(phase, current_free_bytes, current_allocated_bytes, max_allocated_bytes_contiki_memb);
   }
-  LOG_SNAP_CONTIKI(phase, current_free_bytes, current_allocated_bytes, max_allocated_bytes_contiki_memb);
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
 }
 
 PROCESS(mixed_lifetime_test, "Mixed Lifetime Test");
@@ -69,7 +53,7 @@ PROCESS_THREAD(mixed_lifetime_test, ev, data)
 {
   static struct block *pinned[PIN_COUNT];
   static struct block *buf[BURST_COUNT];
-  static rtimer_clock_t tin, tout, t_cleanup_in, t_cleanup_out;
+  static aeagle_ts_t tin, tout, t_cleanup_in, t_cleanup_out;
   static int i, round, j;
   static char snap_phase_label[64];
   static int successfully_pinned = 0;
@@ -87,26 +71,33 @@ PROCESS_THREAD(mixed_lifetime_test, ev, data)
   max_allocated_bytes_contiki_memb = 0;
   successfully_pinned = 0;
 
-  LOG_TEST_START(ALLOCATOR_NAME, TEST_NAME);
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
 
-    LOG_META_CONTIKI(RTIMER_SECOND);
+    aeagle_timer_init();
+    AEAGLE_LOG_META();
+    aeagle_heapstat_init(TOTAL_BLOCKS * BLOCK_SIZE);
 
   memb_init(&test_mem);
   emit_snapshot_contiki_memb("baseline");
 
   for (i = 0; i < PIN_COUNT; ++i)
   {
-    tin = RTIMER_NOW();
+    tin = aeagle_timer_now();
     pinned[i] = memb_alloc(&test_mem);
-    tout = RTIMER_NOW();
+    tout = aeagle_timer_now();
     if (!pinned[i])
     {
-      LOG_TIME_CONTIKI("pin", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
-      LOG_FAULT_CONTIKI(RTIMER_NOW(), "OOM");
+      AEAGLE_LOG_TIME_DEFERRED("pin", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
+      aeagle_trace_drain();
+      AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
       goto cleanup_logic;
     }
     alloc_cnt++;
-    LOG_TIME_CONTIKI("pin", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+    aeagle_heapstat_alloc(BLOCK_SIZE);
+    if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+    {
+      AEAGLE_LOG_TIME_DEFERRED("pin", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+    }
     successfully_pinned++;
   }
   emit_snapshot_contiki_memb("after_pins");
@@ -116,17 +107,22 @@ PROCESS_THREAD(mixed_lifetime_test, ev, data)
     current_burst_successful_allocs = 0;
     for (i = 0; i < BURST_COUNT; ++i)
     {
-      tin = RTIMER_NOW();
+      tin = aeagle_timer_now();
       buf[i] = memb_alloc(&test_mem);
-      tout = RTIMER_NOW();
+      tout = aeagle_timer_now();
       if (!buf[i])
       {
-        LOG_TIME_CONTIKI("burst", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
-        LOG_FAULT_CONTIKI(RTIMER_NOW(), "OOM");
+        AEAGLE_LOG_TIME_DEFERRED("burst", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
+        aeagle_trace_drain();
+        AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
         goto cleanup_logic;
       }
       alloc_cnt++;
-      LOG_TIME_CONTIKI("burst", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+      aeagle_heapstat_alloc(BLOCK_SIZE);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        AEAGLE_LOG_TIME_DEFERRED("burst", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+      }
       current_burst_successful_allocs++;
     }
 
@@ -135,18 +131,22 @@ PROCESS_THREAD(mixed_lifetime_test, ev, data)
 
     for (j = current_burst_successful_allocs - 1; j >= 0; --j)
     {
-      tin = RTIMER_NOW();
+      tin = aeagle_timer_now();
       res_free = memb_free(&test_mem, buf[j]);
-      tout = RTIMER_NOW();
+      tout = aeagle_timer_now();
       buf[j] = NULL;
       if (res_free == 0)
       {
         free_cnt++;
-        LOG_TIME_CONTIKI("burst", "free", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+        aeagle_heapstat_free(BLOCK_SIZE);
+        if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+        {
+          AEAGLE_LOG_TIME_DEFERRED("burst", "free", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+        }
       }
       else
       {
-        LOG_TIME_CONTIKI("burst", "free", BLOCK_SIZE, tin, tout, "ERR_FREE", alloc_cnt, free_cnt);
+        AEAGLE_LOG_TIME_DEFERRED("burst", "free", BLOCK_SIZE, tin, tout, "ERR_FREE", alloc_cnt, free_cnt);
       }
     }
     snprintf(snap_phase_label, sizeof(snap_phase_label), "after_burst_free_%02d", round);
@@ -158,23 +158,28 @@ cleanup_logic:
   {
     if (pinned[i] != NULL)
     {
-      t_cleanup_in = RTIMER_NOW();
+      t_cleanup_in = aeagle_timer_now();
       res_free = memb_free(&test_mem, pinned[i]);
-      t_cleanup_out = RTIMER_NOW();
+      t_cleanup_out = aeagle_timer_now();
       pinned[i] = NULL;
       if (res_free == 0)
       {
         free_cnt++;
-        LOG_TIME_CONTIKI("cleanup", "free", BLOCK_SIZE, t_cleanup_in, t_cleanup_out, "OK", alloc_cnt, free_cnt);
+        aeagle_heapstat_free(BLOCK_SIZE);
+        if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+        {
+          AEAGLE_LOG_TIME_DEFERRED("cleanup", "free", BLOCK_SIZE, t_cleanup_in, t_cleanup_out, "OK", alloc_cnt, free_cnt);
+        }
       }
       else
       {
-        LOG_TIME_CONTIKI("cleanup", "free", BLOCK_SIZE, t_cleanup_in, t_cleanup_out, "ERR_FREE", alloc_cnt, free_cnt);
+        AEAGLE_LOG_TIME_DEFERRED("cleanup", "free", BLOCK_SIZE, t_cleanup_in, t_cleanup_out, "ERR_FREE", alloc_cnt, free_cnt);
       }
     }
   }
   emit_snapshot_contiki_memb("post_cleanup");
 
-  LOG_TEST_END(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_trace_finish();
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
   PROCESS_END();
 }
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "contiki.h"
+#include "sys/rtimer.h"
+#include "lib/memb.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define ALLOCATOR_NAME "contiki-memb"
+#define TEST_NAME "RandomSizes"
+#define BLOCK_SIZE 128
+#define TOTAL_BLOCKS 64
+
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
+#include "aeagle_dist.h"
+
+struct block
+{
+  uint8_t data[BLOCK_SIZE];
+};
+
+MEMB(test_mem, struct block, TOTAL_BLOCKS);
+
+static uint32_t alloc_cnt = 0, free_cnt = 0;
+static unsigned long max_allocated_bytes_contiki_memb = 0;
+
+static void emit_snapshot_contiki_memb(const char *phase)
+{
+  aeagle_trace_drain();
+  if (AEAGLE_HEAPSTAT_CHECK)
+  {
+    unsigned int free_blocks = memb_numfree(&test_mem);
+    unsigned int used_blocks = TOTAL_BLOCKS - free_blocks;
+    unsigned long current_allocated_bytes = (unsigned long)used_blocks * BLOCK_SIZE;
+    unsigned long current_free_bytes = (unsigned long)free_blocks * BLOCK_SIZE;
+
+    if (current_allocated_bytes > max_allocated_bytes_contiki_memb)
+    {
+      max_allocated_bytes_contiki_memb = current_allocated_bytes;
+    }
+    AEAGLE_LOG_HEAP(phase, current_free_bytes, current_allocated_bytes, max_allocated_bytes_contiki_memb);
+  }
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+/* Frees slot i, if its malloc succeeded, and empties it. */
+static void release(int i, const char *phase)
+{
+  struct aeagle_dist_obj *o = &aeagle_dist_objs[i];
+  aeagle_ts_t tin, tout;
+
+  if (o->p != NULL)
+  {
+    tin = aeagle_timer_now();
+    memb_free(&test_mem, o->p);
+    tout = aeagle_timer_now();
+    free_cnt++;
+    aeagle_heapstat_free(o->size);
+    if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+    {
+      AEAGLE_LOG_TIME_DEFERRED(phase, "free", o->size, tin, tout, "OK", alloc_cnt, free_cnt);
+    }
+  }
+  o->p = NULL;
+  o->size = 0;
+}
+
+PROCESS(random_sizes_test, "Random Sizes Test");
+AUTOSTART_PROCESSES(&random_sizes_test);
+
+PROCESS_THREAD(random_sizes_test, ev, data)
+{
+  static aeagle_ts_t tin, tout;
+  static uint32_t n, size;
+  static unsigned dist;
+  static int i;
+  static void *p;
+
+  PROCESS_BEGIN();
+
+  alloc_cnt = 0;
+  free_cnt = 0;
+
+  memb_init(&test_mem);
+
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  AEAGLE_LOG_META_VALUE("dist_seed", AEAGLE_DIST_SEED);
+  aeagle_heapstat_init(TOTAL_BLOCKS * BLOCK_SIZE);
+
+  emit_snapshot_contiki_memb("baseline");
+
+  for (dist = 0; dist < AEAGLE_DIST_COUNT; dist++)
+  {
+    aeagle_dist_begin(dist);
+    for (n = 0; n < AEAGLE_DIST_OPS; n++)
+    {
+      while ((i = aeagle_dist_expired(n)) >= 0)
+      {
+        release(i, aeagle_dist_names[dist]);
+      }
+      i = aeagle_dist_slot();
+      if (aeagle_dist_objs[i].size != 0)
+      {
+        release(i, aeagle_dist_names[dist]);
+      }
+      size = aeagle_dist_size(dist);
+      aeagle_dist_objs[i].size = size;
+      aeagle_dist_objs[i].expires = n + aeagle_dist_life();
+
+      tin = aeagle_timer_now();
+      p = size <= BLOCK_SIZE ? memb_alloc(&test_mem) : NULL;
+      tout = aeagle_timer_now();
+      aeagle_dist_objs[i].p = p;
+      if (!p)
+      {
+        AEAGLE_LOG_TIME_DEFERRED(aeagle_dist_names[dist], "malloc", size, tin, tout, "NULL", alloc_cnt, free_cnt);
+        continue;
+      }
+      alloc_cnt++;
+      aeagle_heapstat_alloc(size);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        AEAGLE_LOG_TIME_DEFERRED(aeagle_dist_names[dist], "malloc", size, tin, tout, "OK", alloc_cnt, free_cnt);
+      }
+    }
+    emit_snapshot_contiki_memb(aeagle_dist_snaps[dist]);
+
+    /* Each distribution starts from an empty heap. */
+    for (i = 0; i < AEAGLE_DIST_SLOTS; i++)
+    {
+      release(i, "cleanup");
+    }
+  }
+  emit_snapshot_contiki_memb("post_cleanup");
+
+  aeagle_trace_finish();
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
+  PROCESS_END();
+}
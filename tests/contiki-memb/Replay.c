@@ -0,0 +1,164 @@
+#include "contiki.h"
+#include "sys/rtimer.h"
+#include "lib/memb.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define ALLOCATOR_NAME "contiki-memb"
+#define TEST_NAME "Replay"
+#define BLOCK_SIZE 128
+#define TOTAL_BLOCKS 64
+
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
+#include "aeagle_replay.h"
+
+struct block
+{
+  uint8_t data[BLOCK_SIZE];
+};
+
+MEMB(test_mem, struct block, TOTAL_BLOCKS);
+
+static uint32_t alloc_cnt = 0, free_cnt = 0;
+static unsigned long max_allocated_bytes_contiki_memb = 0;
+
+static void emit_snapshot_contiki_memb(const char *phase)
+{
+  aeagle_trace_drain();
+  if (AEAGLE_HEAPSTAT_CHECK)
+  {
+    unsigned int free_blocks = memb_numfree(&test_mem);
+    unsigned int used_blocks = TOTAL_BLOCKS - free_blocks;
+    unsigned long current_allocated_bytes = (unsigned long)used_blocks * BLOCK_SIZE;
+    unsigned long current_free_bytes = (unsigned long)free_blocks * BLOCK_SIZE;
+
+    if (current_allocated_bytes > max_allocated_bytes_contiki_memb)
+    {
+      max_allocated_bytes_contiki_memb = current_allocated_bytes;
+    }
+    AEAGLE_LOG_HEAP(phase, current_free_bytes, current_allocated_bytes, max_allocated_bytes_contiki_memb);
+  }
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+/* The live object of every trace slot, and the size it was asked for. */
+static void *objs[AEAGLE_REPLAY_MAX_OBJECTS];
+static uint32_t obj_size[AEAGLE_REPLAY_MAX_OBJECTS];
+
+PROCESS(replay_test, "Replay Test");
+AUTOSTART_PROCESSES(&replay_test);
+
+PROCESS_THREAD(replay_test, ev, data)
+{
+  static struct aeagle_replay r;
+  static struct aeagle_replay_rec rec;
+  static aeagle_ts_t tin, tout;
+  static uint32_t skipped, i;
+  static int rc;
+  static void *p;
+
+  PROCESS_BEGIN();
+
+  alloc_cnt = 0;
+  free_cnt = 0;
+  skipped = 0;
+
+  memb_init(&test_mem);
+
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  aeagle_heapstat_init(TOTAL_BLOCKS * BLOCK_SIZE);
+
+  emit_snapshot_contiki_memb("baseline");
+
+  if (aeagle_replay_open(&r, aeagle_replay_trace, sizeof(aeagle_replay_trace), NULL,
+                         AEAGLE_REPLAY_MAX_OBJECTS) != 0)
+  {
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "REPLAY_TRACE");
+    goto done;
+  }
+
+  while ((rc = aeagle_replay_next(&r, &rec)) > 0)
+  {
+    if (rec.op == AEAGLE_REPLAY_MALLOC)
+    {
+      if (objs[rec.id] != NULL)
+      {
+        skipped++;
+        continue;
+      }
+      tin = aeagle_timer_now();
+      p = rec.size <= BLOCK_SIZE ? memb_alloc(&test_mem) : NULL;
+      tout = aeagle_timer_now();
+      if (!p)
+      {
+        AEAGLE_LOG_TIME_DEFERRED("replay", "malloc", rec.size, tin, tout, "NULL", alloc_cnt, free_cnt);
+        continue;
+      }
+      objs[rec.id] = p;
+      obj_size[rec.id] = rec.size;
+      alloc_cnt++;
+      aeagle_heapstat_alloc(rec.size);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        AEAGLE_LOG_TIME_DEFERRED("replay", "malloc", rec.size, tin, tout, "OK", alloc_cnt, free_cnt);
+      }
+    }
+    else
+    {
+      /* The malloc of this slot failed here. */
+      if (objs[rec.id] == NULL)
+      {
+        skipped++;
+        continue;
+      }
+      tin = aeagle_timer_now();
+      memb_free(&test_mem, objs[rec.id]);
+      tout = aeagle_timer_now();
+      objs[rec.id] = NULL;
+      free_cnt++;
+      aeagle_heapstat_free(obj_size[rec.id]);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        AEAGLE_LOG_TIME_DEFERRED("replay", "free", obj_size[rec.id], tin, tout, "OK", alloc_cnt, free_cnt);
+      }
+    }
+  }
+  if (rc < 0)
+  {
+    aeagle_trace_drain();
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "REPLAY_TRACE");
+  }
+  emit_snapshot_contiki_memb("after_replay");
+
+  /* Whatever the trace leaves live. */
+  for (i = 0; i < r.objects; i++)
+  {
+    if (objs[i] == NULL)
+    {
+      continue;
+    }
+    tin = aeagle_timer_now();
+    memb_free(&test_mem, objs[i]);
+    tout = aeagle_timer_now();
+    objs[i] = NULL;
+    free_cnt++;
+    aeagle_heapstat_free(obj_size[i]);
+    if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+    {
+      AEAGLE_LOG_TIME_DEFERRED("cleanup", "free", obj_size[i], tin, tout, "OK", alloc_cnt, free_cnt);
+    }
+  }
+  emit_snapshot_contiki_memb("post_cleanup");
+
+done:
+  AEAGLE_LOG_META_VALUE("replay_records", r.records);
+  AEAGLE_LOG_META_VALUE("replay_skipped", skipped);
+  aeagle_trace_finish();
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
+  PROCESS_END();
+}
@@ -5,6 +5,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
+#include "aeagle_log.h"
+#include "aeagle_heapstat.h"
 
 #define ALLOCATOR_NAME "contiki-memb"
 #define TEST_NAME "UseAfterFree"
@@ -12,37 +14,6 @@
 #define BLOCK_COUNT 2
 #define PATTERN 0x5A
 
-#define PRINTF_LOG_CONTIKI(format, ...) printf(format, ##__VA_ARGS__)
-
-#define LOG_TEST_START(alloc_name, test_name_str) \
-  PRINTF_LOG_CONTIKI("# %s %s start\r\n", (alloc_name), (test_name_str))
-
-#define LOG_TEST_END(alloc_name, test_name_str) \
-  PRINTF_LOG_CONTIKI("# %s %s end\r\n", (alloc_name), (test_name_str))
-
-#define LOG_META_CONTIKI(tick_hz_val) \
-  PRINTF_LOG_CONTIKI("META,tick_hz,%u\r\n", (unsigned)(tick_hz_val))
-
-#define LOG_TIME_CONTIKI(phase_str, op_str, size_val, time_in, time_out, result_str, ac, fc) \
-  PRINTF_LOG_CONTIKI("TIME,%s,%s,%u,%lu,%lu,%s,%lu,%lu\r\n",                                 \
-                     (phase_str), (op_str), (unsigned)(size_val),                            \
-                     (unsigned long)(time_in), (unsigned long)(time_out), (result_str),      \
-                     (unsigned long)(ac), (unsigned long)(fc))
-
-#define LOG_SNAP_CONTIKI(phase_str, free_b_val, allocated_b_val, max_alloc_b_val) \
-  PRINTF_LOG_CONTIKI("SNAP,%s,%lu,%lu,%lu\r\n",                                   \
-                     (phase_str), (unsigned long)(free_b_val),                    \
-                     (unsigned long)(allocated_b_val), (unsigned long)(max_alloc_b_val))
-
-#define LOG_FAULT_CONTIKI(current_ticks, error_str) \
-  PRINTF_LOG_CONTIKI("FAULT,%lu,0xDEAD,%s\r\n", (unsigned long)(current_ticks), (error_str))
-
-#define LOG_LEAK_CONTIKI(addr_val) \
-  PRINTF_LOG_CONTIKI("LEAK,%p\r\n", (void *)(addr_val))
-
-#define LOG_NOLEAK_CONTIKI(addr_val) \
-  PRINTF_LOG_CONTIKI("NOLEAK,%p\r\n", (void *)(addr_val))
-
 struct block
 {
   uint8_t data[BLOCK_SIZE];
@@ -55,16 +26,20 @@ static unsigned long max_allocated_bytes_contiki_memb = 0;
 
 static void emit_snapshot_contiki_memb(const char *phase)
 {
-  unsigned int free_blocks = memb_numfree(&test_mem);
-  unsigned int used_blocks = BLOCK_COUNT - free_blocks;
-  unsigned long current_allocated_bytes = (unsigned long)used_blocks * BLOCK_SIZE;
-  unsigned long current_free_bytes = (unsigned long)free_blocks * BLOCK_SIZE;
-
-  if (current_allocated_bytes > max_allocated_bytes_contiki_memb)
+  if (AEAGLE_HEAPSTAT_CHECK)
   {
-    max_allocated_bytes_contiki_memb = current_allocated_bytes;
+    unsigned int free_blocks = memb_numfree(&test_mem);
+    unsigned int used_blocks = BLOCK_COUNT - free_blocks;
+    unsigned long current_allocated_bytes = (unsigned long)used_blocks * BLOCK_SIZE;
+    unsigned long current_free_bytes = (unsigned long)free_blocks * BLOCK_SIZE;
+
+    if (current_allocated_bytes > max_allocated_bytes_contiki_memb)
+    {
+      max_allocated_bytes_contiki_memb = current_allocated_bytes;
+    }
+    AEAGLE_LOG_HEAP(phase, current_free_bytes, current_allocated_bytes, max_allocated_bytes_contiki_memb);
   }
-  LOG_SNAP_CONTIKI(phase, current_free_bytes, current_allocated_bytes, max_allocated_bytes_contiki_memb);
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
 }
 
 PROCESS(use_after_free_test, "Use After Free Test");
@@ -73,7 +48,7 @@ AUTOSTART_PROCESSES(&use_after_free_test);
 PROCESS_THREAD(use_after_free_test, ev, data)
 {
   static struct block *p1 = NULL, *p2 = NULL;
-  static rtimer_clock_t tin, tout, t_inspect_in, t_inspect_out, t_cleanup_in, t_cleanup_out;
+  static aeagle_ts_t tin, tout, t_inspect_in, t_inspect_out, t_cleanup_in, t_cleanup_out;
   static uint8_t *buf1;
   static int i;
   static bool leaked;
@@ -85,63 +60,68 @@ PROCESS_THREAD(use_after_free_test, ev, data)
   free_cnt = 0;
   max_allocated_bytes_contiki_memb = 0;
 
-  LOG_TEST_START(ALLOCATOR_NAME, TEST_NAME);
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
 
-    LOG_META_CONTIKI(RTIMER_SECOND);
+    aeagle_timer_init();
+    AEAGLE_LOG_META();
+    aeagle_heapstat_init(BLOCK_COUNT * BLOCK_SIZE);
 
   memb_init(&test_mem);
   emit_snapshot_contiki_memb("baseline");
 
-  tin = RTIMER_NOW();
+  tin = aeagle_timer_now();
   p1 = memb_alloc(&test_mem);
-  tout = RTIMER_NOW();
+  tout = aeagle_timer_now();
 
   if (p1 == NULL)
   {
-    LOG_TIME_CONTIKI("setup", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
-    LOG_FAULT_CONTIKI(RTIMER_NOW(), "OOM");
+    AEAGLE_LOG_TIME("setup", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
     goto done_label;
   }
   alloc_cnt++;
-  LOG_TIME_CONTIKI("setup", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+  aeagle_heapstat_alloc(BLOCK_SIZE);
+  AEAGLE_LOG_TIME("setup", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
   memset(p1->data, PATTERN, BLOCK_SIZE);
   emit_snapshot_contiki_memb("after_setup");
 
-  tin = RTIMER_NOW();
+  tin = aeagle_timer_now();
   res_free = memb_free(&test_mem, p1);
-  tout = RTIMER_NOW();
+  tout = aeagle_timer_now();
   if (res_free == 0)
   {
     free_cnt++;
-    LOG_TIME_CONTIKI("setup", "free", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+    aeagle_heapstat_free(BLOCK_SIZE);
+    AEAGLE_LOG_TIME("setup", "free", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
   }
   else
   {
-    LOG_TIME_CONTIKI("setup", "free", BLOCK_SIZE, tin, tout, "ERR_FREE", alloc_cnt, free_cnt);
+    AEAGLE_LOG_TIME("setup", "free", BLOCK_SIZE, tin, tout, "ERR_FREE", alloc_cnt, free_cnt);
   }
   emit_snapshot_contiki_memb("after_free1");
 
   buf1 = p1->data;
-  tin = RTIMER_NOW();
+  tin = aeagle_timer_now();
   memset(buf1, 0xA5, BLOCK_SIZE);
-  tout = RTIMER_NOW();
-  LOG_TIME_CONTIKI("uaf_write", "memset_uaf", BLOCK_SIZE, tin, tout, "UAF_WRITE_DONE", alloc_cnt, free_cnt);
+  tout = aeagle_timer_now();
+  AEAGLE_LOG_TIME("uaf_write", "memset_uaf", BLOCK_SIZE, tin, tout, "UAF_WRITE_DONE", alloc_cnt, free_cnt);
   emit_snapshot_contiki_memb("after_uaf_write");
 
-  tin = RTIMER_NOW();
+  tin = aeagle_timer_now();
   p2 = memb_alloc(&test_mem);
-  tout = RTIMER_NOW();
+  tout = aeagle_timer_now();
 
   if (p2 == NULL)
   {
-    LOG_TIME_CONTIKI("uaf_realloc", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
-    LOG_FAULT_CONTIKI(RTIMER_NOW(), "OOM");
+    AEAGLE_LOG_TIME("uaf_realloc", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
     goto done_label;
   }
   alloc_cnt++;
-  LOG_TIME_CONTIKI("uaf_realloc", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+  aeagle_heapstat_alloc(BLOCK_SIZE);
+  AEAGLE_LOG_TIME("uaf_realloc", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
 
-  t_inspect_in = RTIMER_NOW();
+  t_inspect_in = aeagle_timer_now();
   leaked = false;
   for (i = 0; i < BLOCK_SIZE; ++i)
   {
@@ -151,39 +131,40 @@ PROCESS_THREAD(use_after_free_test, ev, data)
       break;
     }
   }
-  t_inspect_out = RTIMER_NOW();
+  t_inspect_out = aeagle_timer_now();
 
   if (leaked)
   {
-    LOG_TIME_CONTIKI("uaf_inspect", "inspect_uaf", BLOCK_SIZE, t_inspect_in, t_inspect_out, "LEAK_DETECTED", alloc_cnt, free_cnt);
-    LOG_LEAK_CONTIKI(p2);
+    AEAGLE_LOG_TIME("uaf_inspect", "inspect_uaf", BLOCK_SIZE, t_inspect_in, t_inspect_out, "LEAK_DETECTED", alloc_cnt, free_cnt);
+    AEAGLE_LOG_LEAK(p2);
   }
   else
   {
-    LOG_TIME_CONTIKI("uaf_inspect", "inspect_uaf", BLOCK_SIZE, t_inspect_in, t_inspect_out, "NO_LEAK_DETECTED", alloc_cnt, free_cnt);
-    LOG_NOLEAK_CONTIKI(p2);
+    AEAGLE_LOG_TIME("uaf_inspect", "inspect_uaf", BLOCK_SIZE, t_inspect_in, t_inspect_out, "NO_LEAK_DETECTED", alloc_cnt, free_cnt);
+    AEAGLE_LOG_NOLEAK(p2);
   }
   emit_snapshot_contiki_memb("post_primitive_realloc");
 
   if (p2 != NULL)
   {
-    t_cleanup_in = RTIMER_NOW();
+    t_cleanup_in = aeagle_timer_now();
     res_free = memb_free(&test_mem, p2);
-    t_cleanup_out = RTIMER_NOW();
+    t_cleanup_out = aeagle_timer_now();
     p2 = NULL;
     if (res_free == 0)
     {
       free_cnt++;
-      LOG_TIME_CONTIKI("cleanup", "free", BLOCK_SIZE, t_cleanup_in, t_cleanup_out, "OK", alloc_cnt, free_cnt);
+      aeagle_heapstat_free(BLOCK_SIZE);
+      AEAGLE_LOG_TIME("cleanup", "free", BLOCK_SIZE, t_cleanup_in, t_cleanup_out, "OK", alloc_cnt, free_cnt);
     }
     else
     {
-      LOG_TIME_CONTIKI("cleanup", "free", BLOCK_SIZE, t_cleanup_in, t_cleanup_out, "ERR_FREE", alloc_cnt, free_cnt);
+      AEAGLE_LOG_TIME("cleanup", "free", BLOCK_SIZE, t_cleanup_in, t_cleanup_out, "ERR_FREE", alloc_cnt, free_cnt);
     }
   }
   emit_snapshot_contiki_memb("post_cleanup");
 
 done_label:
-  LOG_TEST_END(ALLOCATOR_NAME, TEST_NAME);
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
   PROCESS_END();
 }
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "FreeRTOS.h"
+#include "portable.h"
+#include "task.h"
+#include "ti_drivers_config.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <ti/drivers/Board.h>
+#include <ti/drivers/UART2.h>
+#include "aeagle_log.h"
+#include "aeagle_heapstat.h"
+
+#ifndef ALLOCATOR_NAME
+#define ALLOCATOR_NAME "FreeRTOS"
+#endif
+
+#define TEST_NAME "Contention"
+
+static UART2_Handle uart;
+static UART2_Params uartParams;
+
+/* After the handle: the trace drains through AEAGLE_LOG_UART. */
+#include "aeagle_trace.h"
+#include "aeagle_contention.h"
+
+static size_t g_min_free_ever = (size_t)-1;
+
+static void emit_snapshot(const char *phase)
+{
+  aeagle_trace_drain();
+  if (AEAGLE_HEAPSTAT_CHECK)
+  {
+    size_t free_now = xPortGetFreeHeapSize();
+    size_t total = (size_t)configTOTAL_HEAP_SIZE;
+
+    if (free_now < g_min_free_ever)
+    {
+      g_min_free_ever = free_now;
+    }
+
+    size_t used_now = total - free_now;
+    size_t used_max = total - g_min_free_ever;
+
+    AEAGLE_LOG_HEAP(phase, free_now, used_now, used_max);
+  }
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+/* Task k of the workload; see aeagle_contention.h. */
+static void contention_worker(unsigned k)
+{
+  void *held[AEAGLE_CONTENTION_HOLD] = {0};
+  uint32_t held_size[AEAGLE_CONTENTION_HOLD];
+  aeagle_ts_t tin, tout;
+  uint32_t i, h, seq, size;
+  void *p;
+  /* The sleepers' schedule, in kernel ticks. */
+  TickType_t first = xTaskGetTickCount(), last = first;
+  aeagle_ts_t t0 = aeagle_timer_now();
+
+  for (i = 0; k == 0 ? !aeagle_contention_stop : i < AEAGLE_CONTENTION_OPS; i++)
+  {
+    h = i % AEAGLE_CONTENTION_HOLD;
+    if (held[h] == NULL)
+    {
+      size = aeagle_contention_sizes[(i / AEAGLE_CONTENTION_HOLD + k) % 4];
+      seq = aeagle_contention_seq;
+      tin = aeagle_timer_now();
+      p = pvPortMalloc(size);
+      tout = aeagle_timer_now();
+      aeagle_contention_done(k, AEAGLE_CONTENTION_MALLOC, size, tin, tout, seq, p != NULL);
+      held[h] = p;
+      held_size[h] = size;
+    }
+    else
+    {
+      seq = aeagle_contention_seq;
+      tin = aeagle_timer_now();
+      vPortFree(held[h]);
+      tout = aeagle_timer_now();
+      aeagle_contention_done(k, AEAGLE_CONTENTION_FREE, held_size[h], tin, tout, seq, 1);
+      held[h] = NULL;
+    }
+    if (k > 0)
+    {
+      TickType_t ticks = pdMS_TO_TICKS(k * AEAGLE_CONTENTION_PERIOD_US / 1000);
+      /* Absolute deadlines: a late wake-up does not move the next one. */
+      vTaskDelayUntil(&last, ticks > 0 ? ticks : 1);
+      aeagle_contention_woke(k, t0, (TickType_t)(last - first), configTICK_RATE_HZ);
+    }
+  }
+  for (h = 0; h < AEAGLE_CONTENTION_HOLD; h++)
+  {
+    if (held[h] != NULL)
+    {
+      seq = aeagle_contention_seq;
+      tin = aeagle_timer_now();
+      vPortFree(held[h]);
+      tout = aeagle_timer_now();
+      aeagle_contention_done(k, AEAGLE_CONTENTION_FREE, held_size[h], tin, tout, seq, 1);
+    }
+  }
+  aeagle_contention_exit();
+}
+
+static void ContentionWorker(void *pvParameters)
+{
+  contention_worker((unsigned)(uintptr_t)pvParameters);
+  vTaskSuspend(NULL);
+}
+
+static void ContentionTest(void *pvParameters)
+{
+  (void)pvParameters;
+  unsigned k;
+
+  UART2_Params_init(&uartParams);
+  uartParams.baudRate = 115200;
+  uart = UART2_open(CONFIG_UART2_0, &uartParams);
+
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  AEAGLE_LOG_META_VALUE("contention_tasks", AEAGLE_CONTENTION_TASKS);
+  aeagle_heapstat_init(configTOTAL_HEAP_SIZE);
+
+  emit_snapshot("baseline");
+
+  aeagle_contention_reset();
+  /* Below this task, which only waits; task 0 lowest. All start together. */
+  vTaskSuspendAll();
+  for (k = 0; k < AEAGLE_CONTENTION_TASKS; k++)
+  {
+    UBaseType_t prio = tskIDLE_PRIORITY + 1 + k;
+    xTaskCreate(ContentionWorker, "worker", 512, (void *)(uintptr_t)k,
+                prio < configMAX_PRIORITIES - 1 ? prio : configMAX_PRIORITIES - 1, NULL);
+  }
+  xTaskResumeAll();
+  while (aeagle_contention_finished < AEAGLE_CONTENTION_TASKS - 1)
+  {
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+  aeagle_contention_stop = 1;
+  while (aeagle_contention_finished < AEAGLE_CONTENTION_TASKS)
+  {
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+
+  emit_snapshot("after_contention");
+  aeagle_contention_report();
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
+  if (uart)
+  {
+    UART2_close(uart);
+  }
+  vTaskSuspend(NULL);
+}
+
+int main(void)
+{
+  Board_init();
+
+  xTaskCreate(ContentionTest, TEST_NAME, 512, NULL, configMAX_PRIORITIES - 1, NULL);
+
+  vTaskStartScheduler();
+
+  for (;;)
+    ;
+  return 0;
+}
@@ -0,0 +1,206 @@
+#include "FreeRTOS.h"
+#include "portable.h"
+#include "task.h"
+#include "ti_drivers_config.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <ti/drivers/Board.h>
+#include <ti/drivers/UART2.h>
+#include "aeagle_log.h"
+#include "aeagle_heapstat.h"
+
+#ifndef ALLOCATOR_NAME
+#define ALLOCATOR_NAME "FreeRTOS"
+#endif
+
+#define TEST_NAME "IsrLatency"
+
+static UART2_Handle uart;
+static UART2_Params uartParams;
+
+/* After the handle: the trace drains through AEAGLE_LOG_UART. */
+#include "aeagle_trace.h"
+/* The kernel tick is the interrupt. */
+#undef AEAGLE_ISR_PERIOD_US
+#define AEAGLE_ISR_PERIOD_US (1000000 / configTICK_RATE_HZ)
+#include "aeagle_isr.h"
+
+static size_t g_min_free_ever = (size_t)-1;
+
+static void emit_snapshot(const char *phase)
+{
+  aeagle_trace_drain();
+  if (AEAGLE_HEAPSTAT_CHECK)
+  {
+    size_t free_now = xPortGetFreeHeapSize();
+    size_t total = (size_t)configTOTAL_HEAP_SIZE;
+
+    if (free_now < g_min_free_ever)
+    {
+      g_min_free_ever = free_now;
+    }
+
+    size_t used_now = total - free_now;
+    size_t used_max = total - g_min_free_ever;
+
+    AEAGLE_LOG_HEAP(phase, free_now, used_now, used_max);
+  }
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+/* heap_N only suspends the scheduler and may not be called from an
+ * interrupt, so the tick hook takes its block from a pool of its own. */
+#define ISR_POOL_BLOCKS 2
+
+static uint8_t isr_pool[ISR_POOL_BLOCKS][AEAGLE_ISR_SIZE] __attribute__((aligned(8)));
+static void *isr_pool_free[ISR_POOL_BLOCKS];
+static unsigned isr_pool_avail;
+
+static void *isr_pool_alloc(void)
+{
+  return isr_pool_avail > 0 ? isr_pool_free[--isr_pool_avail] : NULL;
+}
+
+static void isr_pool_release(void *p)
+{
+  isr_pool_free[isr_pool_avail++] = p;
+}
+
+#if !configUSE_TICK_HOOK
+#error "IsrLatency samples from the tick hook; set configUSE_TICK_HOOK to 1"
+#endif
+
+/* In the tick interrupt. */
+void vApplicationTickHook(void)
+{
+  struct aeagle_isr_sample *s = aeagle_isr_enter(aeagle_timer_now());
+  void *p;
+
+  if (s == NULL)
+  {
+    return;
+  }
+  if (aeagle_isr_block == NULL)
+  {
+    s->t_in = aeagle_timer_now();
+    p = isr_pool_alloc();
+    s->t_out = aeagle_timer_now();
+    s->op = AEAGLE_ISR_MALLOC;
+    s->ok = p != NULL;
+    aeagle_isr_block = p;
+  }
+  else
+  {
+    s->t_in = aeagle_timer_now();
+    isr_pool_release(aeagle_isr_block);
+    s->t_out = aeagle_timer_now();
+    s->op = AEAGLE_ISR_FREE;
+    s->ok = 1;
+    aeagle_isr_block = NULL;
+  }
+  aeagle_isr_leave();
+}
+
+/* The task's side of a phase, until the ISR has its samples; returns the
+ * heap calls made. */
+static uint32_t isr_background(unsigned phase)
+{
+  void *held[AEAGLE_ISR_HOLD] = {0};
+  uint32_t held_size[AEAGLE_ISR_HOLD];
+  aeagle_ts_t start = aeagle_timer_now();
+  uint32_t calls = 0, h;
+
+  while (aeagle_isr_pending(start))
+  {
+    if (phase == AEAGLE_ISR_IDLE)
+    {
+      continue;
+    }
+    h = calls % AEAGLE_ISR_HOLD;
+    if (held[h] == NULL)
+    {
+      held_size[h] = aeagle_isr_sizes[(calls / AEAGLE_ISR_HOLD) % 4];
+      held[h] = pvPortMalloc(held_size[h]);
+      if (held[h] != NULL)
+      {
+        aeagle_heapstat_alloc(held_size[h]);
+      }
+    }
+    else
+    {
+      vPortFree(held[h]);
+      aeagle_heapstat_free(held_size[h]);
+      held[h] = NULL;
+    }
+    calls++;
+  }
+  for (h = 0; h < AEAGLE_ISR_HOLD; h++)
+  {
+    if (held[h] != NULL)
+    {
+      vPortFree(held[h]);
+      aeagle_heapstat_free(held_size[h]);
+    }
+  }
+  return calls;
+}
+
+static void IsrLatencyTest(void *pvParameters)
+{
+  (void)pvParameters;
+  unsigned phase, i;
+  uint32_t calls = 0;
+
+  UART2_Params_init(&uartParams);
+  uartParams.baudRate = 115200;
+  uart = UART2_open(CONFIG_UART2_0, &uartParams);
+
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  AEAGLE_LOG_META_VALUE("isr_period_us", AEAGLE_ISR_PERIOD_US);
+  aeagle_heapstat_init(configTOTAL_HEAP_SIZE);
+
+  emit_snapshot("baseline");
+
+  for (i = 0; i < ISR_POOL_BLOCKS; i++)
+  {
+    isr_pool_release(isr_pool[i]);
+  }
+  /* The tick keeps running; the hook only samples inside a phase. */
+  for (phase = 0; phase < AEAGLE_ISR_PHASES; phase++)
+  {
+    aeagle_isr_begin();
+    calls += isr_background(phase);
+    if (aeagle_isr_block != NULL)
+    {
+      isr_pool_release(aeagle_isr_block);
+      aeagle_isr_block = NULL;
+    }
+    emit_snapshot(aeagle_isr_snaps[phase]);
+    aeagle_isr_report(phase);
+  }
+  AEAGLE_LOG_META_VALUE("isr_churn_calls", calls);
+
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
+  if (uart)
+  {
+    UART2_close(uart);
+  }
+  vTaskSuspend(NULL);
+}
+
+int main(void)
+{
+  Board_init();
+
+  xTaskCreate(IsrLatencyTest, TEST_NAME, 512, NULL, configMAX_PRIORITIES - 1, NULL);
+
+  vTaskStartScheduler();
+
+  for (;;)
+    ;
+  return 0;
+}
@@ -0,0 +1,158 @@
+#include "FreeRTOS.h"
+#include "portable.h"
+#include "task.h"
+#include "ti_drivers_config.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <ti/drivers/Board.h>
+#include <ti/drivers/UART2.h>
+#include "aeagle_log.h"
+#include "aeagle_heapstat.h"
+#include "aeagle_dist.h"
+
+#ifndef ALLOCATOR_NAME
+#define ALLOCATOR_NAME "FreeRTOS"
+#endif
+
+#define TEST_NAME "RandomSizes"
+
+static UART2_Handle uart;
+static UART2_Params uartParams;
+
+/* After the handle: the trace drains through AEAGLE_LOG_UART. */
+#include "aeagle_trace.h"
+
+static uint32_t alloc_cnt = 0, free_cnt = 0;
+static size_t g_min_free_ever = (size_t)-1;
+
+static void emit_snapshot(const char *phase)
+{
+  aeagle_trace_drain();
+  if (AEAGLE_HEAPSTAT_CHECK)
+  {
+    size_t free_now = xPortGetFreeHeapSize();
+    size_t total = (size_t)configTOTAL_HEAP_SIZE;
+
+    if (free_now < g_min_free_ever)
+    {
+      g_min_free_ever = free_now;
+    }
+
+    size_t used_now = total - free_now;
+    size_t used_max = total - g_min_free_ever;
+
+    AEAGLE_LOG_HEAP(phase, free_now, used_now, used_max);
+  }
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+/* Frees slot i, if its malloc succeeded, and empties it. */
+static void release(int i, const char *phase)
+{
+  struct aeagle_dist_obj *o = &aeagle_dist_objs[i];
+  aeagle_ts_t tin, tout;
+
+  if (o->p != NULL)
+  {
+    tin = aeagle_timer_now();
+    vPortFree(o->p);
+    tout = aeagle_timer_now();
+    free_cnt++;
+    aeagle_heapstat_free(o->size);
+    if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+    {
+      AEAGLE_LOG_TIME_DEFERRED(phase, "free", o->size, tin, tout, "OK", alloc_cnt, free_cnt);
+    }
+  }
+  o->p = NULL;
+  o->size = 0;
+}
+
+static void RandomSizesTest(void *pvParameters)
+{
+  (void)pvParameters;
+  aeagle_ts_t tin, tout;
+  uint32_t n, size;
+  unsigned dist;
+  int i;
+  void *p;
+
+  UART2_Params_init(&uartParams);
+  uartParams.baudRate = 115200;
+  uart = UART2_open(CONFIG_UART2_0, &uartParams);
+
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  AEAGLE_LOG_META_VALUE("dist_seed", AEAGLE_DIST_SEED);
+  aeagle_heapstat_init(configTOTAL_HEAP_SIZE);
+
+  emit_snapshot("baseline");
+
+  for (dist = 0; dist < AEAGLE_DIST_COUNT; dist++)
+  {
+    aeagle_dist_begin(dist);
+    for (n = 0; n < AEAGLE_DIST_OPS; n++)
+    {
+      while ((i = aeagle_dist_expired(n)) >= 0)
+      {
+        release(i, aeagle_dist_names[dist]);
+      }
+      i = aeagle_dist_slot();
+      if (aeagle_dist_objs[i].size != 0)
+      {
+        release(i, aeagle_dist_names[dist]);
+      }
+      size = aeagle_dist_size(dist);
+      aeagle_dist_objs[i].size = size;
+      aeagle_dist_objs[i].expires = n + aeagle_dist_life();
+
+      tin = aeagle_timer_now();
+      p = pvPortMalloc(size);
+      tout = aeagle_timer_now();
+      aeagle_dist_objs[i].p = p;
+      if (!p)
+      {
+        AEAGLE_LOG_TIME_DEFERRED(aeagle_dist_names[dist], "malloc", size, tin, tout, "NULL", alloc_cnt, free_cnt);
+        continue;
+      }
+      alloc_cnt++;
+      aeagle_heapstat_alloc(size);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        AEAGLE_LOG_TIME_DEFERRED(aeagle_dist_names[dist], "malloc", size, tin, tout, "OK", alloc_cnt, free_cnt);
+      }
+    }
+    emit_snapshot(aeagle_dist_snaps[dist]);
+
+    /* Each distribution starts from an empty heap. */
+    for (i = 0; i < AEAGLE_DIST_SLOTS; i++)
+    {
+      release(i, "cleanup");
+    }
+  }
+  emit_snapshot("post_cleanup");
+
+  aeagle_trace_finish();
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
+  if (uart)
+  {
+    UART2_close(uart);
+  }
+  vTaskSuspend(NULL);
+}
+
+int main(void)
+{
+  Board_init();
+
+  xTaskCreate(RandomSizesTest, TEST_NAME, 512, NULL, 1, NULL);
+
+  vTaskStartScheduler();
+
+  for (;;)
+    ;
+  return 0;
+}
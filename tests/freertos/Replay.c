@@ -0,0 +1,179 @@
+#include "FreeRTOS.h"
+#include "portable.h"
+#include "task.h"
+#include "ti_drivers_config.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <ti/drivers/Board.h>
+#include <ti/drivers/UART2.h>
+#include "aeagle_log.h"
+#include "aeagle_heapstat.h"
+#include "aeagle_replay.h"
+
+#ifndef ALLOCATOR_NAME
+#define ALLOCATOR_NAME "FreeRTOS"
+#endif
+
+#define TEST_NAME "Replay"
+
+static UART2_Handle uart;
+static UART2_Params uartParams;
+
+/* After the handle: the trace drains through AEAGLE_LOG_UART. */
+#include "aeagle_trace.h"
+
+static uint32_t alloc_cnt = 0, free_cnt = 0;
+static size_t g_min_free_ever = (size_t)-1;
+
+static void emit_snapshot(const char *phase)
+{
+  aeagle_trace_drain();
+  if (AEAGLE_HEAPSTAT_CHECK)
+  {
+    size_t free_now = xPortGetFreeHeapSize();
+    size_t total = (size_t)configTOTAL_HEAP_SIZE;
+
+    if (free_now < g_min_free_ever)
+    {
+      g_min_free_ever = free_now;
+    }
+
+    size_t used_now = total - free_now;
+    size_t used_max = total - g_min_free_ever;
+
+    AEAGLE_LOG_HEAP(phase, free_now, used_now, used_max);
+  }
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+/* The live object of every trace slot, and the size it was asked for. */
+static void *objs[AEAGLE_REPLAY_MAX_OBJECTS];
+static uint32_t obj_size[AEAGLE_REPLAY_MAX_OBJECTS];
+
+static void ReplayTest(void *pvParameters)
+{
+  (void)pvParameters;
+  struct aeagle_replay r;
+  struct aeagle_replay_rec rec;
+  aeagle_ts_t tin, tout;
+  uint32_t skipped = 0, i;
+  int rc;
+  void *p;
+
+  UART2_Params_init(&uartParams);
+  uartParams.baudRate = 115200;
+  uart = UART2_open(CONFIG_UART2_0, &uartParams);
+
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  aeagle_heapstat_init(configTOTAL_HEAP_SIZE);
+
+  emit_snapshot("baseline");
+
+  if (aeagle_replay_open(&r, aeagle_replay_trace, sizeof(aeagle_replay_trace), NULL,
+                         AEAGLE_REPLAY_MAX_OBJECTS) != 0)
+  {
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "REPLAY_TRACE");
+    goto done;
+  }
+
+  while ((rc = aeagle_replay_next(&r, &rec)) > 0)
+  {
+    if (rec.op == AEAGLE_REPLAY_MALLOC)
+    {
+      if (objs[rec.id] != NULL)
+      {
+        skipped++;
+        continue;
+      }
+      tin = aeagle_timer_now();
+      p = pvPortMalloc(rec.size);
+      tout = aeagle_timer_now();
+      if (!p)
+      {
+        AEAGLE_LOG_TIME_DEFERRED("replay", "malloc", rec.size, tin, tout, "NULL", alloc_cnt, free_cnt);
+        continue;
+      }
+      objs[rec.id] = p;
+      obj_size[rec.id] = rec.size;
+      alloc_cnt++;
+      aeagle_heapstat_alloc(rec.size);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        AEAGLE_LOG_TIME_DEFERRED("replay", "malloc", rec.size, tin, tout, "OK", alloc_cnt, free_cnt);
+      }
+    }
+    else
+    {
+      /* The malloc of this slot failed here. */
+      if (objs[rec.id] == NULL)
+      {
+        skipped++;
+        continue;
+      }
+      tin = aeagle_timer_now();
+      vPortFree(objs[rec.id]);
+      tout = aeagle_timer_now();
+      objs[rec.id] = NULL;
+      free_cnt++;
+      aeagle_heapstat_free(obj_size[rec.id]);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        AEAGLE_LOG_TIME_DEFERRED("replay", "free", obj_size[rec.id], tin, tout, "OK", alloc_cnt, free_cnt);
+      }
+    }
+  }
+  if (rc < 0)
+  {
+    aeagle_trace_drain();
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "REPLAY_TRACE");
+  }
+  emit_snapshot("after_replay");
+
+  /* Whatever the trace leaves live. */
+  for (i = 0; i < r.objects; i++)
+  {
+    if (objs[i] == NULL)
+    {
+      continue;
+    }
+    tin = aeagle_timer_now();
+    vPortFree(objs[i]);
+    tout = aeagle_timer_now();
+    objs[i] = NULL;
+    free_cnt++;
+    aeagle_heapstat_free(obj_size[i]);
+    if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+    {
+      AEAGLE_LOG_TIME_DEFERRED("cleanup", "free", obj_size[i], tin, tout, "OK", alloc_cnt, free_cnt);
+    }
+  }
+  emit_snapshot("post_cleanup");
+
+done:
+  AEAGLE_LOG_META_VALUE("replay_records", r.records);
+  AEAGLE_LOG_META_VALUE("replay_skipped", skipped);
+  aeagle_trace_finish();
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
+  if (uart)
+  {
+    UART2_close(uart);
+  }
+  vTaskSuspend(NULL);
+}
+
+int main(void)
+{
+  Board_init();
+
+  xTaskCreate(ReplayTest, TEST_NAME, 512, NULL, 1, NULL);
+
+  vTaskStartScheduler();
+
+  for (;;)
+    ;
+  return 0;
+}
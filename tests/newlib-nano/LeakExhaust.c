@@ -7,58 +7,66 @@
 #define ALLOCATOR_NAME "newlib-nano"
 #define TEST_NAME "LeakExhaust"
 #define BLOCK_SIZE 128
+#ifdef CONFIG_NEWLIB_LIBC_ALIGNED_HEAP_SIZE
+#define HEAP_SIZE CONFIG_NEWLIB_LIBC_ALIGNED_HEAP_SIZE
+#else
+#define HEAP_SIZE 0
+#endif
 
-#define P_META() printk("META,tick_hz,%u\n", CONFIG_SYS_CLOCK_TICKS_PER_SEC)
-
-#define P_TIME(ph, op, sz, tin, tout, res)                                  \
-  printk("TIME,%s,%s,%u,%" PRIu64 ",%" PRIu64 ",%s,%u,%u\n", ph, op,        \
-         (unsigned)(sz), (uint64_t)(tin), (uint64_t)(tout), res, alloc_cnt, \
-         free_cnt)
-
-#define P_SNAP(ph, free_b, alloc_b, max_b)                                 \
-  printk("SNAP,%s,%zu,%zu,%zu\n", ph, (size_t)(free_b), (size_t)(alloc_b), \
-         (size_t)(max_b))
-
-#define P_FAULT(res) \
-  printk("FAULT,%" PRIu64 ",0xDEAD,%s\n", (uint64_t)k_uptime_ticks(), res)
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
 
 static uint32_t alloc_cnt, free_cnt;
 static size_t max_live_bytes;
 
 static void emit_snapshot(const char *phase)
 {
-  struct mallinfo mi = mallinfo();
-  if (mi.uordblks > max_live_bytes)
+  if (AEAGLE_HEAPSTAT_CHECK)
   {
-    max_live_bytes = mi.uordblks;
+    aeagle_trace_drain();
+    struct mallinfo mi = mallinfo();
+    if (mi.uordblks > max_live_bytes)
+    {
+      max_live_bytes = mi.uordblks;
+    }
+    AEAGLE_LOG_HEAP(phase, mi.fordblks, mi.uordblks, max_live_bytes);
   }
-  P_SNAP(phase, mi.fordblks, mi.uordblks, max_live_bytes);
+  AEAGLE_LOG_SNAP_DEFERRED(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
 }
 
 int main(void)
 {
   void *p;
 
-  printk("# %s %s start\n", ALLOCATOR_NAME, TEST_NAME);
-  P_META();
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  aeagle_heapstat_init(HEAP_SIZE);
 
   while (true)
   {
-    uint64_t tin = k_uptime_ticks();
+    aeagle_ts_t tin = aeagle_timer_now();
     p = malloc(BLOCK_SIZE);
-    uint64_t tout = k_uptime_ticks();
+    aeagle_ts_t tout = aeagle_timer_now();
     if (!p)
     {
-      P_TIME("leakloop", "malloc", BLOCK_SIZE, tin, tout, "NULL");
-      P_FAULT("OOM");
+      AEAGLE_LOG_TIME_DEFERRED("leakloop", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
+      aeagle_trace_drain();
+      AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
       break;
     }
     alloc_cnt++;
-    P_TIME("leakloop", "malloc", BLOCK_SIZE, tin, tout, "OK");
+    aeagle_heapstat_alloc(BLOCK_SIZE);
+    if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+    {
+      AEAGLE_LOG_TIME_DEFERRED("leakloop", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+    }
   }
 
   emit_snapshot("after_leakloop_exhaustion");
 
-  printk("# %s %s end\n", ALLOCATOR_NAME, TEST_NAME);
+  aeagle_trace_finish();
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include <inttypes.h>
+#include <malloc.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#define ALLOCATOR_NAME "newlib-nano"
+#define TEST_NAME "RandomSizes"
+#ifdef CONFIG_NEWLIB_LIBC_ALIGNED_HEAP_SIZE
+#define HEAP_SIZE CONFIG_NEWLIB_LIBC_ALIGNED_HEAP_SIZE
+#else
+#define HEAP_SIZE 0
+#endif
+
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
+#include "aeagle_dist.h"
+
+static uint32_t alloc_cnt, free_cnt;
+static size_t max_live_bytes;
+
+static void emit_snapshot(const char *phase)
+{
+  aeagle_trace_drain();
+  if (AEAGLE_HEAPSTAT_CHECK)
+  {
+    struct mallinfo mi = mallinfo();
+    if (mi.uordblks > max_live_bytes)
+    {
+      max_live_bytes = mi.uordblks;
+    }
+    AEAGLE_LOG_HEAP(phase, mi.fordblks, mi.uordblks, max_live_bytes);
+  }
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+/* Frees slot i, if its malloc succeeded, and empties it. */
+static void release(int i, const char *phase)
+{
+  struct aeagle_dist_obj *o = &aeagle_dist_objs[i];
+  aeagle_ts_t tin, tout;
+
+  if (o->p != NULL)
+  {
+    tin = aeagle_timer_now();
+    free(o->p);
+    tout = aeagle_timer_now();
+    free_cnt++;
+    aeagle_heapstat_free(o->size);
+    if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+    {
+      AEAGLE_LOG_TIME_DEFERRED(phase, "free", o->size, tin, tout, "OK", alloc_cnt, free_cnt);
+    }
+  }
+  o->p = NULL;
+  o->size = 0;
+}
+
+int main(void)
+{
+  aeagle_ts_t tin, tout;
+  uint32_t n, size;
+  unsigned dist;
+  int i;
+  void *p;
+
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  AEAGLE_LOG_META_VALUE("dist_seed", AEAGLE_DIST_SEED);
+  aeagle_heapstat_init(HEAP_SIZE);
+
+  emit_snapshot("baseline");
+
+  for (dist = 0; dist < AEAGLE_DIST_COUNT; dist++)
+  {
+    aeagle_dist_begin(dist);
+    for (n = 0; n < AEAGLE_DIST_OPS; n++)
+    {
+      while ((i = aeagle_dist_expired(n)) >= 0)
+      {
+        release(i, aeagle_dist_names[dist]);
+      }
+      i = aeagle_dist_slot();
+      if (aeagle_dist_objs[i].size != 0)
+      {
+        release(i, aeagle_dist_names[dist]);
+      }
+      size = aeagle_dist_size(dist);
+      aeagle_dist_objs[i].size = size;
+      aeagle_dist_objs[i].expires = n + aeagle_dist_life();
+
+      tin = aeagle_timer_now();
+      p = malloc(size);
+      tout = aeagle_timer_now();
+      aeagle_dist_objs[i].p = p;
+      if (!p)
+      {
+        AEAGLE_LOG_TIME_DEFERRED(aeagle_dist_names[dist], "malloc", size, tin, tout, "NULL", alloc_cnt, free_cnt);
+        continue;
+      }
+      alloc_cnt++;
+      aeagle_heapstat_alloc(size);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        AEAGLE_LOG_TIME_DEFERRED(aeagle_dist_names[dist], "malloc", size, tin, tout, "OK", alloc_cnt, free_cnt);
+      }
+    }
+    emit_snapshot(aeagle_dist_snaps[dist]);
+
+    /* Each distribution starts from an empty heap. */
+    for (i = 0; i < AEAGLE_DIST_SLOTS; i++)
+    {
+      release(i, "cleanup");
+    }
+  }
+  emit_snapshot("post_cleanup");
+
+  aeagle_trace_finish();
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
+  return 0;
+}
@@ -0,0 +1,144 @@
+#include <inttypes.h>
+#include <malloc.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#define ALLOCATOR_NAME "newlib"
+#define TEST_NAME "Contention"
+#ifdef CONFIG_NEWLIB_LIBC_ALIGNED_HEAP_SIZE
+#define HEAP_SIZE CONFIG_NEWLIB_LIBC_ALIGNED_HEAP_SIZE
+#else
+#define HEAP_SIZE 0
+#endif
+
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
+#include "aeagle_contention.h"
+
+static size_t max_live_bytes;
+
+static void emit_snapshot(const char *phase)
+{
+  aeagle_trace_drain();
+  if (AEAGLE_HEAPSTAT_CHECK)
+  {
+    struct mallinfo mi = mallinfo();
+    if (mi.uordblks > max_live_bytes)
+    {
+      max_live_bytes = mi.uordblks;
+    }
+    AEAGLE_LOG_HEAP(phase, mi.fordblks, mi.uordblks, max_live_bytes);
+  }
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+#define STACK_SIZE 1024
+
+K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, AEAGLE_CONTENTION_TASKS, STACK_SIZE);
+static struct k_thread workers[AEAGLE_CONTENTION_TASKS];
+
+/* Task k of the workload; see aeagle_contention.h. */
+static void contention_worker(unsigned k)
+{
+  void *held[AEAGLE_CONTENTION_HOLD] = {0};
+  uint32_t held_size[AEAGLE_CONTENTION_HOLD];
+  aeagle_ts_t tin, tout;
+  uint32_t i, h, seq, size;
+  void *p;
+  /* The sleepers' schedule, in kernel ticks. */
+  int64_t first = k_uptime_ticks(), next = first;
+  aeagle_ts_t t0 = aeagle_timer_now();
+
+  for (i = 0; k == 0 ? !aeagle_contention_stop : i < AEAGLE_CONTENTION_OPS; i++)
+  {
+    h = i % AEAGLE_CONTENTION_HOLD;
+    if (held[h] == NULL)
+    {
+      size = aeagle_contention_sizes[(i / AEAGLE_CONTENTION_HOLD + k) % 4];
+      seq = aeagle_contention_seq;
+      tin = aeagle_timer_now();
+      p = malloc(size);
+      tout = aeagle_timer_now();
+      aeagle_contention_done(k, AEAGLE_CONTENTION_MALLOC, size, tin, tout, seq, p != NULL);
+      held[h] = p;
+      held_size[h] = size;
+    }
+    else
+    {
+      seq = aeagle_contention_seq;
+      tin = aeagle_timer_now();
+      free(held[h]);
+      tout = aeagle_timer_now();
+      aeagle_contention_done(k, AEAGLE_CONTENTION_FREE, held_size[h], tin, tout, seq, 1);
+      held[h] = NULL;
+    }
+    if (k > 0)
+    {
+      /* Absolute deadlines: a late wake-up does not move the next one. */
+      next += k_us_to_ticks_ceil64(k * AEAGLE_CONTENTION_PERIOD_US);
+      k_sleep(K_TIMEOUT_ABS_TICKS(next));
+      aeagle_contention_woke(k, t0, (uint64_t)(next - first), CONFIG_SYS_CLOCK_TICKS_PER_SEC);
+    }
+#ifdef CONFIG_ARCH_POSIX
+    else
+    {
+      /* native_sim only lets time pass, and the sleepers wake, while the CPU waits. */
+      k_busy_wait(1);
+    }
+#endif
+  }
+  for (h = 0; h < AEAGLE_CONTENTION_HOLD; h++)
+  {
+    if (held[h] != NULL)
+    {
+      seq = aeagle_contention_seq;
+      tin = aeagle_timer_now();
+      free(held[h]);
+      tout = aeagle_timer_now();
+      aeagle_contention_done(k, AEAGLE_CONTENTION_FREE, held_size[h], tin, tout, seq, 1);
+    }
+  }
+  aeagle_contention_exit();
+}
+
+static void contention_entry(void *p1, void *p2, void *p3)
+{
+  (void)p2;
+  (void)p3;
+  contention_worker((unsigned)(uintptr_t)p1);
+}
+
+int main(void)
+{
+  unsigned k;
+
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  AEAGLE_LOG_META_VALUE("contention_tasks", AEAGLE_CONTENTION_TASKS);
+  aeagle_heapstat_init(HEAP_SIZE);
+
+  emit_snapshot("baseline");
+
+  aeagle_contention_reset();
+  /* Below main, which only waits; task 0 lowest. */
+  for (k = 0; k < AEAGLE_CONTENTION_TASKS; k++)
+  {
+    k_thread_create(&workers[k], worker_stacks[k], K_THREAD_STACK_SIZEOF(worker_stacks[k]), contention_entry,
+                    (void *)(uintptr_t)k, NULL, NULL, K_PRIO_PREEMPT(AEAGLE_CONTENTION_TASKS - k), 0, K_NO_WAIT);
+  }
+  for (k = 1; k < AEAGLE_CONTENTION_TASKS; k++)
+  {
+    k_thread_join(&workers[k], K_FOREVER);
+  }
+  aeagle_contention_stop = 1;
+  k_thread_join(&workers[0], K_FOREVER);
+
+  emit_snapshot("after_contention");
+  aeagle_contention_report();
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
+  return 0;
+}
@@ -4,37 +4,34 @@
 #include <string.h> // Required for memset
 #include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
+#include "aeagle_log.h"
+#include "aeagle_heapstat.h"
 
 #define ALLOCATOR_NAME "newlib"
 #define TEST_NAME "HeapOverflow"
 #define BLOCK_SIZE 128
 #define OVERSHOOT 16
-
-#define P_META() printk("META,tick_hz,%u\n", CONFIG_SYS_CLOCK_TICKS_PER_SEC)
-
-#define P_TIME(ph, op, sz, tin, tout, res)                                  \
-  printk("TIME,%s,%s,%u,%" PRIu64 ",%" PRIu64 ",%s,%u,%u\n", ph, op,        \
-         (unsigned)(sz), (uint64_t)(tin), (uint64_t)(tout), res, alloc_cnt, \
-         free_cnt)
-
-#define P_SNAP(ph, free_b, alloc_b, max_b)                                 \
-  printk("SNAP,%s,%zu,%zu,%zu\n", ph, (size_t)(free_b), (size_t)(alloc_b), \
-         (size_t)(max_b))
-
-#define P_FAULT(res) \
-  printk("FAULT,%" PRIu64 ",0xDEAD,%s\n", (uint64_t)k_uptime_ticks(), res)
+#ifdef CONFIG_NEWLIB_LIBC_ALIGNED_HEAP_SIZE
+#define HEAP_SIZE CONFIG_NEWLIB_LIBC_ALIGNED_HEAP_SIZE
+#else
+#define HEAP_SIZE 0
+#endif
 
 static uint32_t alloc_cnt, free_cnt;
 static size_t max_live_bytes;
 
 static void emit_snapshot(const char *phase)
 {
-  struct mallinfo mi = mallinfo();
-  if (mi.uordblks > max_live_bytes)
+  if (AEAGLE_HEAPSTAT_CHECK)
   {
-    max_live_bytes = mi.uordblks;
+    struct mallinfo mi = mallinfo();
+    if (mi.uordblks > max_live_bytes)
+    {
+      max_live_bytes = mi.uordblks;
+    }
+    AEAGLE_LOG_HEAP(phase, mi.fordblks, mi.uordblks, max_live_bytes);
   }
-  P_SNAP(phase, mi.fordblks, mi.uordblks, max_live_bytes);
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
 }
 
 int main(void)
@@ -42,89 +39,97 @@ int main(void)
   void *A = NULL;
   void *B = NULL;
   void *C = NULL;
-  uint64_t tin, tout;
+  aeagle_ts_t tin, tout;
 
-  printk("# %s %s start\n", ALLOCATOR_NAME, TEST_NAME);
-  P_META();
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  aeagle_heapstat_init(HEAP_SIZE);
 
-  tin = k_uptime_ticks();
+  tin = aeagle_timer_now();
   A = malloc(BLOCK_SIZE);
-  tout = k_uptime_ticks();
+  tout = aeagle_timer_now();
   if (!A)
   {
-    P_TIME("setup", "malloc", BLOCK_SIZE, tin, tout, "NULL");
-    P_FAULT("OOM");
+    AEAGLE_LOG_TIME("setup", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
     goto done;
   }
   alloc_cnt++;
-  P_TIME("setup", "malloc", BLOCK_SIZE, tin, tout, "OK");
+  aeagle_heapstat_alloc(BLOCK_SIZE);
+  AEAGLE_LOG_TIME("setup", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
 
-  tin = k_uptime_ticks();
+  tin = aeagle_timer_now();
   B = malloc(BLOCK_SIZE);
-  tout = k_uptime_ticks();
+  tout = aeagle_timer_now();
   if (!B)
   {
-    P_TIME("setup", "malloc", BLOCK_SIZE, tin, tout, "NULL");
-    P_FAULT("OOM");
+    AEAGLE_LOG_TIME("setup", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
     goto cleanup_A;
   }
   alloc_cnt++;
-  P_TIME("setup", "malloc", BLOCK_SIZE, tin, tout, "OK");
+  aeagle_heapstat_alloc(BLOCK_SIZE);
+  AEAGLE_LOG_TIME("setup", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
 
   emit_snapshot("after_setup");
 
-  tin = k_uptime_ticks();
+  tin = aeagle_timer_now();
   memset(A, 0xFF, BLOCK_SIZE + OVERSHOOT);
-  tout = k_uptime_ticks();
-  P_TIME("hof_write", "memset_overflow", BLOCK_SIZE + OVERSHOOT, tin, tout, "HOF_WRITE_DONE");
+  tout = aeagle_timer_now();
+  AEAGLE_LOG_TIME("hof_write", "memset_overflow", BLOCK_SIZE + OVERSHOOT, tin, tout, "HOF_WRITE_DONE", alloc_cnt, free_cnt);
 
   emit_snapshot("post_primitive_trigger");
 
-  tin = k_uptime_ticks();
+  tin = aeagle_timer_now();
   C = malloc(BLOCK_SIZE);
-  tout = k_uptime_ticks();
+  tout = aeagle_timer_now();
   if (!C)
   {
-    P_TIME("hof_check_alloc", "malloc", BLOCK_SIZE, tin, tout, "NULL");
-    P_FAULT("OOM");
+    AEAGLE_LOG_TIME("hof_check_alloc", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
   }
   else
   {
     alloc_cnt++;
-    P_TIME("hof_check_alloc", "malloc", BLOCK_SIZE, tin, tout, "OK");
+    aeagle_heapstat_alloc(BLOCK_SIZE);
+    AEAGLE_LOG_TIME("hof_check_alloc", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
 
-    uint64_t tin_free_c = k_uptime_ticks();
+    aeagle_ts_t tin_free_c = aeagle_timer_now();
     free(C);
-    uint64_t tout_free_c = k_uptime_ticks();
+    aeagle_ts_t tout_free_c = aeagle_timer_now();
     free_cnt++;
-    P_TIME("cleanup", "free", BLOCK_SIZE, tin_free_c, tout_free_c, "OK");
+    aeagle_heapstat_free(BLOCK_SIZE);
+    AEAGLE_LOG_TIME("cleanup", "free", BLOCK_SIZE, tin_free_c, tout_free_c, "OK", alloc_cnt, free_cnt);
     C = NULL;
   }
   emit_snapshot("after_hof_check_alloc");
 
   if (B)
   {
-    uint64_t tin_free_b = k_uptime_ticks();
+    aeagle_ts_t tin_free_b = aeagle_timer_now();
     free(B);
-    uint64_t tout_free_b = k_uptime_ticks();
+    aeagle_ts_t tout_free_b = aeagle_timer_now();
     free_cnt++;
-    P_TIME("cleanup", "free", BLOCK_SIZE, tin_free_b, tout_free_b, "OK");
+    aeagle_heapstat_free(BLOCK_SIZE);
+    AEAGLE_LOG_TIME("cleanup", "free", BLOCK_SIZE, tin_free_b, tout_free_b, "OK", alloc_cnt, free_cnt);
     B = NULL;
   }
 
 cleanup_A:
   if (A)
   {
-    uint64_t tin_free_a = k_uptime_ticks();
+    aeagle_ts_t tin_free_a = aeagle_timer_now();
     free(A);
-    uint64_t tout_free_a = k_uptime_ticks();
+    aeagle_ts_t tout_free_a = aeagle_timer_now();
     free_cnt++;
-    P_TIME("cleanup", "free", BLOCK_SIZE, tin_free_a, tout_free_a, "OK");
+    aeagle_heapstat_free(BLOCK_SIZE);
+    AEAGLE_LOG_TIME("cleanup", "free", BLOCK_SIZE, tin_free_a, tout_free_a, "OK", alloc_cnt, free_cnt);
     A = NULL;
   }
   emit_snapshot("post_cleanup");
 
 done:
-  printk("# %s %s end\n", ALLOCATOR_NAME, TEST_NAME);
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
   return 0;
 }
\ No newline at end of file
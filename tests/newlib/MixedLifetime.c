@@ -11,32 +11,32 @@
 #define PIN_COUNT 5
 #define BURST_ROUNDS 10
 #define BURST_COUNT 10
+#ifdef CONFIG_NEWLIB_LIBC_ALIGNED_HEAP_SIZE
+#define HEAP_SIZE CONFIG_NEWLIB_LIBC_ALIGNED_HEAP_SIZE
+#else
+#define HEAP_SIZE 0
+#endif
 
-#define P_META() printk("META,tick_hz,%u\n", CONFIG_SYS_CLOCK_TICKS_PER_SEC)
-
-#define P_TIME(ph, op, sz, tin, tout, res)                                  \
-  printk("TIME,%s,%s,%u,%" PRIu64 ",%" PRIu64 ",%s,%u,%u\n", ph, op,        \
-         (unsigned)(sz), (uint64_t)(tin), (uint64_t)(tout), res, alloc_cnt, \
-         free_cnt)
-
-#define P_SNAP(ph, free_b, alloc_b, max_b)                                 \
-  printk("SNAP,%s,%zu,%zu,%zu\n", ph, (size_t)(free_b), (size_t)(alloc_b), \
-         (size_t)(max_b))
-
-#define P_FAULT(res) \
-  printk("FAULT,%" PRIu64 ",0xDEAD,%s\n", (uint64_t)k_uptime_ticks(), res)
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
 
 static uint32_t alloc_cnt, free_cnt;
 static size_t max_live_bytes;
 
 static void emit_snapshot(const char *phase)
 {
-  struct mallinfo mi = mallinfo();
-  if (mi.uordblks > max_live_bytes)
+  aeagle_trace_drain();
+  if (AEAGLE_HEAPSTAT_CHECK)
   {
-    max_live_bytes = mi.uordblks;
+    struct mallinfo mi = mallinfo();
+    if (mi.uordblks > max_live_bytes)
+    {
+      max_live_bytes = mi.uordblks;
+    }
+    AEAGLE_LOG_HEAP(phase, mi.fordblks, mi.uordblks, max_live_bytes);
   }
-  P_SNAP(phase, mi.fordblks, mi.uordblks, max_live_bytes);
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
 }
 
 int main(void)
@@ -44,7 +44,7 @@ int main(void)
   void *pinned[PIN_COUNT];
   void *buf[BURST_COUNT];
   char snap_phase_label[64];
-  uint64_t tin, tout;
+  aeagle_ts_t tin, tout;
   int i, round_idx, j_idx; // Declare loop variables outside for goto handling
 
   for (i = 0; i < PIN_COUNT; ++i)
@@ -52,22 +52,29 @@ int main(void)
   for (i = 0; i < BURST_COUNT; ++i)
     buf[i] = NULL;
 
-  printk("# %s %s start\n", ALLOCATOR_NAME, TEST_NAME);
-  P_META();
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  aeagle_heapstat_init(HEAP_SIZE);
 
   for (i = 0; i < PIN_COUNT; ++i)
   {
-    tin = k_uptime_ticks();
+    tin = aeagle_timer_now();
     pinned[i] = malloc(BLOCK_SIZE * 2);
-    tout = k_uptime_ticks();
+    tout = aeagle_timer_now();
     if (!pinned[i])
     {
-      P_TIME("pin", "malloc", BLOCK_SIZE * 2, tin, tout, "NULL");
-      P_FAULT("OOM");
+      AEAGLE_LOG_TIME_DEFERRED("pin", "malloc", BLOCK_SIZE * 2, tin, tout, "NULL", alloc_cnt, free_cnt);
+      aeagle_trace_drain();
+      AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
       goto cleanup_on_pin_failure;
     }
     alloc_cnt++;
-    P_TIME("pin", "malloc", BLOCK_SIZE * 2, tin, tout, "OK");
+    aeagle_heapstat_alloc(BLOCK_SIZE * 2);
+    if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+    {
+      AEAGLE_LOG_TIME_DEFERRED("pin", "malloc", BLOCK_SIZE * 2, tin, tout, "OK", alloc_cnt, free_cnt);
+    }
   }
   emit_snapshot("after_pins");
 
@@ -76,19 +83,24 @@ int main(void)
     int current_burst_successful_allocs = 0;
     for (i = 0; i < BURST_COUNT; ++i)
     {
-      tin = k_uptime_ticks();
+      tin = aeagle_timer_now();
       buf[i] = malloc(BLOCK_SIZE);
-      tout = k_uptime_ticks();
+      tout = aeagle_timer_now();
       if (!buf[i])
       {
-        P_TIME("burst", "malloc", BLOCK_SIZE, tin, tout, "NULL");
-        P_FAULT("OOM");
+        AEAGLE_LOG_TIME_DEFERRED("burst", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
+        aeagle_trace_drain();
+        AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
         // Note: Potential leak of buf[0] to buf[i-1] from this round
         // A more robust cleanup would free these before jumping.
         goto cleanup_pinned_only;
       }
       alloc_cnt++;
-      P_TIME("burst", "malloc", BLOCK_SIZE, tin, tout, "OK");
+      aeagle_heapstat_alloc(BLOCK_SIZE);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        AEAGLE_LOG_TIME_DEFERRED("burst", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+      }
       current_burst_successful_allocs++;
     }
     snprintf(snap_phase_label, sizeof(snap_phase_label), "after_burst_alloc_%d", round_idx);
@@ -96,12 +108,16 @@ int main(void)
 
     for (j_idx = current_burst_successful_allocs - 1; j_idx >= 0; --j_idx)
     {
-      tin = k_uptime_ticks();
+      tin = aeagle_timer_now();
       free(buf[j_idx]);
       buf[j_idx] = NULL; // Mark as freed
-      tout = k_uptime_ticks();
+      tout = aeagle_timer_now();
       free_cnt++;
-      P_TIME("burst", "free", BLOCK_SIZE, tin, tout, "OK");
+      aeagle_heapstat_free(BLOCK_SIZE);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        AEAGLE_LOG_TIME_DEFERRED("burst", "free", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+      }
     }
     snprintf(snap_phase_label, sizeof(snap_phase_label), "after_burst_free_%d", round_idx);
     emit_snapshot(snap_phase_label);
@@ -113,17 +129,22 @@ cleanup_on_pin_failure: // Label for OOM during pinning or bursting
   {
     if (pinned[i])
     {
-      tin = k_uptime_ticks();
+      tin = aeagle_timer_now();
       free(pinned[i]);
       pinned[i] = NULL; // Mark as freed
-      tout = k_uptime_ticks();
+      tout = aeagle_timer_now();
       free_cnt++;
-      P_TIME("cleanup", "free", BLOCK_SIZE * 2, tin, tout, "OK");
+      aeagle_heapstat_free(BLOCK_SIZE * 2);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        AEAGLE_LOG_TIME_DEFERRED("cleanup", "free", BLOCK_SIZE * 2, tin, tout, "OK", alloc_cnt, free_cnt);
+      }
     }
   }
   emit_snapshot("post_cleanup");
 
 done:
-  printk("# %s %s end\n", ALLOCATOR_NAME, TEST_NAME);
+  aeagle_trace_finish();
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
   return 0;
 }
\ No newline at end of file
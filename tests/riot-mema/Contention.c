@@ -0,0 +1,150 @@
+#include "memarray.h"
+#include "thread.h"
+#include "ztimer.h"
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
+#include "aeagle_contention.h"
+
+#define ALLOCATOR_NAME "riot-mema"
+#define TEST_NAME "Contention"
+#define NUM_BLOCKS 64
+#define BLOCK_SIZE 128
+
+static uint8_t pool_data[NUM_BLOCKS * BLOCK_SIZE];
+static memarray_t pool;
+
+static size_t max_allocated_bytes_mema = 0;
+
+static void emit_snapshot_mema(const char *phase)
+{
+       aeagle_trace_drain();
+       if (AEAGLE_HEAPSTAT_CHECK)
+       {
+              size_t free_blocks = memarray_available(&pool);
+              size_t used_blocks = NUM_BLOCKS - free_blocks;
+              size_t current_allocated_bytes = used_blocks * BLOCK_SIZE;
+              size_t current_free_bytes = free_blocks * BLOCK_SIZE;
+
+              if (current_allocated_bytes > max_allocated_bytes_mema)
+              {
+                     max_allocated_bytes_mema = current_allocated_bytes;
+              }
+              AEAGLE_LOG_HEAP(phase, current_free_bytes, current_allocated_bytes, max_allocated_bytes_mema);
+       }
+       AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+static char worker_stacks[AEAGLE_CONTENTION_TASKS][THREAD_STACKSIZE_DEFAULT];
+
+/* Task k of the workload; see aeagle_contention.h. */
+static void contention_worker(unsigned k)
+{
+       void *held[AEAGLE_CONTENTION_HOLD] = {0};
+       uint32_t held_size[AEAGLE_CONTENTION_HOLD];
+       aeagle_ts_t tin, tout;
+       uint32_t i, h, seq, size;
+       unsigned state;
+       void *p;
+       /* The sleepers' schedule, in microseconds. */
+       uint32_t first = ztimer_now(ZTIMER_USEC), last = first;
+       aeagle_ts_t t0 = aeagle_timer_now();
+
+       for (i = 0; k == 0 ? !aeagle_contention_stop : i < AEAGLE_CONTENTION_OPS; i++)
+       {
+              h = i % AEAGLE_CONTENTION_HOLD;
+              if (held[h] == NULL)
+              {
+                     size = aeagle_contention_sizes[(i / AEAGLE_CONTENTION_HOLD + k) % 4];
+                     seq = aeagle_contention_seq;
+                     tin = aeagle_timer_now();
+                     /* memarray has no lock of its own; callers take this one. */
+                     state = irq_disable();
+                     p = memarray_alloc(&pool);
+                     irq_restore(state);
+                     tout = aeagle_timer_now();
+                     aeagle_contention_done(k, AEAGLE_CONTENTION_MALLOC, size, tin, tout, seq, p != NULL);
+                     held[h] = p;
+                     held_size[h] = size;
+              }
+              else
+              {
+                     seq = aeagle_contention_seq;
+                     tin = aeagle_timer_now();
+                     state = irq_disable();
+                     memarray_free(&pool, held[h]);
+                     irq_restore(state);
+                     tout = aeagle_timer_now();
+                     aeagle_contention_done(k, AEAGLE_CONTENTION_FREE, held_size[h], tin, tout, seq, 1);
+                     held[h] = NULL;
+              }
+              if (k > 0)
+              {
+                     /* Absolute deadlines: a late wake-up does not move the next one. */
+                     ztimer_periodic_wakeup(ZTIMER_USEC, &last, k * AEAGLE_CONTENTION_PERIOD_US);
+                     aeagle_contention_woke(k, t0, last - first, 1000000);
+              }
+       }
+       for (h = 0; h < AEAGLE_CONTENTION_HOLD; h++)
+       {
+              if (held[h] != NULL)
+              {
+                     seq = aeagle_contention_seq;
+                     tin = aeagle_timer_now();
+                     state = irq_disable();
+                     memarray_free(&pool, held[h]);
+                     irq_restore(state);
+                     tout = aeagle_timer_now();
+                     aeagle_contention_done(k, AEAGLE_CONTENTION_FREE, held_size[h], tin, tout, seq, 1);
+              }
+       }
+       aeagle_contention_exit();
+}
+
+static void *contention_thread(void *arg)
+{
+       contention_worker((unsigned)(uintptr_t)arg);
+       return NULL;
+}
+
+int main(void)
+{
+       unsigned k;
+
+       memarray_init(&pool, pool_data, BLOCK_SIZE, NUM_BLOCKS);
+
+       AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+       aeagle_timer_init();
+       AEAGLE_LOG_META();
+       AEAGLE_LOG_META_VALUE("contention_tasks", AEAGLE_CONTENTION_TASKS);
+       aeagle_heapstat_init(NUM_BLOCKS * BLOCK_SIZE);
+
+       emit_snapshot_mema("baseline");
+
+       aeagle_contention_reset();
+       /* Below main, which only waits; task 0 lowest. */
+       for (k = 0; k < AEAGLE_CONTENTION_TASKS; k++)
+       {
+              thread_create(worker_stacks[k], sizeof(worker_stacks[k]), THREAD_PRIORITY_MAIN + AEAGLE_CONTENTION_TASKS - k, 0,
+                            contention_thread, (void *)(uintptr_t)k, "worker");
+       }
+       while (aeagle_contention_finished < AEAGLE_CONTENTION_TASKS - 1)
+       {
+              ztimer_sleep(ZTIMER_USEC, 10000);
+       }
+       aeagle_contention_stop = 1;
+       while (aeagle_contention_finished < AEAGLE_CONTENTION_TASKS)
+       {
+              ztimer_sleep(ZTIMER_USEC, 10000);
+       }
+
+       emit_snapshot_mema("after_contention");
+       aeagle_contention_report();
+       AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
+       return 0;
+}
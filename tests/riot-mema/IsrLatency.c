@@ -0,0 +1,164 @@
+#include "irq.h"
+#include "memarray.h"
+#include "ztimer.h"
+#include "ztimer/periodic.h"
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
+#include "aeagle_isr.h"
+
+#define ALLOCATOR_NAME "riot-mema"
+#define TEST_NAME "IsrLatency"
+#define NUM_BLOCKS 64
+#define BLOCK_SIZE 128
+
+static uint8_t pool_data[NUM_BLOCKS * BLOCK_SIZE];
+static memarray_t pool;
+
+static size_t max_allocated_bytes_mema = 0;
+
+static void emit_snapshot_mema(const char *phase)
+{
+       aeagle_trace_drain();
+       if (AEAGLE_HEAPSTAT_CHECK)
+       {
+              size_t free_blocks = memarray_available(&pool);
+              size_t used_blocks = NUM_BLOCKS - free_blocks;
+              size_t current_allocated_bytes = used_blocks * BLOCK_SIZE;
+              size_t current_free_bytes = free_blocks * BLOCK_SIZE;
+
+              if (current_allocated_bytes > max_allocated_bytes_mema)
+              {
+                     max_allocated_bytes_mema = current_allocated_bytes;
+              }
+              AEAGLE_LOG_HEAP(phase, current_free_bytes, current_allocated_bytes, max_allocated_bytes_mema);
+       }
+       AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+static ztimer_periodic_t isr_timer;
+
+/* Timer callback, in the ztimer's ISR. The task's calls hold interrupts off,
+ * so the ISR uses the same pool. */
+static bool isr_tick(void *arg)
+{
+       struct aeagle_isr_sample *s = aeagle_isr_enter(aeagle_timer_now());
+       void *p;
+
+       (void)arg;
+       if (s == NULL)
+       {
+              return ZTIMER_PERIODIC_KEEP_GOING;
+       }
+       if (aeagle_isr_block == NULL)
+       {
+              s->t_in = aeagle_timer_now();
+              p = memarray_alloc(&pool);
+              s->t_out = aeagle_timer_now();
+              s->op = AEAGLE_ISR_MALLOC;
+              s->ok = p != NULL;
+              aeagle_isr_block = p;
+       }
+       else
+       {
+              s->t_in = aeagle_timer_now();
+              memarray_free(&pool, aeagle_isr_block);
+              s->t_out = aeagle_timer_now();
+              s->op = AEAGLE_ISR_FREE;
+              s->ok = 1;
+              aeagle_isr_block = NULL;
+       }
+       aeagle_isr_leave();
+       return ZTIMER_PERIODIC_KEEP_GOING;
+}
+
+/* The task's side of a phase, until the ISR has its samples; returns the
+ * heap calls made. */
+static uint32_t isr_background(unsigned phase)
+{
+       void *held[AEAGLE_ISR_HOLD] = {0};
+       uint32_t held_size[AEAGLE_ISR_HOLD];
+       aeagle_ts_t start = aeagle_timer_now();
+       uint32_t calls = 0, h;
+       unsigned state;
+
+       while (aeagle_isr_pending(start))
+       {
+              if (phase == AEAGLE_ISR_IDLE)
+              {
+                     continue;
+              }
+              h = calls % AEAGLE_ISR_HOLD;
+              if (held[h] == NULL)
+              {
+                     held_size[h] = aeagle_isr_sizes[(calls / AEAGLE_ISR_HOLD) % 4];
+                     /* memarray has no lock of its own; callers take this one. */
+                     state = irq_disable();
+                     held[h] = memarray_alloc(&pool);
+                     irq_restore(state);
+                     if (held[h] != NULL)
+                     {
+                            aeagle_heapstat_alloc(held_size[h]);
+                     }
+              }
+              else
+              {
+                     state = irq_disable();
+                     memarray_free(&pool, held[h]);
+                     irq_restore(state);
+                     aeagle_heapstat_free(held_size[h]);
+                     held[h] = NULL;
+              }
+              calls++;
+       }
+       for (h = 0; h < AEAGLE_ISR_HOLD; h++)
+       {
+              if (held[h] != NULL)
+              {
+                     memarray_free(&pool, held[h]);
+                     aeagle_heapstat_free(held_size[h]);
+              }
+       }
+       return calls;
+}
+
+int main(void)
+{
+       unsigned phase;
+       uint32_t calls = 0;
+
+       memarray_init(&pool, pool_data, BLOCK_SIZE, NUM_BLOCKS);
+
+       AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+       aeagle_timer_init();
+       AEAGLE_LOG_META();
+       AEAGLE_LOG_META_VALUE("isr_period_us", AEAGLE_ISR_PERIOD_US);
+       aeagle_heapstat_init(NUM_BLOCKS * BLOCK_SIZE);
+
+       emit_snapshot_mema("baseline");
+
+       ztimer_periodic_init(ZTIMER_USEC, &isr_timer, isr_tick, NULL, AEAGLE_ISR_PERIOD_US);
+       for (phase = 0; phase < AEAGLE_ISR_PHASES; phase++)
+       {
+              aeagle_isr_begin();
+              ztimer_periodic_start(&isr_timer);
+              calls += isr_background(phase);
+              ztimer_periodic_stop(&isr_timer);
+              if (aeagle_isr_block != NULL)
+              {
+                     memarray_free(&pool, aeagle_isr_block);
+                     aeagle_isr_block = NULL;
+              }
+              emit_snapshot_mema(aeagle_isr_snaps[phase]);
+              aeagle_isr_report(phase);
+       }
+       AEAGLE_LOG_META_VALUE("isr_churn_calls", calls);
+
+       AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
+       return 0;
+}
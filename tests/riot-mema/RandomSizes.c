@@ -0,0 +1,131 @@
+#include "memarray.h"
+#include "ztimer.h"
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
+#include "aeagle_dist.h"
+
+#define ALLOCATOR_NAME "riot-mema"
+#define TEST_NAME "RandomSizes"
+#define NUM_BLOCKS 64
+#define BLOCK_SIZE 128
+
+static uint8_t pool_data[NUM_BLOCKS * BLOCK_SIZE];
+static memarray_t pool;
+
+static uint32_t alloc_cnt = 0;
+static uint32_t free_cnt = 0;
+static size_t max_allocated_bytes_mema = 0;
+
+static void emit_snapshot_mema(const char *phase)
+{
+       aeagle_trace_drain();
+       if (AEAGLE_HEAPSTAT_CHECK)
+       {
+              size_t free_blocks = memarray_available(&pool);
+              size_t used_blocks = NUM_BLOCKS - free_blocks;
+              size_t current_allocated_bytes = used_blocks * BLOCK_SIZE;
+              size_t current_free_bytes = free_blocks * BLOCK_SIZE;
+
+              if (current_allocated_bytes > max_allocated_bytes_mema)
+              {
+                     max_allocated_bytes_mema = current_allocated_bytes;
+              }
+              AEAGLE_LOG_HEAP(phase, current_free_bytes, current_allocated_bytes, max_allocated_bytes_mema);
+       }
+       AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+/* Frees slot i, if its malloc succeeded, and empties it. */
+static void release(int i, const char *phase)
+{
+       struct aeagle_dist_obj *o = &aeagle_dist_objs[i];
+       aeagle_ts_t tin, tout;
+
+       if (o->p != NULL)
+       {
+              tin = aeagle_timer_now();
+              memarray_free(&pool, o->p);
+              tout = aeagle_timer_now();
+              free_cnt++;
+              aeagle_heapstat_free(o->size);
+              if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+              {
+                     AEAGLE_LOG_TIME_DEFERRED(phase, "free", o->size, tin, tout, "OK", alloc_cnt, free_cnt);
+              }
+       }
+       o->p = NULL;
+       o->size = 0;
+}
+
+int main(void)
+{
+       aeagle_ts_t tin, tout;
+       uint32_t n, size;
+       unsigned dist;
+       int i;
+       void *p;
+
+       memarray_init(&pool, pool_data, BLOCK_SIZE, NUM_BLOCKS);
+
+       AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+       aeagle_timer_init();
+       AEAGLE_LOG_META();
+       AEAGLE_LOG_META_VALUE("dist_seed", AEAGLE_DIST_SEED);
+       aeagle_heapstat_init(NUM_BLOCKS * BLOCK_SIZE);
+
+       emit_snapshot_mema("baseline");
+
+       for (dist = 0; dist < AEAGLE_DIST_COUNT; dist++)
+       {
+              aeagle_dist_begin(dist);
+              for (n = 0; n < AEAGLE_DIST_OPS; n++)
+              {
+                     while ((i = aeagle_dist_expired(n)) >= 0)
+                     {
+                            release(i, aeagle_dist_names[dist]);
+                     }
+                     i = aeagle_dist_slot();
+                     if (aeagle_dist_objs[i].size != 0)
+                     {
+                            release(i, aeagle_dist_names[dist]);
+                     }
+                     size = aeagle_dist_size(dist);
+                     aeagle_dist_objs[i].size = size;
+                     aeagle_dist_objs[i].expires = n + aeagle_dist_life();
+
+                     tin = aeagle_timer_now();
+                     p = size <= BLOCK_SIZE ? memarray_alloc(&pool) : NULL;
+                     tout = aeagle_timer_now();
+                     aeagle_dist_objs[i].p = p;
+                     if (!p)
+                     {
+                            AEAGLE_LOG_TIME_DEFERRED(aeagle_dist_names[dist], "malloc", size, tin, tout, "NULL", alloc_cnt, free_cnt);
+                            continue;
+                     }
+                     alloc_cnt++;
+                     aeagle_heapstat_alloc(size);
+                     if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+                     {
+                            AEAGLE_LOG_TIME_DEFERRED(aeagle_dist_names[dist], "malloc", size, tin, tout, "OK", alloc_cnt, free_cnt);
+                     }
+              }
+              emit_snapshot_mema(aeagle_dist_snaps[dist]);
+
+              /* Each distribution starts from an empty heap. */
+              for (i = 0; i < AEAGLE_DIST_SLOTS; i++)
+              {
+                     release(i, "cleanup");
+              }
+       }
+       emit_snapshot_mema("post_cleanup");
+
+       aeagle_trace_finish();
+       AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
+       return 0;
+}
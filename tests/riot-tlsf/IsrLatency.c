@@ -0,0 +1,148 @@
+#include "malloc_monitor.h"
+#include "ztimer.h"
+#include "ztimer/periodic.h"
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
+#include "aeagle_isr.h"
+
+/* isr_tick calls malloc from the timer interrupt, which only tlsf-malloc
+ * makes safe; the C library's malloc has no interrupt lock. */
+#if !defined(MODULE_TLSF_MALLOC)
+#error "riot-tlsf needs RIOT_ALLOCATOR=tlsf (set by apps/demo-riot/Makefile for AEAGLE_SUITE=riot-tlsf)"
+#endif
+
+#define ALLOCATOR_NAME "riot-tlsf"
+#define TEST_NAME "IsrLatency"
+#define HEAP_SIZE 65536
+
+static void emit_snapshot_riot(const char *phase)
+{
+       aeagle_trace_drain();
+       if (AEAGLE_HEAPSTAT_CHECK)
+       {
+              size_t current_usage = malloc_monitor_get_usage_current();
+              size_t high_watermark = malloc_monitor_get_usage_high_watermark();
+              AEAGLE_LOG_HEAP(phase, 0, current_usage, high_watermark);
+       }
+       AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+static ztimer_periodic_t isr_timer;
+
+/* Timer callback, in the ztimer's ISR. tlsf-malloc takes the interrupt lock
+ * around every call, so malloc may be called from here (see the #error). */
+static bool isr_tick(void *arg)
+{
+       struct aeagle_isr_sample *s = aeagle_isr_enter(aeagle_timer_now());
+       void *p;
+
+       (void)arg;
+       if (s == NULL)
+       {
+              return ZTIMER_PERIODIC_KEEP_GOING;
+       }
+       if (aeagle_isr_block == NULL)
+       {
+              s->t_in = aeagle_timer_now();
+              p = malloc(AEAGLE_ISR_SIZE);
+              s->t_out = aeagle_timer_now();
+              s->op = AEAGLE_ISR_MALLOC;
+              s->ok = p != NULL;
+              aeagle_isr_block = p;
+       }
+       else
+       {
+              s->t_in = aeagle_timer_now();
+              free(aeagle_isr_block);
+              s->t_out = aeagle_timer_now();
+              s->op = AEAGLE_ISR_FREE;
+              s->ok = 1;
+              aeagle_isr_block = NULL;
+       }
+       aeagle_isr_leave();
+       return ZTIMER_PERIODIC_KEEP_GOING;
+}
+
+/* The task's side of a phase, until the ISR has its samples; returns the
+ * heap calls made. */
+static uint32_t isr_background(unsigned phase)
+{
+       void *held[AEAGLE_ISR_HOLD] = {0};
+       uint32_t held_size[AEAGLE_ISR_HOLD];
+       aeagle_ts_t start = aeagle_timer_now();
+       uint32_t calls = 0, h;
+
+       while (aeagle_isr_pending(start))
+       {
+              if (phase == AEAGLE_ISR_IDLE)
+              {
+                     continue;
+              }
+              h = calls % AEAGLE_ISR_HOLD;
+              if (held[h] == NULL)
+              {
+                     held_size[h] = aeagle_isr_sizes[(calls / AEAGLE_ISR_HOLD) % 4];
+                     held[h] = malloc(held_size[h]);
+                     if (held[h] != NULL)
+                     {
+                            aeagle_heapstat_alloc(held_size[h]);
+                     }
+              }
+              else
+              {
+                     free(held[h]);
+                     aeagle_heapstat_free(held_size[h]);
+                     held[h] = NULL;
+              }
+              calls++;
+       }
+       for (h = 0; h < AEAGLE_ISR_HOLD; h++)
+       {
+              if (held[h] != NULL)
+              {
+                     free(held[h]);
+                     aeagle_heapstat_free(held_size[h]);
+              }
+       }
+       return calls;
+}
+
+int main(void)
+{
+       unsigned phase;
+       uint32_t calls = 0;
+
+       AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+       aeagle_timer_init();
+       AEAGLE_LOG_META();
+       AEAGLE_LOG_META_VALUE("isr_period_us", AEAGLE_ISR_PERIOD_US);
+       aeagle_heapstat_init(0);
+
+       emit_snapshot_riot("baseline");
+
+       ztimer_periodic_init(ZTIMER_USEC, &isr_timer, isr_tick, NULL, AEAGLE_ISR_PERIOD_US);
+       for (phase = 0; phase < AEAGLE_ISR_PHASES; phase++)
+       {
+              aeagle_isr_begin();
+              ztimer_periodic_start(&isr_timer);
+              calls += isr_background(phase);
+              ztimer_periodic_stop(&isr_timer);
+              if (aeagle_isr_block != NULL)
+              {
+                     free(aeagle_isr_block);
+                     aeagle_isr_block = NULL;
+              }
+              emit_snapshot_riot(aeagle_isr_snaps[phase]);
+              aeagle_isr_report(phase);
+       }
+       AEAGLE_LOG_META_VALUE("isr_churn_calls", calls);
+
+       AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
+       return 0;
+}
@@ -5,81 +5,70 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
 
 #define ALLOCATOR_NAME "riot-tlsf"
-#define TICK_HZ 1000000
 #define TEST_NAME "LeakExhaust"
 #define HEAP_SIZE 65536
 #define ALLOC_SIZE 128
 
-#define PRINTF_LOG_RIOT(format, ...) \
-  do                                 \
-  {                                  \
-    printf(format, ##__VA_ARGS__);   \
-    fflush(stdout);                  \
-  } while (0)
-
-#define LOG_TEST_START(alloc_name, test_name_str) \
-  PRINTF_LOG_RIOT("\r\n# %s %s start\r\n", (alloc_name), (test_name_str))
-
-#define LOG_TEST_END(alloc_name, test_name_str) \
-  PRINTF_LOG_RIOT("# %s %s end\r\n", (alloc_name), (test_name_str))
-
-#define LOG_META_RIOT(tick_hz_val) \
-  PRINTF_LOG_RIOT("META,tick_hz,%u\r\n", (unsigned)(tick_hz_val))
-
-#define LOG_TIME_RIOT(phase_str, op_str, size_val, time_in, time_out, result_str, ac, fc) \
-  PRINTF_LOG_RIOT("TIME,%s,%s,%u,%u,%u,%s,%lu,%lu\r\n",                                   \
-                  (phase_str), (op_str), (unsigned)(size_val),                            \
-                  (unsigned)(time_in), (unsigned)(time_out), (result_str),                \
-                  (unsigned long)(ac), (unsigned long)(fc))
-
-#define LOG_SNAP_RIOT(phase_str, free_b_val, allocated_b_val, max_alloc_b_val) \
-  PRINTF_LOG_RIOT("SNAP,%s,%u,%u,%u\r\n",                                      \
-                  (phase_str), (unsigned)(free_b_val),                         \
-                  (unsigned)(allocated_b_val), (unsigned)(max_alloc_b_val))
-
-#define LOG_FAULT_RIOT(current_ticks, error_str) \
-  PRINTF_LOG_RIOT("FAULT,%u,0xDEAD,%s\r\n", (unsigned)(current_ticks), (error_str))
-
 static uint32_t alloc_cnt = 0;
 static uint32_t free_cnt = 0;
 
 static void emit_snapshot_riot(const char *phase)
 {
-  size_t current_usage = malloc_monitor_get_usage_current();
-  size_t high_watermark = malloc_monitor_get_usage_high_watermark();
-  LOG_SNAP_RIOT(phase, 0, current_usage, high_watermark);
+  if (AEAGLE_HEAPSTAT_CHECK)
+  {
+    aeagle_trace_drain();
+    size_t current_usage = malloc_monitor_get_usage_current();
+    size_t high_watermark = malloc_monitor_get_usage_high_watermark();
+    AEAGLE_LOG_HEAP(phase, 0, current_usage, high_watermark);
+  }
+  AEAGLE_LOG_SNAP_DEFERRED(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
 }
 
 int main(void)
 {
   malloc_monitor_reset_high_watermark();
 
-  LOG_TEST_START(ALLOCATOR_NAME, TEST_NAME);
-  LOG_META_RIOT(TICK_HZ);
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  /* tlsf-malloc takes whatever RAM is left: free reads 0, as before. */
+  aeagle_heapstat_init(0);
 
   emit_snapshot_riot("baseline");
 
   while (1)
   {
-    uint32_t t1 = ztimer_now(ZTIMER_USEC);
+    aeagle_ts_t t1 = aeagle_timer_now();
     void *p = malloc(ALLOC_SIZE);
-    uint32_t t2 = ztimer_now(ZTIMER_USEC);
+    aeagle_ts_t t2 = aeagle_timer_now();
 
     if (!p)
     {
-      LOG_TIME_RIOT("leakloop", "malloc", ALLOC_SIZE, t1, t2, "NULL", alloc_cnt, free_cnt);
-      LOG_FAULT_RIOT(ztimer_now(ZTIMER_USEC), "OOM");
+      AEAGLE_LOG_TIME_DEFERRED("leakloop", "malloc", ALLOC_SIZE, t1, t2, "NULL", alloc_cnt, free_cnt);
+      aeagle_trace_drain();
+      AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
       break;
     }
     alloc_cnt++;
-    LOG_TIME_RIOT("leakloop", "malloc", ALLOC_SIZE, t1, t2, "OK", alloc_cnt, free_cnt);
-    emit_snapshot_riot("after_alloc");
+    aeagle_heapstat_alloc(ALLOC_SIZE);
+    if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+    {
+      AEAGLE_LOG_TIME_DEFERRED("leakloop", "malloc", ALLOC_SIZE, t1, t2, "OK", alloc_cnt, free_cnt);
+    }
+    if (AEAGLE_LOG_SNAP_DUE(alloc_cnt))
+    {
+      emit_snapshot_riot("after_alloc");
+    }
   }
 
   emit_snapshot_riot("after_leakloop_exhaustion");
 
-  LOG_TEST_END(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_trace_finish();
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""Checks AEAgle.py's decoder against frames as include/aeagle_wire.h sends
+them. Run with: python -m unittest discover -s tests"""
+
+import binascii
+import sys
+import types
+import unittest
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+# The decoder does not touch the serial port; pyserial may be missing.
+sys.modules.setdefault("serial", types.ModuleType("serial"))
+import AEAgle  # noqa: E402
+
+WIRE_BATCH = 112  # AEAGLE_WIRE_BATCH
+HELLO, STR, BATCH = range(3)
+
+
+def uvarint(v: int) -> bytes:
+    out = bytearray()
+    while v >= 0x80:
+        out.append((v & 0x7F) | 0x80)
+        v >>= 7
+    out.append(v)
+    return bytes(out)
+
+
+def zigzag(v: int) -> bytes:
+    return uvarint((v << 1) ^ (v >> 63) & ((1 << 64) - 1))
+
+
+def cobs(data: bytes) -> bytes:
+    out, block = bytearray(), bytearray()
+    for b in data:
+        if b == 0:
+            out += bytes([len(block) + 1]) + block
+            block = bytearray()
+        else:
+            block.append(b)
+    return bytes(out + bytes([len(block) + 1]) + block)
+
+
+def frame(seq: int, kind: int, payload: bytes) -> bytes:
+    body = seq.to_bytes(2, "little") + bytes([kind]) + payload
+    body += binascii.crc_hqx(body, 0xFFFF).to_bytes(2, "little")
+    return b"\0" + cobs(body) + b"\0"
+
+
+def full_batch() -> bytes:
+    """TIME records filling exactly AEAGLE_WIRE_BATCH bytes: a keyframe and
+    then deltas. A t_in step of 5 encodes as 0x0a, i.e. a \\n per record."""
+    payload = bytearray([0x0F]) + uvarint(0) + uvarint(1) + uvarint(2) + uvarint(64)
+    payload += zigzag(1000) + zigzag(1) + zigzag(0) + uvarint(50)
+    while len(payload) < WIRE_BATCH:
+        payload += bytes([0]) + zigzag(5) + zigzag(1) + zigzag(0) + uvarint(200)
+    assert len(payload) == WIRE_BATCH
+    return bytes(payload)
+
+
+def stream() -> bytes:
+    out = frame(0, HELLO, uvarint(3) + uvarint(64) + uvarint(WIRE_BATCH))
+    for sid, name in enumerate((b"powerlaw", b"malloc", b"OK")):
+        out += frame(1 + sid, STR, uvarint(sid) + name)
+    return b"START\n" + out + frame(4, BATCH, full_batch()) + b"END\n"
+
+
+class WireDecoderTest(unittest.TestCase):
+    def check(self, data: bytes, chunk: int) -> None:
+        dec = AEAgle._WireDecoder()
+        items = []
+        for i in range(0, len(data), chunk):
+            items += dec.feed(data[i:i + chunk])
+        rows = [fields for kind, fields in items if kind == "row"]
+        lines = [fields[0] for kind, fields in items if kind == "line"]
+        self.assertEqual(lines, ["START", "END"])
+        self.assertEqual((dec.frames, dec.lost, dec.corrupt), (5, 0, 0))
+        self.assertEqual(len(rows), 18)
+        self.assertEqual(rows[0], ["TIME", "powerlaw", "malloc", "64", "1000", "1050", "OK", "1", "0"])
+        self.assertEqual(rows[-1], ["TIME", "powerlaw", "malloc", "64", "1085", "1285", "OK", "18", "0"])
+
+    def test_full_batch(self) -> None:
+        self.assertGreater(len(cobs(full_batch())), 80)
+        for chunk in (1, 7, 4096):
+            self.check(stream(), chunk)
+
+    def test_full_batch_crlf_console(self) -> None:
+        self.check(stream().replace(b"\n", b"\r\n"), 64)
+
+    def test_limit_covers_largest_frame(self) -> None:
+        longest = len(frame(0, BATCH, bytes([0x0A]) * WIRE_BATCH)) - 2
+        self.assertGreaterEqual(AEAgle._WireDecoder.max_frame(WIRE_BATCH), 2 * longest)
+
+
+if __name__ == "__main__":
+    unittest.main()
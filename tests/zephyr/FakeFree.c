@@ -4,34 +4,27 @@
 #include <zephyr/sys/mem_stats.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/sys/sys_heap.h>
+#include "aeagle_log.h"
+#include "aeagle_heapstat.h"
 
 #define ALLOCATOR_NAME "zephyr"
 #define TEST_NAME "FakeFree"
+#define HEAP_SIZE 65536
 #define BLOCK_SIZE 128
 
-K_HEAP_DEFINE(my_heap, 65536);
+K_HEAP_DEFINE(my_heap, HEAP_SIZE);
 
 static uint32_t alloc_cnt, free_cnt;
 
-#define P_META() printk("META,tick_hz,%u\n", CONFIG_SYS_CLOCK_TICKS_PER_SEC)
-
-#define P_TIME(ph, op, sz, ti, to, res)                                  \
-  printk("TIME,%s,%s,%u,%" PRIu64 ",%" PRIu64 ",%s,%u,%u\n", ph, op,     \
-         (unsigned)(sz), (uint64_t)(ti), (uint64_t)(to), res, alloc_cnt, \
-         free_cnt)
-
-#define P_SNAP(ph, st)                                         \
-  printk("SNAP,%s,%zu,%zu,%zu\n", ph, (size_t)(st).free_bytes, \
-         (size_t)(st).allocated_bytes, (size_t)(st).max_allocated_bytes)
-
-#define P_FAULT(res) \
-  printk("FAULT,%" PRIu64 ",0xDEAD,%s\n", (uint64_t)k_uptime_ticks(), res)
-
 static void emit_snapshot(const char *phase)
 {
-  struct sys_memory_stats st;
-  sys_heap_runtime_stats_get(&my_heap.heap, &st);
-  P_SNAP(phase, st);
+  if (AEAGLE_HEAPSTAT_CHECK)
+  {
+    struct sys_memory_stats st;
+    sys_heap_runtime_stats_get(&my_heap.heap, &st);
+    AEAGLE_LOG_HEAP(phase, st.free_bytes, st.allocated_bytes, st.max_allocated_bytes);
+  }
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
 }
 
 int main(void)
@@ -40,47 +33,51 @@ int main(void)
   uint8_t *p_offset;
   const size_t OFFSET = BLOCK_SIZE / 2;
 
-  printk("# %s %s start\n", ALLOCATOR_NAME, TEST_NAME);
-  P_META();
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  aeagle_heapstat_init(HEAP_SIZE);
 
   {
-    uint64_t tin = k_uptime_ticks();
+    aeagle_ts_t tin = aeagle_timer_now();
     p = k_heap_alloc(&my_heap, BLOCK_SIZE, K_NO_WAIT);
-    uint64_t tout = k_uptime_ticks();
+    aeagle_ts_t tout = aeagle_timer_now();
 
     if (!p)
     {
-      P_TIME("setup", "malloc", BLOCK_SIZE, tin, tout, "NULL");
-      P_FAULT("OOM");
+      AEAGLE_LOG_TIME("setup", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
+      AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
       goto done;
     }
     alloc_cnt++;
-    P_TIME("setup", "malloc", BLOCK_SIZE, tin, tout, "OK");
+    aeagle_heapstat_alloc(BLOCK_SIZE);
+    AEAGLE_LOG_TIME("setup", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
   }
   emit_snapshot("after_setup");
 
   p_offset = (uint8_t *)p + OFFSET;
   {
-    uint64_t tin = k_uptime_ticks();
+    aeagle_ts_t tin = aeagle_timer_now();
     k_heap_free(&my_heap, p_offset);
-    uint64_t tout = k_uptime_ticks();
+    aeagle_ts_t tout = aeagle_timer_now();
 
-    P_TIME("ff_trigger", "free", BLOCK_SIZE, tin, tout, "FF_ATTEMPT");
+    AEAGLE_LOG_TIME("ff_trigger", "free", BLOCK_SIZE, tin, tout, "FF_ATTEMPT", alloc_cnt, free_cnt);
   }
 
   emit_snapshot("post_primitive_trigger");
 
   {
-    uint64_t tin = k_uptime_ticks();
+    aeagle_ts_t tin = aeagle_timer_now();
     k_heap_free(&my_heap, p);
-    uint64_t tout = k_uptime_ticks();
+    aeagle_ts_t tout = aeagle_timer_now();
 
     free_cnt++;
-    P_TIME("cleanup", "free", BLOCK_SIZE, tin, tout, "OK");
+    aeagle_heapstat_free(BLOCK_SIZE);
+    AEAGLE_LOG_TIME("cleanup", "free", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
   }
   emit_snapshot("post_cleanup");
 
 done:
-  printk("# %s %s end\n", ALLOCATOR_NAME, TEST_NAME);
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
   return 0;
 }
\ No newline at end of file
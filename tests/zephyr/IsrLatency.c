@@ -0,0 +1,146 @@
+#include <inttypes.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/mem_stats.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/sys_heap.h>
+#include <stdio.h>
+
+#define ALLOCATOR_NAME "zephyr"
+#define TEST_NAME "IsrLatency"
+#define HEAP_SIZE 65536
+
+K_HEAP_DEFINE(my_heap, HEAP_SIZE);
+
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
+#include "aeagle_isr.h"
+
+static void emit_snapshot(const char *phase)
+{
+  aeagle_trace_drain();
+  if (AEAGLE_HEAPSTAT_CHECK)
+  {
+    struct sys_memory_stats st;
+    sys_heap_runtime_stats_get(&my_heap.heap, &st);
+    AEAGLE_LOG_HEAP(phase, st.free_bytes, st.allocated_bytes, st.max_allocated_bytes);
+  }
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+static struct k_timer isr_timer;
+
+/* Timer expiry, in the system clock's ISR. k_heap may be called from an
+ * ISR as long as it does not wait. */
+static void isr_tick(struct k_timer *timer)
+{
+  struct aeagle_isr_sample *s = aeagle_isr_enter(aeagle_timer_now());
+  void *p;
+
+  (void)timer;
+  if (s == NULL)
+  {
+    return;
+  }
+  if (aeagle_isr_block == NULL)
+  {
+    s->t_in = aeagle_timer_now();
+    p = k_heap_alloc(&my_heap, AEAGLE_ISR_SIZE, K_NO_WAIT);
+    s->t_out = aeagle_timer_now();
+    s->op = AEAGLE_ISR_MALLOC;
+    s->ok = p != NULL;
+    aeagle_isr_block = p;
+  }
+  else
+  {
+    s->t_in = aeagle_timer_now();
+    k_heap_free(&my_heap, aeagle_isr_block);
+    s->t_out = aeagle_timer_now();
+    s->op = AEAGLE_ISR_FREE;
+    s->ok = 1;
+    aeagle_isr_block = NULL;
+  }
+  aeagle_isr_leave();
+}
+
+/* The task's side of a phase, until the ISR has its samples; returns the
+ * heap calls made. */
+static uint32_t isr_background(unsigned phase)
+{
+  void *held[AEAGLE_ISR_HOLD] = {0};
+  uint32_t held_size[AEAGLE_ISR_HOLD];
+  aeagle_ts_t start = aeagle_timer_now();
+  uint32_t calls = 0, h;
+
+  while (aeagle_isr_pending(start))
+  {
+#ifdef CONFIG_ARCH_POSIX
+    /* native_sim only lets time pass, and the timer fire, while the CPU waits. */
+    k_busy_wait(1);
+#endif
+    if (phase == AEAGLE_ISR_IDLE)
+    {
+      continue;
+    }
+    h = calls % AEAGLE_ISR_HOLD;
+    if (held[h] == NULL)
+    {
+      held_size[h] = aeagle_isr_sizes[(calls / AEAGLE_ISR_HOLD) % 4];
+      held[h] = k_heap_alloc(&my_heap, held_size[h], K_NO_WAIT);
+      if (held[h] != NULL)
+      {
+        aeagle_heapstat_alloc(held_size[h]);
+      }
+    }
+    else
+    {
+      k_heap_free(&my_heap, held[h]);
+      aeagle_heapstat_free(held_size[h]);
+      held[h] = NULL;
+    }
+    calls++;
+  }
+  for (h = 0; h < AEAGLE_ISR_HOLD; h++)
+  {
+    if (held[h] != NULL)
+    {
+      k_heap_free(&my_heap, held[h]);
+      aeagle_heapstat_free(held_size[h]);
+    }
+  }
+  return calls;
+}
+
+int main(void)
+{
+  unsigned phase;
+  uint32_t calls = 0;
+
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  AEAGLE_LOG_META_VALUE("isr_period_us", AEAGLE_ISR_PERIOD_US);
+  aeagle_heapstat_init(HEAP_SIZE);
+
+  emit_snapshot("baseline");
+
+  k_timer_init(&isr_timer, isr_tick, NULL);
+  for (phase = 0; phase < AEAGLE_ISR_PHASES; phase++)
+  {
+    aeagle_isr_begin();
+    k_timer_start(&isr_timer, K_USEC(AEAGLE_ISR_PERIOD_US), K_USEC(AEAGLE_ISR_PERIOD_US));
+    calls += isr_background(phase);
+    k_timer_stop(&isr_timer);
+    if (aeagle_isr_block != NULL)
+    {
+      k_heap_free(&my_heap, aeagle_isr_block);
+      aeagle_isr_block = NULL;
+    }
+    emit_snapshot(aeagle_isr_snaps[phase]);
+    aeagle_isr_report(phase);
+  }
+  AEAGLE_LOG_META_VALUE("isr_churn_calls", calls);
+
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
+  return 0;
+}
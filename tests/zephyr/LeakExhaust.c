@@ -6,57 +6,62 @@
 
 #define ALLOCATOR_NAME "zephyr"
 #define TEST_NAME "LeakExhaust"
+#define HEAP_SIZE 65536
 #define BLOCK_SIZE 128
 
-K_HEAP_DEFINE(my_heap, 65536);
+K_HEAP_DEFINE(my_heap, HEAP_SIZE);
 
 static uint32_t alloc_cnt, free_cnt = 0;
 
-#define P_META() printk("META,tick_hz,%u\n", CONFIG_SYS_CLOCK_TICKS_PER_SEC)
-
-#define P_TIME(ph, op, sz, ti, to, res)                              \
-  printk("TIME,%s,%s,%u,%" PRIu64 ",%" PRIu64 ",%s,%u,%u\n", ph, op, \
-         (unsigned)(sz), (uint64_t)(ti), (uint64_t)(to), res, alloc_cnt, free_cnt)
-
-#define P_SNAP(ph, st)                                         \
-  printk("SNAP,%s,%zu,%zu,%zu\n", ph, (size_t)(st).free_bytes, \
-         (size_t)(st).allocated_bytes, (size_t)(st).max_allocated_bytes)
-
-#define P_FAULT(res) \
-  printk("FAULT,%" PRIu64 ",0xDEAD,%s\n", (uint64_t)k_uptime_ticks(), res)
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
 
 static void emit_snapshot(const char *phase)
 {
-  struct sys_memory_stats st;
-  sys_heap_runtime_stats_get(&my_heap.heap, &st);
-  P_SNAP(phase, st);
+  if (AEAGLE_HEAPSTAT_CHECK)
+  {
+    aeagle_trace_drain();
+    struct sys_memory_stats st;
+    sys_heap_runtime_stats_get(&my_heap.heap, &st);
+    AEAGLE_LOG_HEAP(phase, st.free_bytes, st.allocated_bytes, st.max_allocated_bytes);
+  }
+  AEAGLE_LOG_SNAP_DEFERRED(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
 }
 
 int main(void)
 {
   void *p;
 
-  printk("# %s %s start\n", ALLOCATOR_NAME, TEST_NAME);
-  P_META();
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  aeagle_heapstat_init(HEAP_SIZE);
 
   while (true)
   {
-    uint64_t tin = k_uptime_ticks();
+    aeagle_ts_t tin = aeagle_timer_now();
     p = k_heap_alloc(&my_heap, BLOCK_SIZE, K_NO_WAIT);
-    uint64_t tout = k_uptime_ticks();
+    aeagle_ts_t tout = aeagle_timer_now();
 
     if (!p)
     {
-      P_TIME("leakloop", "malloc", BLOCK_SIZE, tin, tout, "NULL");
-      P_FAULT("OOM");
+      AEAGLE_LOG_TIME_DEFERRED("leakloop", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
+      aeagle_trace_drain();
+      AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
       break;
     }
     alloc_cnt++;
-    P_TIME("leakloop", "malloc", BLOCK_SIZE, tin, tout, "OK");
+    aeagle_heapstat_alloc(BLOCK_SIZE);
+    if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+    {
+      AEAGLE_LOG_TIME_DEFERRED("leakloop", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+    }
   }
 
   emit_snapshot("after_leakloop_exhaustion");
 
-  printk("# %s %s end\n", ALLOCATOR_NAME, TEST_NAME);
+  aeagle_trace_finish();
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
   return 0;
 }
\ No newline at end of file
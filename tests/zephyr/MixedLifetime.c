@@ -7,34 +7,30 @@
 
 #define ALLOCATOR_NAME "zephyr"
 #define TEST_NAME "MixedLifetime"
+#define HEAP_SIZE 65536
 #define BLOCK_SIZE 128
 #define PIN_COUNT 5
 #define BURST_ROUNDS 10
 #define BURST_COUNT 10
 
-K_HEAP_DEFINE(my_heap, 65536);
+K_HEAP_DEFINE(my_heap, HEAP_SIZE);
 
 static uint32_t alloc_cnt, free_cnt;
 
-#define P_META() printk("META,tick_hz,%u\n", CONFIG_SYS_CLOCK_TICKS_PER_SEC)
-
-#define P_TIME(ph, op, sz, ti, to, res)                                  \
-  printk("TIME,%s,%s,%u,%" PRIu64 ",%" PRIu64 ",%s,%u,%u\n", ph, op,     \
-         (unsigned)(sz), (uint64_t)(ti), (uint64_t)(to), res, alloc_cnt, \
-         free_cnt)
-
-#define P_SNAP(ph, st)                                         \
-  printk("SNAP,%s,%zu,%zu,%zu\n", ph, (size_t)(st).free_bytes, \
-         (size_t)(st).allocated_bytes, (size_t)(st).max_allocated_bytes)
-
-#define P_FAULT(res) \
-  printk("FAULT,%" PRIu64 ",0xDEAD,%s\n", (uint64_t)k_uptime_ticks(), res)
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
 
 static void emit_snapshot(const char *phase)
 {
-  struct sys_memory_stats st;
-  sys_heap_runtime_stats_get(&my_heap.heap, &st);
-  P_SNAP(phase, st);
+  aeagle_trace_drain();
+  if (AEAGLE_HEAPSTAT_CHECK)
+  {
+    struct sys_memory_stats st;
+    sys_heap_runtime_stats_get(&my_heap.heap, &st);
+    AEAGLE_LOG_HEAP(phase, st.free_bytes, st.allocated_bytes, st.max_allocated_bytes);
+  }
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
 }
 
 int main(void)
@@ -43,18 +39,21 @@ int main(void)
   void *buf[BURST_COUNT];
   char snap_phase_label[64]; // Buffer for dynamic snapshot phase names
 
-  printk("# %s %s start\n", ALLOCATOR_NAME, TEST_NAME);
-  P_META();
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  aeagle_heapstat_init(HEAP_SIZE);
 
   for (int i = 0; i < PIN_COUNT; ++i)
   {
-    uint64_t tin = k_uptime_ticks();
+    aeagle_ts_t tin = aeagle_timer_now();
     pinned[i] = k_heap_alloc(&my_heap, BLOCK_SIZE * 2, K_NO_WAIT);
-    uint64_t tout = k_uptime_ticks();
+    aeagle_ts_t tout = aeagle_timer_now();
     if (!pinned[i])
     {
-      P_TIME("pin", "malloc", BLOCK_SIZE * 2, tin, tout, "NULL");
-      P_FAULT("OOM");
+      AEAGLE_LOG_TIME_DEFERRED("pin", "malloc", BLOCK_SIZE * 2, tin, tout, "NULL", alloc_cnt, free_cnt);
+      aeagle_trace_drain();
+      AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
       // Attempt to free any already pinned blocks if OOM occurs here
       for (int k = 0; k < i; ++k)
       {
@@ -68,7 +67,11 @@ int main(void)
       goto done;
     }
     alloc_cnt++;
-    P_TIME("pin", "malloc", BLOCK_SIZE * 2, tin, tout, "OK");
+    aeagle_heapstat_alloc(BLOCK_SIZE * 2);
+    if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+    {
+      AEAGLE_LOG_TIME_DEFERRED("pin", "malloc", BLOCK_SIZE * 2, tin, tout, "OK", alloc_cnt, free_cnt);
+    }
   }
   emit_snapshot("after_pins");
 
@@ -77,29 +80,38 @@ int main(void)
     int i;
     for (i = 0; i < BURST_COUNT; ++i)
     {
-      uint64_t tin = k_uptime_ticks();
+      aeagle_ts_t tin = aeagle_timer_now();
       buf[i] = k_heap_alloc(&my_heap, BLOCK_SIZE, K_NO_WAIT);
-      uint64_t tout = k_uptime_ticks();
+      aeagle_ts_t tout = aeagle_timer_now();
       if (!buf[i])
       {
-        P_TIME("burst", "malloc", BLOCK_SIZE, tin, tout, "NULL");
-        P_FAULT("OOM");
+        AEAGLE_LOG_TIME_DEFERRED("burst", "malloc", BLOCK_SIZE, tin, tout, "NULL", alloc_cnt, free_cnt);
+        aeagle_trace_drain();
+        AEAGLE_LOG_FAULT(aeagle_timer_now(), "OOM");
         // Note: Potential leak here of buf[0] to buf[i-1] from this round
         goto cleanup;
       }
       alloc_cnt++;
-      P_TIME("burst", "malloc", BLOCK_SIZE, tin, tout, "OK");
+      aeagle_heapstat_alloc(BLOCK_SIZE);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        AEAGLE_LOG_TIME_DEFERRED("burst", "malloc", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+      }
     }
     snprintf(snap_phase_label, sizeof(snap_phase_label), "after_burst_alloc_%d", round);
     emit_snapshot(snap_phase_label);
 
     for (int j = i - 1; j >= 0; --j)
     {
-      uint64_t tin = k_uptime_ticks();
+      aeagle_ts_t tin = aeagle_timer_now();
       k_heap_free(&my_heap, buf[j]);
-      uint64_t tout = k_uptime_ticks();
+      aeagle_ts_t tout = aeagle_timer_now();
       free_cnt++;
-      P_TIME("burst", "free", BLOCK_SIZE, tin, tout, "OK");
+      aeagle_heapstat_free(BLOCK_SIZE);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        AEAGLE_LOG_TIME_DEFERRED("burst", "free", BLOCK_SIZE, tin, tout, "OK", alloc_cnt, free_cnt);
+      }
     }
     snprintf(snap_phase_label, sizeof(snap_phase_label), "after_burst_free_%d", round);
     emit_snapshot(snap_phase_label);
@@ -110,16 +122,21 @@ cleanup:
   {
     if (pinned[i]) // Ensure pointer is valid before freeing
     {
-      uint64_t tin = k_uptime_ticks();
+      aeagle_ts_t tin = aeagle_timer_now();
       k_heap_free(&my_heap, pinned[i]);
-      uint64_t tout = k_uptime_ticks();
+      aeagle_ts_t tout = aeagle_timer_now();
       free_cnt++;
-      P_TIME("cleanup", "free", BLOCK_SIZE * 2, tin, tout, "OK");
+      aeagle_heapstat_free(BLOCK_SIZE * 2);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        AEAGLE_LOG_TIME_DEFERRED("cleanup", "free", BLOCK_SIZE * 2, tin, tout, "OK", alloc_cnt, free_cnt);
+      }
     }
   }
   emit_snapshot("post_cleanup");
 
 done:
-  printk("# %s %s end\n", ALLOCATOR_NAME, TEST_NAME);
+  aeagle_trace_finish();
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include <inttypes.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/mem_stats.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/sys_heap.h>
+#include <stdio.h>
+
+#define ALLOCATOR_NAME "zephyr"
+#define TEST_NAME "Replay"
+#define HEAP_SIZE 65536
+
+K_HEAP_DEFINE(my_heap, HEAP_SIZE);
+
+static uint32_t alloc_cnt, free_cnt;
+
+#include "aeagle_log.h"
+#include "aeagle_trace.h"
+#include "aeagle_heapstat.h"
+#include "aeagle_replay.h"
+
+static void emit_snapshot(const char *phase)
+{
+  aeagle_trace_drain();
+  if (AEAGLE_HEAPSTAT_CHECK)
+  {
+    struct sys_memory_stats st;
+    sys_heap_runtime_stats_get(&my_heap.heap, &st);
+    AEAGLE_LOG_HEAP(phase, st.free_bytes, st.allocated_bytes, st.max_allocated_bytes);
+  }
+  AEAGLE_LOG_SNAP(phase, aeagle_heapstat_free_bytes(), aeagle_heapstat.live_bytes, aeagle_heapstat.peak_bytes);
+}
+
+/* The live object of every trace slot, and the size it was asked for. */
+static void *objs[AEAGLE_REPLAY_MAX_OBJECTS];
+static uint32_t obj_size[AEAGLE_REPLAY_MAX_OBJECTS];
+
+int main(void)
+{
+  struct aeagle_replay r;
+  struct aeagle_replay_rec rec;
+  aeagle_ts_t tin, tout;
+  uint32_t skipped = 0, i;
+  int rc;
+  void *p;
+
+  AEAGLE_LOG_START(ALLOCATOR_NAME, TEST_NAME);
+  aeagle_timer_init();
+  AEAGLE_LOG_META();
+  aeagle_heapstat_init(HEAP_SIZE);
+
+  emit_snapshot("baseline");
+
+  if (aeagle_replay_open(&r, aeagle_replay_trace, sizeof(aeagle_replay_trace), NULL,
+                         AEAGLE_REPLAY_MAX_OBJECTS) != 0)
+  {
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "REPLAY_TRACE");
+    goto done;
+  }
+
+  while ((rc = aeagle_replay_next(&r, &rec)) > 0)
+  {
+    if (rec.op == AEAGLE_REPLAY_MALLOC)
+    {
+      if (objs[rec.id] != NULL)
+      {
+        skipped++;
+        continue;
+      }
+      tin = aeagle_timer_now();
+      p = k_heap_alloc(&my_heap, rec.size, K_NO_WAIT);
+      tout = aeagle_timer_now();
+      if (!p)
+      {
+        AEAGLE_LOG_TIME_DEFERRED("replay", "malloc", rec.size, tin, tout, "NULL", alloc_cnt, free_cnt);
+        continue;
+      }
+      objs[rec.id] = p;
+      obj_size[rec.id] = rec.size;
+      alloc_cnt++;
+      aeagle_heapstat_alloc(rec.size);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        AEAGLE_LOG_TIME_DEFERRED("replay", "malloc", rec.size, tin, tout, "OK", alloc_cnt, free_cnt);
+      }
+    }
+    else
+    {
+      /* The malloc of this slot failed here. */
+      if (objs[rec.id] == NULL)
+      {
+        skipped++;
+        continue;
+      }
+      tin = aeagle_timer_now();
+      k_heap_free(&my_heap, objs[rec.id]);
+      tout = aeagle_timer_now();
+      objs[rec.id] = NULL;
+      free_cnt++;
+      aeagle_heapstat_free(obj_size[rec.id]);
+      if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+      {
+        AEAGLE_LOG_TIME_DEFERRED("replay", "free", obj_size[rec.id], tin, tout, "OK", alloc_cnt, free_cnt);
+      }
+    }
+  }
+  if (rc < 0)
+  {
+    aeagle_trace_drain();
+    AEAGLE_LOG_FAULT(aeagle_timer_now(), "REPLAY_TRACE");
+  }
+  emit_snapshot("after_replay");
+
+  /* Whatever the trace leaves live. */
+  for (i = 0; i < r.objects; i++)
+  {
+    if (objs[i] == NULL)
+    {
+      continue;
+    }
+    tin = aeagle_timer_now();
+    k_heap_free(&my_heap, objs[i]);
+    tout = aeagle_timer_now();
+    objs[i] = NULL;
+    free_cnt++;
+    aeagle_heapstat_free(obj_size[i]);
+    if (AEAGLE_LOG_TIME_DUE(alloc_cnt + free_cnt))
+    {
+      AEAGLE_LOG_TIME_DEFERRED("cleanup", "free", obj_size[i], tin, tout, "OK", alloc_cnt, free_cnt);
+    }
+  }
+  emit_snapshot("post_cleanup");
+
+done:
+  AEAGLE_LOG_META_VALUE("replay_records", r.records);
+  AEAGLE_LOG_META_VALUE("replay_skipped", skipped);
+  aeagle_trace_finish();
+  AEAGLE_LOG_END(ALLOCATOR_NAME, TEST_NAME);
+  return 0;
+}